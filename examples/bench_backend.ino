@@ -0,0 +1,67 @@
+/**
+*  This is a example to use lib mkigor_BMxx80.h/mkigor_BMxx80.cpp
+*  benchmark of compensation backends cl_compInt32, cl_compInt64, cl_compFloat, cl_compDouble without sensor
+*  (calibration data from Bosch datasheet BME280), it prints ns/sample and max deviation from double formulas.
+*  Backend of sensor is selected at compile time, for ex. cl_BME280_T<cl_WireBus, cl_compFloat> lv_bme;
+ ***************************************************************************/
+#include <mkigor_BMxx80.h>
+
+#define cd_NSAMP  256
+
+const calibBME280_stru gv_cd = { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+                                 75, 362, 0, 313, 50, 30 };
+preBME280_stru gv_pc;
+int32_t  gv_adcT[cd_NSAMP], gv_adcP[cd_NSAMP], gv_adcH[cd_NSAMP];
+tph_stru gv_ref[cd_NSAMP];      /// results of cl_compDouble
+volatile float gv_sink;         /// results are written here, so compiler can not remove calculation
+
+/// print ns/sample and max deviation of T (C), P (Pa), H (%RH) from double formulas
+template <class T_comp>
+void gf_bench(const char *lp_name) {
+  tph_stru lv_tph;
+  float lv_dT = 0, lv_dP = 0, lv_dH = 0;
+  unsigned long lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    lv_tph = T_comp::compTPH(gv_cd, gv_pc, gv_adcT[i], gv_adcP[i], gv_adcH[i]);
+    gv_sink = lv_tph.temp1 + lv_tph.pres1 + lv_tph.humi1;
+  }
+  unsigned long lv_time = micros() - lv_start;
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    lv_tph = T_comp::compTPH(gv_cd, gv_pc, gv_adcT[i], gv_adcP[i], gv_adcH[i]);
+    float lv_d = fabs(lv_tph.temp1 - gv_ref[i].temp1);
+    if (lv_d > lv_dT) lv_dT = lv_d;
+    lv_d = fabs(lv_tph.pres1 - gv_ref[i].pres1);
+    if (lv_d > lv_dP) lv_dP = lv_d;
+    lv_d = fabs(lv_tph.humi1 - gv_ref[i].humi1);
+    if (lv_d > lv_dH) lv_dH = lv_d;
+  }
+  Serial.print(lp_name);
+  Serial.print(" ns/sample = ");
+  Serial.print(1000.0 * lv_time / cd_NSAMP);
+  Serial.print(", max dT C = ");
+  Serial.print(lv_dT, 4);
+  Serial.print(", dP Pa = ");
+  Serial.print(lv_dP, 3);
+  Serial.print(", dH %RH = ");
+  Serial.println(lv_dH, 4);
+}
+
+void setup() {
+  Serial.begin(115200);
+  gf_precalc(gv_pc, gv_cd);
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {   /// raw data -40..+85 C, 300..1100 hPa, 0..100 %
+    gv_adcT[i] = 430000 + 571 * (int32_t)i;
+    gv_adcP[i] = 250000 + 977 * (int32_t)((i * 37) % cd_NSAMP);
+    gv_adcH[i] = 15000 + 117 * (int32_t)((i * 73) % cd_NSAMP);
+    gv_ref[i] = cl_compDouble::compTPH(gv_cd, gv_pc, gv_adcT[i], gv_adcP[i], gv_adcH[i]);
+  }
+}
+
+void loop() {
+  gf_bench<cl_compInt32>("BME280 cl_compInt32 ");
+  gf_bench<cl_compInt64>("BME280 cl_compInt64 ");
+  gf_bench<cl_compFloat>("BME280 cl_compFloat ");
+  gf_bench<cl_compDouble>("BME280 cl_compDouble");
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,73 @@
+/**
+*  This is a example to use lib mkigor_BMxx80.h/mkigor_BMxx80.cpp
+*  benchmark of compensation formulas without sensor (calibration data from Bosch datasheet BME280),
+*  it prints samples/sec of single sample functions loop and of batch function gf_compBatch(),
+*  and CPU cycles per sample of float results gf_compTPH() against integer results gf_compTPH_fixed().
+ ***************************************************************************/
+#include <mkigor_BMxx80.h>
+
+#define cd_NSAMP  256
+
+const calibBME280_stru gv_cd = { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+                                 75, 362, 0, 313, 50, 30 };
+preBME280_stru gv_pc;           /// precompiled calibration data, as begin() of sensor does it
+int32_t  gv_adcT[cd_NSAMP], gv_adcP[cd_NSAMP], gv_adcH[cd_NSAMP];
+int32_t  gv_temp[cd_NSAMP];
+uint32_t gv_pres[cd_NSAMP], gv_humi[cd_NSAMP];
+volatile float    gv_sinkF;     /// results are written here, so compiler can not remove calculation
+volatile uint32_t gv_sinkI;
+
+/// CPU cycles per sample from time of cd_NSAMP samples, us
+float gf_cycles(unsigned long lp_us) {
+  return (float)lp_us * (F_CPU / 1000000UL) / cd_NSAMP;
+}
+
+void setup() {
+  Serial.begin(115200);
+  gf_precalc(gv_pc, gv_cd);
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {   /// raw data around 25 C, 1000 hPa, 50 %
+    gv_adcT[i] = 519888 + 16 * (int32_t)(i % 64);
+    gv_adcP[i] = 415148 - 8 * (int32_t)(i % 32);
+    gv_adcH[i] = 27000 + (int32_t)(i % 128);
+  }
+}
+
+void loop() {
+  unsigned long lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    int32_t t_fine;
+    gv_temp[i] = gf_compT(gv_pc, gv_adcT[i], t_fine);
+    gv_pres[i] = gf_compP(gv_pc, gv_adcP[i], t_fine);
+    gv_humi[i] = gf_compH(gv_pc, gv_adcH[i], t_fine);
+  }
+  unsigned long lv_scalar = micros() - lv_start;
+
+  lv_start = micros();
+  gf_compBatch(gv_cd, gv_adcT, gv_adcP, gv_adcH, cd_NSAMP, gv_temp, gv_pres, gv_humi);
+  unsigned long lv_batch = micros() - lv_start;
+
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    tph_stru lv_tph = gf_compTPH(gv_pc, gv_adcT[i], gv_adcP[i], gv_adcH[i]);
+    gv_sinkF = lv_tph.temp1 + lv_tph.pres1 + lv_tph.humi1;
+  }
+  unsigned long lv_float = micros() - lv_start;
+
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    tphFixed_stru lv_tph = gf_compTPH_fixed(gv_pc, gv_adcT[i], gv_adcP[i], gv_adcH[i]);
+    gv_sinkI = lv_tph.temp1 + lv_tph.pres1 + lv_tph.humi1;
+  }
+  unsigned long lv_fixed = micros() - lv_start;
+
+  Serial.print("BME280 T P H scalar loop, samples/sec = ");
+  Serial.println(1000000.0 * cd_NSAMP / lv_scalar);
+  Serial.print("BME280 T P H gf_compBatch, samples/sec = ");
+  Serial.println(1000000.0 * cd_NSAMP / lv_batch);
+  Serial.print("BME280 T P H float gf_compTPH(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_float));
+  Serial.print("BME280 T P H integer gf_compTPH_fixed(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_fixed));
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,77 @@
+/**
+*  This is a example to use lib mkigor_BMxx80_meteo.h/mkigor_BMxx80_meteo.cpp
+*  benchmark of derived quantities without sensor: CPU cycles per sample of altitude and dew point
+*  by fast approximations (gf_altitude(), gf_dewPoint()) against libm (powf(), logf()),
+*  and of cl_Meteo::calc() with cache for slowly changing samples.
+ ***************************************************************************/
+#include <mkigor_BMxx80_meteo.h>
+#include <math.h>
+
+#define cd_NSAMP  256
+
+tph_stru gv_tph[cd_NSAMP];
+cl_Meteo gv_met(101325.0f, 120.0f);   /// reference pressure at sea level, altitude of station 120 m
+volatile float gv_sinkF;              /// results are written here, so compiler can not remove calculation
+
+/// CPU cycles per sample from time of cd_NSAMP samples, us
+float gf_cycles(unsigned long lp_us) {
+  return (float)lp_us * (F_CPU / 1000000UL) / cd_NSAMP;
+}
+
+void setup() {
+  Serial.begin(115200);
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {   /// 21 C, 1000 hPa, 45 %RH, slow change and noise of filtered sensor
+    gv_tph[i].temp1 = 21.0f + 0.004f * (float)i + 0.003f * (float)(i % 3);
+    gv_tph[i].pres1 = 100000.0f + 0.05f * (float)i + 0.2f * (float)(i % 3);
+    gv_tph[i].humi1 = 45.0f + 0.01f * (float)(i % 3);
+  }
+}
+
+void loop() {
+  unsigned long lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) gv_sinkF = 44330.0f * (1.0f - powf(gv_tph[i].pres1 / 101325.0f, 0.190295f));
+  unsigned long lv_altLibm = micros() - lv_start;
+
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) gv_sinkF = gf_altitude(gv_tph[i].pres1);
+  unsigned long lv_altFast = micros() - lv_start;
+
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    float lv_g = logf(gv_tph[i].humi1 / 100.0f) + 17.62f * gv_tph[i].temp1 / (243.12f + gv_tph[i].temp1);
+    gv_sinkF = 243.12f * lv_g / (17.62f - lv_g);
+  }
+  unsigned long lv_dewLibm = micros() - lv_start;
+
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) gv_sinkF = gf_dewPoint(gv_tph[i].temp1, gv_tph[i].humi1);
+  unsigned long lv_dewFast = micros() - lv_start;
+
+  gv_met.clearStat();
+  lv_start = micros();
+  for (uint16_t i = 0; i < cd_NSAMP; i++) {
+    const meteo_stru &lv_res = gv_met.calc(gv_tph[i]);
+    gv_sinkF = lv_res.alt + lv_res.seaP + lv_res.dew + lv_res.absH;
+  }
+  unsigned long lv_meteo = micros() - lv_start;
+
+  Serial.print("altitude powf(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_altLibm));
+  Serial.print("altitude gf_altitude(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_altFast));
+  Serial.print("dew point logf(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_dewLibm));
+  Serial.print("dew point gf_dewPoint(), cycles/sample = ");
+  Serial.println(gf_cycles(lv_dewFast));
+  Serial.print("cl_Meteo calc() all 4 quantities, cycles/sample = ");
+  Serial.println(gf_cycles(lv_meteo));
+  Serial.print("cl_Meteo recalculated P T H of samples, % = ");
+  meteoStat_stru lv_st = gv_met.stat();
+  Serial.print(100.0f * lv_st.recalcP / lv_st.calls);
+  Serial.print(" ");
+  Serial.print(100.0f * lv_st.recalcT / lv_st.calls);
+  Serial.print(" ");
+  Serial.println(100.0f * lv_st.recalcH / lv_st.calls);
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,108 @@
+/**
+*  This is a example to use lib mkigor_BMxx80.h, fast resume after deep sleep, without sensors:
+*  wake to first sample of cold start (check(), begin(), start(), poll()) against resume(blob), poll()
+*  on simulated bus cl_SimBus. It prints i2c transactions, time of transfers on real i2c bus
+*  (100 kHz and 400 kHz) and wake to first sample latency = bus time + time of conversion.
+*  On ESP32 blob is kept in RTC memory:  RTC_DATA_ATTR uint8_t gv_blob[cd_BLOB_MAXLEN];
+ ***************************************************************************/
+#include <mkigor_BMxx80.h>
+
+cl_SimBus gv_bus;
+cl_BME280_T<cl_SimBus> gv_bme(gv_bus);
+cl_BME680_T<cl_SimBus> gv_bme6(gv_bus);
+uint8_t gv_blob280[cd_BLOB_MAXLEN], gv_blob680[cd_BLOB_MAXLEN];   ///  RTC memory or flash
+
+///  calibration data from Bosch datasheet BME280 (regs 0x88..0x9F), BME680 reads only pressure P1 non 0 from it
+void addSim(uint8_t lp_addr, uint8_t lp_codeChip) {
+  const int16_t lv_cd[12] = { 27504, 26435, -1000, (int16_t)36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+  uint8_t *lv_regs = gv_bus.addDevice(lp_addr, lp_codeChip);
+  for (uint8_t i = 0; i < 12; i++) {
+    lv_regs[0x88 + 2 * i] = (uint8_t)lv_cd[i];
+    lv_regs[0x89 + 2 * i] = (uint8_t)(lv_cd[i] >> 8);
+  }
+  const uint8_t lv_raw[8] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x69, 0x78 };   /// adc_P 415148, adc_T 519888
+  memcpy(lv_regs + 0xF7, lv_raw, 8);
+  memcpy(lv_regs + 0x1F, lv_raw, 8);
+  lv_regs[0x1D] = 0x80;   /// BME680 new data, not measuring
+}
+
+///  print cost of wake path: transactions, bus time at 100 / 400 kHz, latency = bus + conversion
+template <class T_sens>
+void printWake(const char *lp_name, T_sens &lp_sens, uint32_t lp_bus100) {
+  uint32_t lv_bus100 = lp_bus100;
+  uint32_t lv_bus400 = lp_bus100 / 4;
+  Serial.print(lp_name);
+  Serial.print(" transactions = ");  Serial.print(lp_sens.busStat().trans);
+  Serial.print(", bytes = ");        Serial.print(lp_sens.busStat().bytes);
+  Serial.print(", bus us 100 kHz = ");  Serial.print(lv_bus100);
+  Serial.print(", 400 kHz = ");      Serial.print(lv_bus400);
+  Serial.print(", first sample us (400 kHz) = ");
+  Serial.println(lv_bus400 + lp_sens.measTime());
+}
+
+///  settings of sensors, weather monitoring (datasheet): x1 oversampling, filter off
+void initSens(cl_BME280_T<cl_SimBus> &lp_sens) {
+  lp_sens.begin(cd_FOR_MODE, cd_SB_1000MS, cd_FIL_OFF, cd_OS_x1, cd_OS_x1, cd_OS_x1);
+}
+void initSens(cl_BME680_T<cl_SimBus> &lp_sens) {
+  lp_sens.begin(cd_FIL_OFF, cd_OS_x1, cd_OS_x1, cd_OS_x1);
+  lp_sens.initGasPointX(0, 320, 100, 20);
+}
+
+///  cold start after wake: check(), begin(), start() and poll() at deadline, return T
+template <class T_sens>
+float wakeCold(T_sens &lp_sens, uint8_t lp_addr) {
+  lp_sens.clearBusStat();
+  gv_bus.clearBusTime();
+  lp_sens.check(lp_addr);
+  initSens(lp_sens);
+  lp_sens.poll(lp_sens.start(0));
+  return lp_sens.result().temp1;
+}
+
+///  fast resume after wake: resume(blob) and poll() at deadline, return T
+template <class T_sens>
+float wakeResume(T_sens &lp_sens, const uint8_t *lp_blob) {
+  lp_sens.clearBusStat();
+  gv_bus.clearBusTime();
+  if (!lp_sens.resume(lp_blob, 0)) return -999;   ///  wrong blob or other chip => check(), begin()
+  lp_sens.poll(lp_sens.deadline());
+  return lp_sens.result().temp1;
+}
+
+void setup() {
+  Serial.begin(115200);
+  addSim(0x76, cd_BME280);
+  addSim(0x77, cd_BME680);
+  gv_bus.setClock(100000);
+  gv_bme.check(0x76);  initSens(gv_bme);
+  gv_bme6.check(0x77);  initSens(gv_bme6);
+  Serial.print("Size of blob BME280 = ");
+  Serial.print(gv_bme.saveState(gv_blob280));
+  Serial.print(", BME680 = ");
+  Serial.println(gv_bme6.saveState(gv_blob680));
+}
+
+void loop() {
+  float lv_t;
+  lv_t = wakeCold(gv_bme, 0x76);
+  printWake("BME280 check(), begin(), start() =>", gv_bme, gv_bus.busTime());
+  Serial.print("  T = ");  Serial.println(lv_t);
+  lv_t = wakeResume(gv_bme, gv_blob280);
+  printWake("BME280 resume(blob)              =>", gv_bme, gv_bus.busTime());
+  Serial.print("  T = ");  Serial.println(lv_t);
+
+  lv_t = wakeCold(gv_bme6, 0x77);
+  printWake("BME680 check(), begin(), start() =>", gv_bme6, gv_bus.busTime());
+  Serial.print("  T = ");  Serial.println(lv_t);
+  lv_t = wakeResume(gv_bme6, gv_blob680);
+  printWake("BME680 resume(blob)              =>", gv_bme6, gv_bus.busTime());
+  Serial.print("  T = ");  Serial.println(lv_t);
+
+  gv_blob280[cd_BLOB_HDRLEN] ^= 0x01;   ///  damaged blob is found by CRC
+  Serial.print("Damaged blob, resume() = ");
+  Serial.println(gv_bme.resume(gv_blob280, 0));
+  gv_blob280[cd_BLOB_HDRLEN] ^= 0x01;
+  Serial.println();
+  delay(3000);
+}
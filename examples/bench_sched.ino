@@ -0,0 +1,102 @@
+/**
+*  This is a example to use lib mkigor_BMxx80_sched.h
+*  benchmark of scheduler cl_MeasSched against sequential measuring, without sensors:
+*  8 simulated sensors BMP280, BME280, BME680 (different oversampling) on 4 simulated buses cl_SimBus.
+*  Time of conversions is virtual (measTime() of sensors), so it prints cycle time and samples/sec
+*  as with real sensors, and CPU time of scheduler per cycle.
+ ***************************************************************************/
+#include <mkigor_BMxx80_sched.h>
+
+#define cd_NCYCLE  100
+
+cl_SimBus gv_bus[4];
+cl_BME280_T<cl_SimBus> gv_bme0(gv_bus[0]), gv_bme1(gv_bus[0]);
+cl_BMP280_T<cl_SimBus> gv_bmp0(gv_bus[1]), gv_bmp1(gv_bus[1]);
+cl_BME680_T<cl_SimBus> gv_bme6(gv_bus[2]);
+cl_BME280_T<cl_SimBus> gv_bme2(gv_bus[2]);
+cl_BMP280_T<cl_SimBus> gv_bmp2(gv_bus[3]);
+cl_BME280_T<cl_SimBus> gv_bme3(gv_bus[3]);
+cl_MeasSched gv_sched;
+
+///  calibration data from Bosch datasheet BME280 (regs 0x88..0x9F), BME680 reads only pressure P1 non 0 from it
+void addSim(cl_SimBus &lp_bus, uint8_t lp_addr, uint8_t lp_codeChip) {
+  const int16_t lv_cd[12] = { 27504, 26435, -1000, (int16_t)36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+  uint8_t *lv_regs = lp_bus.addDevice(lp_addr, lp_codeChip);
+  for (uint8_t i = 0; i < 12; i++) {
+    lv_regs[0x88 + 2 * i] = (uint8_t)lv_cd[i];
+    lv_regs[0x89 + 2 * i] = (uint8_t)(lv_cd[i] >> 8);
+  }
+  const uint8_t lv_raw[8] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x69, 0x78 };   /// adc_P 415148, adc_T 519888
+  memcpy(lv_regs + 0xF7, lv_raw, 8);
+  memcpy(lv_regs + 0x1F, lv_raw, 8);
+  lv_regs[0x1D] = 0x80;   /// BME680 new data, not measuring
+}
+
+void setup() {
+  Serial.begin(115200);
+  for (uint8_t i = 0; i < 4; i++) {
+    addSim(gv_bus[i], 0x76, i == 1 || i == 3 ? cd_BMP280 : cd_BME280);
+    addSim(gv_bus[i], 0x77, i == 1 ? cd_BMP280 : (i == 2 ? cd_BME680 : cd_BME280));
+  }
+  gv_bme0.check(0x76);  gv_bme0.begin();
+  gv_bme1.check(0x77);  gv_bme1.begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x4, cd_OS_x1, cd_OS_x4, cd_OS_x1);
+  gv_bmp0.check(0x76);  gv_bmp0.begin();
+  gv_bmp1.check(0x77);  gv_bmp1.begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_OFF, cd_OS_x1, cd_OS_x1);
+  gv_bme6.check(0x77);  gv_bme6.begin();  gv_bme6.initGasPointX(0, 320, 150, 20);
+  gv_bme2.check(0x76);  gv_bme2.begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x16, cd_OS_x2, cd_OS_x16, cd_OS_x1);
+  gv_bmp2.check(0x76);  gv_bmp2.begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x2, cd_OS_x2, cd_OS_x8);
+  gv_bme3.check(0x77);  gv_bme3.begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_OFF, cd_OS_x1, cd_OS_x1, cd_OS_OFF);
+  gv_sched.add(gv_bme0);  gv_sched.add(gv_bme1);  gv_sched.add(gv_bmp0);  gv_sched.add(gv_bmp1);
+  gv_sched.add(gv_bme6);  gv_sched.add(gv_bme2);  gv_sched.add(gv_bmp2);  gv_sched.add(gv_bme3);
+}
+
+///  sequential measuring of one sensor: start, wait until ready time, read
+template <class T_sens>
+uint32_t measSeq(T_sens &lp_sens, uint32_t lp_now) {
+  uint32_t lv_deadline = lp_sens.start(lp_now);
+  lp_sens.poll(lv_deadline);
+  lp_sens.result();
+  return lv_deadline;
+}
+
+void loop() {
+  uint32_t lv_now = 0;   ///  virtual time, us
+  for (uint16_t k = 0; k < cd_NCYCLE; k++) {
+    lv_now = measSeq(gv_bme0, lv_now);  lv_now = measSeq(gv_bme1, lv_now);
+    lv_now = measSeq(gv_bmp0, lv_now);  lv_now = measSeq(gv_bmp1, lv_now);
+    lv_now = measSeq(gv_bme6, lv_now);  lv_now = measSeq(gv_bme2, lv_now);
+    lv_now = measSeq(gv_bmp2, lv_now);  lv_now = measSeq(gv_bme3, lv_now);
+  }
+  uint32_t lv_seq = lv_now / cd_NCYCLE;
+
+  lv_now = 0;
+  gv_sched.clearStat(lv_now);
+  unsigned long lv_start = micros();
+  for (uint16_t k = 0; k < cd_NCYCLE; k++) {
+    gv_sched.startAll(lv_now);
+    while (gv_sched.busy()) {
+      lv_now = gv_sched.nextDeadline();   ///  here MCU can sleep until next ready time
+      while (gv_sched.poll(lv_now) != cd_SCHED_NONE) {}
+    }
+  }
+  unsigned long lv_cpu = micros() - lv_start;
+
+  Serial.print("Sequential cycle of 8 sensors, us = ");
+  Serial.println(lv_seq);
+  Serial.print("Scheduled cycle of 8 sensors, us = ");
+  Serial.println(lv_now / cd_NCYCLE);
+  for (uint8_t i = 0; i < gv_sched.size(); i++) {
+    Serial.print("sensor ");
+    Serial.print(i);
+    Serial.print(" samples/sec = ");
+    Serial.print(gv_sched.rate(i) / 1000.0);
+    Serial.print(", T = ");
+    Serial.println(gv_sched.result(i).temp1);
+  }
+  Serial.print("All sensors samples/sec = ");
+  Serial.println(gv_sched.rateAll() / 1000.0);
+  Serial.print("CPU time of scheduler + simulated bus per cycle, us = ");
+  Serial.println((float)lv_cpu / cd_NCYCLE);
+  Serial.println();
+  delay(3000);
+}
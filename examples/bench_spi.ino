@@ -0,0 +1,87 @@
+/**
+*  This is a example to use SPI transport cl_SpiBus_T of lib mkigor_BMxx80.h, without sensors:
+*  the same BMP280 on simulated i2c (cl_SimBus, 400 kHz) and simulated SPI (cl_SimSpi, 10 MHz),
+*  read of sample as in normal mode stream (status + data, 10 regs from 0xF3).
+*  It prints time of transfers on real bus per sample, data bytes/sec and max samples/sec of bus,
+*  and checks that results by both buses are the same (SPI address mapping, BME680 pages).
+*  With real sensor: cl_SpiBus gv_spi; cl_BMP280_T<cl_SpiBus> bmp(gv_spi); bmp.check(csPin);
+ ***************************************************************************/
+#include <mkigor_BMxx80.h>
+
+#define cd_NSAMPLE  1000
+#define cd_CS_PIN   5
+
+cl_SimBus gv_i2c;
+cl_SimSpi gv_spiHw;
+cl_SimSpiBus gv_spi(gv_spiHw);
+cl_BMP280_T<cl_SimBus> gv_bmpI2c(gv_i2c);
+cl_BMP280_T<cl_SimSpiBus> gv_bmpSpi(gv_spi);
+cl_BME680_T<cl_SimBus> gv_bme6I2c(gv_i2c);
+cl_BME680_T<cl_SimSpiBus> gv_bme6Spi(gv_spi);
+
+///  calibration data from Bosch datasheet BMP280 (regs 0x88..0x9F), BME680 reads only pressure P1 non 0 from it
+void fillSim(uint8_t *lp_regs) {
+  const int16_t lv_cd[12] = { 27504, 26435, -1000, (int16_t)36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+  for (uint8_t i = 0; i < 12; i++) {
+    lp_regs[0x88 + 2 * i] = (uint8_t)lv_cd[i];
+    lp_regs[0x89 + 2 * i] = (uint8_t)(lv_cd[i] >> 8);
+  }
+  const uint8_t lv_raw[8] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x69, 0x78 };   /// adc_P 415148, adc_T 519888
+  memcpy(lp_regs + 0xF7, lv_raw, 8);
+  memcpy(lp_regs + 0x1F, lv_raw, 8);
+  lp_regs[0x1D] = 0x80;   /// BME680 new data, not measuring
+}
+
+///  read cd_NSAMPLE samples (10 regs from 0xF3), return time of transfers on real bus, us
+template <class T_sens, class T_sim>
+uint32_t readSamples(T_sens &lp_sens, T_sim &lp_sim) {
+  uint8_t lv_regs[10];
+  lp_sim.clearBusTime();
+  for (uint16_t k = 0; k < cd_NSAMPLE; k++) lp_sens.readRegs(0xF3, lv_regs, 10);
+  return lp_sim.busTime();
+}
+
+void printBus(const char *lp_name, uint32_t lp_time) {
+  Serial.print(lp_name);
+  Serial.print(" us/sample = ");
+  Serial.print((float)lp_time / cd_NSAMPLE);
+  Serial.print(", data bytes/sec = ");
+  Serial.print((uint32_t)(10ULL * cd_NSAMPLE * 1000000 / lp_time));
+  Serial.print(", max samples/sec of bus = ");
+  Serial.println((uint32_t)((uint64_t)cd_NSAMPLE * 1000000 / lp_time));
+}
+
+void setup() {
+  Serial.begin(115200);
+  fillSim(gv_i2c.addDevice(0x76, cd_BMP280));
+  fillSim(gv_spiHw.addDevice(cd_CS_PIN, cd_BMP280));
+  fillSim(gv_i2c.addDevice(0x77, cd_BME680));
+  fillSim(gv_spiHw.addDevice(cd_CS_PIN + 1, cd_BME680));
+  gv_i2c.setClock(400000);
+  gv_spi.setClock(10000000);
+  gv_bmpI2c.check(0x76);           gv_bmpI2c.begin();
+  gv_bmpSpi.check(cd_CS_PIN);      gv_bmpSpi.begin();
+  gv_bme6I2c.check(0x77);          gv_bme6I2c.begin();  gv_bme6I2c.initGasPointX(0, 320, 100, 20);
+  gv_bme6Spi.check(cd_CS_PIN + 1); gv_bme6Spi.begin();  gv_bme6Spi.initGasPointX(0, 320, 100, 20);
+}
+
+void loop() {
+  printBus("BMP280 i2c 400 kHz =>", readSamples(gv_bmpI2c, gv_i2c));
+  printBus("BMP280 SPI 10 MHz  =>", readSamples(gv_bmpSpi, gv_spiHw));
+
+  Serial.print("BMP280 T, P by i2c = ");
+  Serial.print(gv_bmpI2c.readTP().temp1);  Serial.print(", ");  Serial.print(gv_bmpI2c.readTP().pres1);
+  Serial.print(", by SPI = ");
+  Serial.print(gv_bmpSpi.readTP().temp1);  Serial.print(", ");  Serial.println(gv_bmpSpi.readTP().pres1);
+  ///  BME680: regs 0x1D..0x2B and 0x5A..0x75 are in page 1, calibration in page 0 and 1
+  gv_bme6I2c.poll(gv_bme6I2c.start(0));
+  gv_bme6Spi.poll(gv_bme6Spi.start(0));
+  Serial.print("BME680 T, P by i2c = ");
+  Serial.print(gv_bme6I2c.result().temp1);  Serial.print(", ");  Serial.print(gv_bme6I2c.result().pres1);
+  Serial.print(", by SPI = ");
+  Serial.print(gv_bme6Spi.result().temp1);  Serial.print(", ");  Serial.print(gv_bme6Spi.result().pres1);
+  Serial.print(", page = ");
+  Serial.println(gv_spiHw.page(cd_CS_PIN + 1));
+  Serial.println();
+  delay(3000);
+}
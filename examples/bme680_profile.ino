@@ -0,0 +1,47 @@
+/**
+*  This is a example to use lib mkigor_BMxx80.h/mkigor_BMxx80.cpp
+*  for the BME680 sensor BOSCH, heater profile of 10 steps (VOC fingerprint):
+*  all set points are written by setHeatProfile() in 2 i2c transmissions, then each start() measures next step
+*  (nb_conv) and poll() stores gas resistance of step. After the last step gasVector() has resistance of all steps.
+ ***************************************************************************/
+#include <mkigor_BMxx80.h>
+
+cl_BME680 bme;  ///  create class
+///  10 steps: temperature C, duration ms
+const heatProfile_stru gv_prof = { 10, { 200, 240, 280, 320, 360, 400, 360, 320, 280, 240 },
+                                       { 60, 60, 60, 60, 60, 60, 60, 60, 60, 60 } };
+unsigned long gv_profStart;
+
+void setup() {
+  Serial.begin(115200);
+
+  uint8_t k = bme.check(0x77);
+  if (k == 0) k = bme.check(0x76);
+  Serial.print("Check a bme680 => ");
+  if (k == 0) Serial.print("not found, check cables.\n");
+  else {
+    Serial.print(k, HEX);  Serial.println(" found chip code.");
+  }
+  bme.begin(cd_FIL_OFF, cd_OS_x1, cd_OS_x1, cd_OS_x1);
+  bme.clearBusStat();
+  if (!bme.setHeatProfile(gv_prof, 20)) Serial.println("Heater profile is not written!");
+  Serial.print("Heater profile is written by i2c transmissions = ");
+  Serial.println(bme.busStat().trans);
+  gv_profStart = millis();
+}
+
+void loop() {
+  if (bme.state() != cd_ST_WAIT) bme.start(micros());
+  if (bme.poll(micros()) && bme.profileDone()) {
+    Serial.print("Profile time, ms = ");
+    Serial.print(millis() - gv_profStart);
+    Serial.print(", gas resistance of steps, Ohm =");
+    for (uint8_t i = 0; i < gv_prof.nStep; i++) {
+      Serial.print(' ');
+      Serial.print(bme.gasVector()[i]);
+    }
+    Serial.println();
+    delay(3000);
+    gv_profStart = millis();
+  }
+}
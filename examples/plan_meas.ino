@@ -0,0 +1,49 @@
+/**
+*  This is a example to use lib mkigor_BMxx80_plan.h
+*  planner of measuring time and settings without sensor: it prints max / typ time of forced measuring,
+*  output data rate of normal mode for each standby time, and settings suggested by gf_plan().
+*  The same functions are constexpr, so plan can be constant computed at compile time.
+ ***************************************************************************/
+#include <mkigor_BMxx80_plan.h>
+
+///  BME280 1 sample/s, latency 30 s, pressure noise 0.5 Pa, computed by compiler
+constexpr plan_stru gv_plan = gf_plan(cd_BME280, 1000000, 30000000, 50);
+static_assert(gv_plan.osrs_p != cd_OS_OFF, "BME280 can not measure 1 sample/s");
+
+void printPlan(const char *lp_name, plan_stru lp_plan) {
+  Serial.print(lp_name);
+  Serial.print(" osrs_t = ");    Serial.print(lp_plan.osrs_t);
+  Serial.print(", osrs_p = ");   Serial.print(lp_plan.osrs_p);
+  Serial.print(", osrs_h = ");   Serial.print(lp_plan.osrs_h);
+  Serial.print(", filter = ");   Serial.print(lp_plan.filter);
+  Serial.print(", t_sb = ");     Serial.print(lp_plan.t_sb);
+  Serial.print(", max time us = ");  Serial.print(lp_plan.measTime);
+  Serial.print(", noise P 0.01 Pa = ");  Serial.println(lp_plan.noiseP);
+}
+
+void setup() {
+  Serial.begin(115200);
+}
+
+void loop() {
+  Serial.print("BME280 x16 forced measuring, typ us = ");
+  Serial.print(gf_measTimeTyp(cd_BME280, cd_OS_x16, cd_OS_x16, cd_OS_x16));
+  Serial.print(", max us = ");
+  Serial.println(gf_measTimeMax(cd_BME280, cd_OS_x16, cd_OS_x16, cd_OS_x16));
+  Serial.print("BME680 x16 forced measuring with heating 100 ms, us = ");
+  Serial.println(gf_measTimeMax(cd_BME680, cd_OS_x16, cd_OS_x16, cd_OS_x16, 100));
+
+  for (uint8_t lv_sb = cd_SB_500US; lv_sb <= cd_SB_20MS; lv_sb++) {
+    Serial.print("BME280 normal mode T x1 P x16 H x1, t_sb = ");
+    Serial.print(lv_sb);
+    Serial.print(", ODR 0.001 Hz = ");
+    Serial.println(gf_normOdr(cd_BME280, lv_sb, cd_OS_x1, cd_OS_x16, cd_OS_x1));
+  }
+
+  printPlan("BME280 1 Hz, 30 s, 0.5 Pa   =>", gv_plan);
+  uint32_t lv_period = 50000;   ///  runtime values, for ex. from settings
+  printPlan("BME280 20 Hz, 1 s, 0.2 Pa   =>", gf_plan(cd_BME280, lv_period, 1000000, 20));
+  printPlan("BME680 0.1 Hz, 60 s, 0.3 Pa =>", gf_plan(cd_BME680, 10000000, 60000000, 30, 100));
+  Serial.println();
+  delay(3000);
+}
@@ -0,0 +1,62 @@
+/**
+*  This is a example to use lib mkigor_BMxx80_scan.h
+*  discovery of sensors BMP280, BME280, BME680 (addresses 0x76, 0x77) on i2c bus Wire by one scan(),
+*  objects of classes of found chips are in cl_SensorSet_T, they are added to scheduler cl_MeasSched.
+*  It prints found sensors, time of enumeration and measured values.
+*  For second bus (ESP32):  cl_WireBus gv_bus1(Wire1);  cl_WireBus *gv_buses[2] = { &cl_WireBus::dflt(), &gv_bus1 };
+ ***************************************************************************/
+#include <mkigor_BMxx80_scan.h>
+#include <mkigor_BMxx80_sched.h>
+
+cl_WireBus *gv_buses[1] = { &cl_WireBus::dflt() };
+cl_SensorSet_T<cl_WireBus> gv_set;
+cl_MeasSched gv_sched;
+
+///  functor of applyAll(): sensor of any class to scheduler
+struct addSched {
+  template <class T_sens> void operator()(T_sens &lp_sens) { gv_sched.add(lp_sens); }
+};
+
+void setup() {
+  Serial.begin(115200);
+  gv_set.scan(gv_buses, 1);       ///  without soft reset, scan(gv_buses, 1, true) - with it
+  Serial.print("Found sensors = ");
+  Serial.print(gv_set.size());
+  Serial.print(", scan time us = ");
+  Serial.println(gv_set.scanTime());
+  for (uint8_t i = 0; i < gv_set.size(); i++) {
+    Serial.print("sensor ");
+    Serial.print(i);
+    Serial.print(": chip 0x");
+    Serial.print(gv_set.codeChip(i), HEX);
+    Serial.print(", bus ");
+    Serial.print(gv_set.busIndex(i));
+    Serial.print(", address 0x");
+    Serial.println(gv_set.addr(i), HEX);
+  }
+  gv_set.beginAll();
+  uint8_t lv_i = gv_set.find(cd_BME680);
+  if (lv_i != cd_SCAN_NONE) gv_set.bme680(lv_i)->initGasPointX(0, 320, 150, 20);
+  addSched lv_add;
+  gv_set.applyAll(lv_add);
+}
+
+void loop() {
+  gv_sched.startAll(micros());
+  while (gv_sched.busy()) {
+    uint8_t i = gv_sched.poll(micros());
+    if (i == cd_SCHED_NONE) continue;
+    tphg_stru lv_r = gv_sched.result(i);
+    Serial.print("sensor ");
+    Serial.print(i);
+    Serial.print(": T = ");
+    Serial.print(lv_r.temp1);
+    Serial.print(", P = ");
+    Serial.print(lv_r.pres1);
+    Serial.print(", H = ");
+    Serial.print(lv_r.humi1);
+    Serial.print(", G = ");
+    Serial.println(lv_r.gasr1);
+  }
+  delay(5000);
+}
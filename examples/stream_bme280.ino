@@ -0,0 +1,43 @@
+/**
+*  This is a example to use lib mkigor_BMxx80_stream.h
+*  BME280 in normal mode (continuous measuring), samples are read once per period of sensor
+*  and pushed with time stamp to lock-free ring buffer, loop() takes them in batches.
+*  On ESP32 producer (stream.poll()) can work in high priority task, consumer in low priority task.
+ ***************************************************************************/
+#include <mkigor_BMxx80_stream.h>
+#include <mkigor_BMxx80_plan.h>
+
+cl_BME280 bme;
+cl_SensStream<cl_BME280> gv_stream(bme);
+cl_SpscRing<streamTPH_stru, 16> gv_ring;
+streamTPH_stru gv_batch[8];
+
+void setup() {
+  Serial.begin(115200);
+  if (bme.check(0x76) == 0) Serial.println("BME280 not found, check cables.");
+  bme.begin(cd_NOR_MODE, cd_SB_6250US, cd_FIL_x4, cd_OS_x1, cd_OS_x4, cd_OS_x1);
+  gv_stream.begin(gf_normPeriod(cd_BME280, cd_SB_6250US, cd_OS_x1, cd_OS_x4, cd_OS_x1), micros());
+}
+
+void loop() {
+  gv_stream.poll(micros(), gv_ring);    ///  producer
+
+  if (gv_ring.count() >= 8) {           ///  consumer
+    ringIdx_t lv_n = gv_ring.popBatch(gv_batch, 8);
+    for (ringIdx_t i = 0; i < lv_n; i++) {
+      Serial.print(gv_batch[i].time);
+      Serial.print(" us, T = ");
+      Serial.print(gv_batch[i].tph.temp1);
+      Serial.print(", P = ");
+      Serial.print(gv_batch[i].tph.pres1);
+      Serial.print(", H = ");
+      Serial.println(gv_batch[i].tph.humi1);
+    }
+    Serial.print("period of sensor, us = ");
+    Serial.print(gv_stream.period());
+    Serial.print(", missed = ");
+    Serial.print(gv_stream.missed());
+    Serial.print(", overrun = ");
+    Serial.println(gv_ring.overrun());
+  }
+}
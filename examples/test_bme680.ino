@@ -1,56 +1,63 @@
 /**
-*  This is a example to use lib BMxx80.h/BMxx80.cpp
+*  This is a example to use lib mkigor_BMxx80.h/mkigor_BMxx80.cpp
 *  for the BME680 sensor BOSCH (temperature, pressure, humidity, gas)
-*  These lib use only I2C interface. 
+*  These lib use only I2C interface.
+*  Measuring is asynchronous: start() returns ready time, poll() reads data once at this time,
+*  so loop() is free while sensor is measuring (no isMeas() polling and delay()).
  ***************************************************************************/
-#include <BMxx80.h>
+#include <mkigor_BMxx80.h>
 
 cl_BME680 bme;  ///  create class
+tphg_stru gv_stru_tphg = { 20, 0, 0, 0, 0 };
+unsigned long gv_measStart, gv_nextMeas = 0;
 
 void setup() {
   Serial.begin(115200);
 
-  uint8_t k = bme.check();
-  k = bme.check(0x76);
-  Serial.print("Check a bme280 => ");    /// check bme280 and SW reset
-    if (k == 0) Serial.print("not found, check cables.\n");
+  uint8_t k = bme.check(0x77);
+  if (k == 0) k = bme.check(0x76);
+  Serial.print("Check a bme680 => ");    /// check bme680 and SW reset
+  if (k == 0) Serial.print("not found, check cables.\n");
   else {
     Serial.print(k, HEX);  Serial.println(" found chip code.");
   }
   bme.begin();
 ///  bme.begin(cd_FIL_OFF, cd_OS_x16, cd_OS_x16, cd_OS_x16);
-  bme6.initGasPointX(0, 350, 100, 20);
+  bme.initGasPointX(0, 350, 100, 20);
+  Serial.print("BME680 max measuring TPHG time, us = ");
+  Serial.println(bme.measTime());
 }
 
 void loop() {
-  bme.initGasPointX(0, 350, 100, (int16_t)gv_stru_tph.temp1);
-  bme.do1Meas();
-  unsigned long lv_measStart = millis();
-  for (uint8_t i = 0; i < 3000; i++) {
-    if (bme6.isMeas()) delay(1);
-    else break;
+  if (bme.state() != cd_ST_WAIT && (long)(millis() - gv_nextMeas) >= 0) {
+    bme.initGasPointX(0, 350, 100, (int16_t)gv_stru_tphg.temp1);
+    gv_measStart = micros();
+    bme.start(gv_measStart);
+    gv_nextMeas = millis() + 3000;
   }
-  Serial.print("BME680 measuring TPHG time = ");
-  Serial.println( millis()-lv_measStart );
-  tphg_stru gv_stru_tphg = bme6.readTPHG();
-  
-  Serial.print("Temperature = ");
-  Serial.print(gv_stru_tphg.temp1);
-  Serial.println(" *C");
-
-  Serial.print("Pressure = ");
-  Serial.print(gv_stru_tphg.pres1);
-  Serial.println(" hPa");
-
-  Serial.print("Humidity = ");
-  Serial.print(gv_stru_tphg.humi1);
-  Serial.println(" %");
-
-  Serial.print("Gas = ");
-  Serial.print(gv_stru_tphg.gasr1);
-  Serial.println(" KOhms");
-
-  Serial.println();
-  delay(3000);
-}
 
+  if (bme.state() == cd_ST_WAIT && bme.poll(micros())) {
+    Serial.print("BME680 measuring TPHG time, us = ");
+    Serial.println(micros() - gv_measStart);
+    gv_stru_tphg = bme.result();
+
+    Serial.print("Temperature = ");
+    Serial.print(gv_stru_tphg.temp1);
+    Serial.println(" *C");
+
+    Serial.print("Pressure = ");
+    Serial.print(gv_stru_tphg.pres1);
+    Serial.println(" Pa");
+
+    Serial.print("Humidity = ");
+    Serial.print(gv_stru_tphg.humi1);
+    Serial.println(" %");
+
+    Serial.print("Gas = ");
+    Serial.print(gv_stru_tphg.gasr1);
+    Serial.println(" KOhms");
+
+    Serial.println();
+  }
+  /// here loop() can do other work, sensor is not polled while it is measuring
+}
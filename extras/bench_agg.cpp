@@ -0,0 +1,130 @@
+/**
+*	@brief		Host (Linux) test of mkigor_BMxx80_agg.h: running and window statistics of cl_AggChan against
+*				brute force in double over kept history, ns per sample of add() and ns per report (run(), window()).
+*	@remarks	g++ -std=c++11 -O2 -I.. bench_agg.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o bench_agg
+*				exit code 1 if any statistic differs from brute force more than tolerance
+*/
+
+#include <mkigor_BMxx80_agg.h>
+#include "test_util.h"
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#define cd_NSAMP	2000000UL	///	samples of timed loops
+#define cd_BLKLEN	60
+#define cd_NBLK		5
+
+volatile float gv_sink;			///	results of timed loops, so compiler keeps them
+uint8_t gv_fail = 0;
+
+/*	statistics of samples lp_from..end of history in double	*/
+template <class T_val>
+void gf_brute(const std::vector<T_val> &lp_hist, size_t lp_from, double &lp_min, double &lp_max, double &lp_mean,
+		double &lp_var) {
+	double lv_sum = 0;
+	lp_min = lp_max = (double)lp_hist[lp_from];
+	for (size_t i = lp_from; i < lp_hist.size(); i++) {
+		lv_sum += (double)lp_hist[i];
+		lp_min = fmin(lp_min, (double)lp_hist[i]);
+		lp_max = fmax(lp_max, (double)lp_hist[i]);
+	}
+	size_t lv_n = lp_hist.size() - lp_from;
+	lp_mean = lv_sum / lv_n;
+	double lv_m2 = 0;
+	for (size_t i = lp_from; i < lp_hist.size(); i++) lv_m2 += ((double)lp_hist[i] - lp_mean) * ((double)lp_hist[i] - lp_mean);
+	lp_var = lv_n > 1 ? lv_m2 / (lv_n - 1) : 0;
+}
+
+/*	compare result of channel with brute force, relative tolerance of mean to spread and of variance	*/
+template <class T_val>
+bool gf_cmp(const agg_stru<T_val> &lp_res, const std::vector<T_val> &lp_hist, size_t lp_from) {
+	double lv_min, lv_max, lv_mean, lv_var;
+	gf_brute(lp_hist, lp_from, lv_min, lv_max, lv_mean, lv_var);
+	double lv_scale = fmax(fabs(lv_mean), 1.0);
+	return lp_res.n == lp_hist.size() - lp_from && (double)lp_res.min == lv_min && (double)lp_res.max == lv_max
+		&& fabs(lp_res.mean - lv_mean) <= 2e-7 * lv_scale + 1e-3 * sqrt(lv_var)
+		&& fabs(lp_res.var - lv_var) <= 1e-3 * lv_var + 1e-12;
+}
+
+/*	series of pressure (Pa) or raw adc_P: slow drift, noise, report every 100 samples	*/
+template <class T_chan>
+void gf_check(const char *lp_name, double lp_base, double lp_drift, double lp_noise) {
+	typedef typename T_chan::val_t val_t;
+	T_chan lv_ch(cd_BLKLEN);
+	std::vector<val_t> lv_hist;
+	size_t lv_runFrom = 0;
+	uint32_t lv_bad = 0, lv_checks = 0;
+	for (uint32_t i = 0; i < 20000; i++) {
+		val_t x = (val_t)(lp_base + lp_drift * sin(i * 0.001) + lp_noise * gf_noise());
+		lv_ch.add(x);
+		lv_hist.push_back(x);
+		if (i % 100 != 99) continue;
+		//	window: (nBlk - 1) full blocks and current block
+		size_t lv_inCur = (i % cd_BLKLEN) + 1;
+		size_t lv_inWin = lv_hist.size() < cd_NBLK * cd_BLKLEN ? lv_hist.size() : (cd_NBLK - 1) * cd_BLKLEN + lv_inCur;
+		if (!gf_cmp(lv_ch.run(), lv_hist, lv_runFrom)) lv_bad++;
+		if (!gf_cmp(lv_ch.window(), lv_hist, lv_hist.size() - lv_inWin)) lv_bad++;
+		lv_checks += 2;
+		lv_ch.clear();
+		lv_runFrom = lv_hist.size();
+	}
+	if (lv_bad) gv_fail = 1;
+	printf("%-34s %u checks of run(), window() against double, bad = %u\n", lp_name, lv_checks, lv_bad);
+}
+
+/*	ns per sample of add() and ns per report	*/
+template <class T_chan>
+void gf_time(const char *lp_name, double lp_base, double lp_noise) {
+	typedef typename T_chan::val_t val_t;
+	T_chan lv_ch(cd_BLKLEN);
+	std::vector<val_t> lv_x(4096);
+	for (size_t i = 0; i < lv_x.size(); i++) lv_x[i] = (val_t)(lp_base + lp_noise * gf_noise());
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NSAMP; i++) lv_ch.add(lv_x[i & 4095]);
+	double lv_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / cd_NSAMP;
+	lv_t0 = std::chrono::steady_clock::now();
+	float lv_sum = 0;
+	for (uint32_t i = 0; i < cd_NSAMP / 100; i++) {
+		lv_sum += lv_ch.run().mean + lv_ch.window().var + lv_ch.ewma();
+		lv_ch.add(lv_x[i & 4095]);
+	}
+	gv_sink = lv_sum;
+	double lv_nsRep = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count()
+		/ (cd_NSAMP / 100);
+	printf("%-34s add() %.2f ns/sample, report run() + window() + ewma() %.1f ns, %u bytes\n", lp_name, lv_ns, lv_nsRep,
+		(unsigned)sizeof(lv_ch));
+}
+
+int main() {
+	gf_check<cl_AggF>("cl_AggF pressure Pa (float)", 100000.0, 200.0, 3.0);
+	gf_check<cl_AggF>("cl_AggF temperature C (float)", 21.0, 5.0, 0.01);
+	gf_check<cl_AggI>("cl_AggI adc_P (int32_t, int64_t sums)", 415148.0, 2000.0, 40.0);
+
+	gf_time<cl_AggF>("cl_AggF", 100000.0, 3.0);
+	gf_time<cl_AggI>("cl_AggI", 415148.0, 40.0);
+
+	cl_SensAgg<cl_AggF, 3> lv_agg(cd_BLKLEN);
+	tph_stru lv_tph = { 21.0f, 100000.0f, 45.0f, cd_VAL_T | cd_VAL_P | cd_VAL_H };
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NSAMP; i++) {
+		lv_tph.pres1 = 100000.0f + (float)(i & 7);
+		lv_agg.add(lv_tph);
+	}
+	double lv_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / cd_NSAMP;
+	gv_sink = lv_agg.ch(1).run().mean;
+	printf("%-34s add(tph_stru) %.2f ns/sample, %u bytes\n", "cl_SensAgg<cl_AggF, 3>", lv_ns, (unsigned)sizeof(lv_agg));
+
+	cl_AggF lv_ch(4);		// EWMA: constant input converges to input
+	for (uint8_t i = 0; i < 200; i++) lv_ch.add(12.5f);
+	if (fabs(lv_ch.ewma() - 12.5f) > 1e-4) gv_fail = 1;
+	cl_AggI lv_chI(4);
+	for (uint8_t i = 0; i < 200; i++) lv_chI.add(-4000);
+	if (fabs(lv_chI.ewma() + 4000.0f) > 1.0f) gv_fail = 1;
+	printf("ewma of constant 12.5: %.4f, -4000: %.2f\n", lv_ch.ewma(), lv_chI.ewma());
+	printf("%s\n", gv_fail ? "FAILED" : "OK");
+	return gv_fail;
+}
+
+//=================================================================================
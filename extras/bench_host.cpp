@@ -0,0 +1,359 @@
+/**
+*	@brief		Host (Linux) golden-vector test and micro-benchmark of cl_BMP280, cl_BME280, cl_BME680
+*				with simulated registers cl_SimBus (no Arduino, no sensor).
+*	@remarks	g++ -std=c++11 -O2 -I.. bench_host.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o bench_host
+*				./bench_host > bench.json		(exit code 1 if any golden vector fails, details to stderr)
+*
+*	Golden vectors: calibration data and raw adc values are written to registers of simulated sensor,
+*	results of readTP(), readTPH(), readTPHG() (_fixed and float by each backend T_comp) are compared
+*	with outputs of Bosch reference formulas, computed outside of this library: integer (BMP280 datasheet,
+*	BME280 API, BME680 API with gas table; 32 and 64 bit pressure of BMx280) and float (double precision).
+*	Integer results must be equal, float results within tolerance of backend (gf_reference()).
+*	Humidity of BME680 by gf_compBatch() must be equal to gf_compTPHG_fixed() (gf_batch680()).
+*	Benchmark: ns per compensation (compRaw() without bus), ns per read (readTP... with simulated bus),
+*	transactions and bytes per read and per asynchronous cycle start() / poll() / result(), time of
+*	the same transfers on real i2c bus 400 kHz. All results are printed as JSON to stdout.
+*/
+
+#include <mkigor_BMxx80.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+
+#define cd_NCOMP	(1UL << 20)		///	number of compensations for ns/sample
+#define cd_NREAD	(1UL << 18)		///	number of reads for ns/read
+
+//================================================
+//		golden vectors
+//================================================
+///	calibration data from Bosch datasheet BME280 (BMP280 uses T1..P9)
+const calibBME280_stru gv_cd280 = { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+	75, 362, 0, 313, 50, 30 };
+///	calibration data of typical BME680 (P10 = 30 limits 32 bit pressure formula below ~104 kPa)
+const calibBME680_stru gv_cd680 = { 26159, 26307, 3, 36358, -10434, 88, 7122, -93, 30, 40, -2878, -1553, 30,
+	776, 1004, 0, 45, 20, 120, -100, -30, -12000, 18, 40, 1, -1 };
+
+///	raw adc values and results of reference formulas, integer in native units of formulas of chip
+struct gold_stru {
+	uint32_t	adcT, adcP, adcH, adcG;
+	uint8_t		gas_range;
+	int32_t		temp1;		///	0.01 C
+	uint32_t	pres1;		///	Pa/256 (BMx280, 64 bit formula), Pa (BME680)
+	uint32_t	pres32;		///	Pa, BMx280 32 bit formula
+	uint32_t	humi1;		///	%RH/1024 (BME280), 0.001 %RH (BME680)
+	uint32_t	gasr1;		///	Ohm
+	tphg_stru	flt;		///	double formulas: T C, P Pa, H %RH, G kOhm
+};
+///	BMP280 datasheet formulas (shifts), datasheet example is vector 0: 25.08 C, 100653.27 Pa
+const gold_stru gv_goldBMP280[] = {
+	{ 519888, 415148, 0, 0, 0, 2508, 25767233, 100656, 0, 0, { 25.0825f, 100653.258f, 0, 0, 0 } },
+	{ 430000, 300000, 0, 0, 0, -317, 29533248, 115364, 0, 0, { -3.1726f, 115364.289f, 0, 0, 0 } },
+	{ 600000, 470000, 0, 0, 0, 5011, 24239090, 94686, 0, 0, { 50.1098f, 94683.949f, 0, 0, 0 } },
+	{ 480000, 350000, 0, 0, 0, 1257, 28100888, 109772, 0, 0, { 12.5669f, 109769.100f, 0, 0, 0 } },
+	{ 560000, 440000, 0, 0, 0, 3763, 25143262, 98218, 0, 0, { 37.6319f, 98215.898f, 0, 0, 0 } },
+	{ 500000, 390000, 0, 0, 0, 1885, 26622590, 103997, 0, 0, { 18.8468f, 103994.529f, 0, 0, 0 } },
+};
+///	BME280 API integer formulas (divisions, results differ from shifts by 1 LSB of t_fine), datasheet 32 bit pressure
+const gold_stru gv_goldBME280[] = {
+	{ 519888, 415148, 30000, 0, 0, 2508, 25767240, 100656, 56317, 0, { 25.0825f, 100653.258f, 55.0007f, 0, 0 } },
+	{ 430000, 300000, 20000, 0, 0, -316, 29533266, 115364, 1365, 0, { -3.1726f, 115364.289f, 1.3335f, 0, 0 } },
+	{ 600000, 470000, 40000, 0, 0, 5011, 24239097, 94686, 102400, 0, { 50.1098f, 94683.949f, 100.0f, 0, 0 } },	//	H limit
+	{ 480000, 350000, 25000, 0, 0, 1257, 28100896, 109772, 28047, 0, { 12.5669f, 109769.100f, 27.3895f, 0, 0 } },
+	{ 560000, 440000, 35000, 0, 0, 3763, 25143269, 98218, 85886, 0, { 37.6319f, 98215.898f, 83.8755f, 0, 0 } },
+	{ 500000, 390000, 28000, 0, 0, 1885, 26622599, 103997, 44839, 0, { 18.8468f, 103994.529f, 43.7875f, 0, 0 } },
+};
+///	BME680 API integer formulas (32 bit, gas table) and BME68x API float formulas
+const gold_stru gv_goldBME680[] = {
+	{ 500000, 400000, 20000, 512, 4, 2555, 92080, 92080, 37477, 499500, { 25.5485f, 92080.118f, 37.4842f, 499.5005f, 0 } },
+	{ 480000, 350000, 25000, 300, 6, 1927, 99738, 99738, 67784, 148598, { 19.2749f, 99742.751f, 67.8073f, 148.5975f, 0 } },
+	{ 520000, 420000, 18000, 700, 3, 3182, 89515, 89515, 26916, 876559, { 31.8226f, 89515.778f, 26.9219f, 876.5594f, 0 } },
+	{ 460000, 380000, 30000, 100, 9, 1300, 93617, 93617, 100000, 22600, { 13.0017f, 93615.266f, 100.0f, 22.5995f, 0 } },
+	{ 540000, 450000, 22000, 900, 2, 3810, 85121, 85121, 51060, 1549623, { 38.0971f, 85123.724f, 51.0777f, 1549.6228f, 0 } },
+	{ 505000, 330000, 15000, 400, 5, 2712, 104510, 104510, 11470, 271248, { 27.1170f, 104511.742f, 11.4724f, 271.2485f, 0 } },
+};
+#define cd_NGOLD	6
+
+uint32_t gv_nCheck = 0, gv_nFail = 0;
+volatile float gv_sink;		///	results are written here, so compiler can not remove calculation
+volatile uint32_t gv_sinkFix;
+
+/*	@brief	Count check, print failed one to stderr	*/
+void gf_expect(bool lp_ok, const char *lp_what, uint8_t lp_vec, double lp_got, double lp_exp) {
+	gv_nCheck++;
+	if (lp_ok) return;
+	gv_nFail++;
+	fprintf(stderr, "FAIL %s vector %u: got %.4f, expected %.4f\n", lp_what, lp_vec, lp_got, lp_exp);
+}
+
+//================================================
+//		registers of simulated sensors
+//================================================
+void gf_put16(uint8_t *lp_regs, int32_t lp_v) {
+	lp_regs[0] = (uint8_t)lp_v;
+	lp_regs[1] = (uint8_t)(lp_v >> 8);
+}
+
+/*	@brief	Calibration regs 0x88..0xA1, 0xE1..0xE7 of BMP280 / BME280 from structure	*/
+void gf_simCalib(uint8_t *lp_regs, const calibBME280_stru &lp_cd) {
+	const int32_t lv_c[12] = { lp_cd.T1, lp_cd.T2, lp_cd.T3, lp_cd.P1, lp_cd.P2, lp_cd.P3, lp_cd.P4, lp_cd.P5,
+		lp_cd.P6, lp_cd.P7, lp_cd.P8, lp_cd.P9 };
+	for (uint8_t i = 0; i < 12; i++) gf_put16(lp_regs + 0x88 + 2 * i, lv_c[i]);
+	lp_regs[0xA1] = lp_cd.H1;
+	gf_put16(lp_regs + 0xE1, lp_cd.H2);
+	lp_regs[0xE3] = lp_cd.H3;
+	lp_regs[0xE4] = (uint8_t)(lp_cd.H4 >> 4);
+	lp_regs[0xE5] = (uint8_t)((lp_cd.H4 & 0x0F) | ((lp_cd.H5 & 0x0F) << 4));
+	lp_regs[0xE6] = (uint8_t)(lp_cd.H5 >> 4);
+	lp_regs[0xE7] = (uint8_t)lp_cd.H6;
+}
+
+/*	@brief	Calibration regs 0x8A..0xA0, 0xE1..0xEE, 0x00..0x04 of BME680 from structure	*/
+void gf_simCalib(uint8_t *lp_regs, const calibBME680_stru &lp_cd) {
+	uint8_t *lv_r = lp_regs + 0x8A;
+	gf_put16(lv_r, lp_cd.T2);
+	lv_r[2] = (uint8_t)lp_cd.T3;
+	gf_put16(lv_r + 4, lp_cd.P1);
+	gf_put16(lv_r + 6, lp_cd.P2);
+	lv_r[8] = (uint8_t)lp_cd.P3;
+	gf_put16(lv_r + 10, lp_cd.P4);
+	gf_put16(lv_r + 12, lp_cd.P5);
+	lv_r[14] = (uint8_t)lp_cd.P7;
+	lv_r[15] = (uint8_t)lp_cd.P6;
+	gf_put16(lv_r + 18, lp_cd.P8);
+	gf_put16(lv_r + 20, lp_cd.P9);
+	lv_r[22] = lp_cd.P10;
+	lv_r = lp_regs + 0xE1;
+	lv_r[0] = (uint8_t)(lp_cd.H2 >> 4);
+	lv_r[1] = (uint8_t)(((lp_cd.H2 & 0x0F) << 4) | (lp_cd.H1 & 0x0F));
+	lv_r[2] = (uint8_t)(lp_cd.H1 >> 4);
+	lv_r[3] = (uint8_t)lp_cd.H3;
+	lv_r[4] = (uint8_t)lp_cd.H4;
+	lv_r[5] = (uint8_t)lp_cd.H5;
+	lv_r[6] = lp_cd.H6;
+	lv_r[7] = (uint8_t)lp_cd.H7;
+	gf_put16(lv_r + 8, lp_cd.T1);
+	gf_put16(lv_r + 10, lp_cd.G2);
+	lv_r[12] = (uint8_t)lp_cd.G1;
+	lv_r[13] = (uint8_t)lp_cd.G3;
+	lp_regs[0x00] = (uint8_t)lp_cd.res_heat_val;
+	lp_regs[0x02] = (uint8_t)(lp_cd.res_heat_range << 4);
+	lp_regs[0x04] = (uint8_t)(lp_cd.range_sw_err << 4);
+}
+
+/*	@brief	Raw data regs 0xF7..0xFE of BMP280 / BME280 or status and raw data regs 0x1D..0x2B of BME680
+	(new data, gas is valid, heater is stable)	*/
+void gf_simRaw(uint8_t *lp_regs, uint8_t lp_codeChip, const gold_stru &lp_v) {
+	uint8_t *lv_r = lp_regs + (lp_codeChip == cd_BME680 ? 0x1F : 0xF7);
+	lv_r[0] = (uint8_t)(lp_v.adcP >> 12);
+	lv_r[1] = (uint8_t)(lp_v.adcP >> 4);
+	lv_r[2] = (uint8_t)(lp_v.adcP << 4);
+	lv_r[3] = (uint8_t)(lp_v.adcT >> 12);
+	lv_r[4] = (uint8_t)(lp_v.adcT >> 4);
+	lv_r[5] = (uint8_t)(lp_v.adcT << 4);
+	lv_r[6] = (uint8_t)(lp_v.adcH >> 8);
+	lv_r[7] = (uint8_t)lp_v.adcH;
+	if (lp_codeChip != cd_BME680) return;
+	lp_regs[0x1D] = 0x80;
+	lv_r[11] = (uint8_t)(lp_v.adcG >> 2);
+	lv_r[12] = (uint8_t)((lp_v.adcG << 6) | 0x30 | lp_v.gas_range);
+}
+
+//================================================
+//		golden-vector tests
+//================================================
+#define cd_BE_INT32		0		///	backends: result of integer formulas (32 or 64 bit pressure) or float formulas
+#define cd_BE_INT64		1
+#define cd_BE_FLOAT		2
+#define cd_BE_DOUBLE	3
+
+tphg_stru gf_tphg(tp_stru lp_r) { tphg_stru lv_r = { lp_r.temp1, lp_r.pres1, 0, 0, lp_r.valid }; return lv_r; }
+tphg_stru gf_tphg(tph_stru lp_r) { tphg_stru lv_r = { lp_r.temp1, lp_r.pres1, lp_r.humi1, 0, lp_r.valid }; return lv_r; }
+tphg_stru gf_tphg(tphg_stru lp_r) { return lp_r; }
+tphgFixed_stru gf_fixed(tpFixed_stru lp_r) { tphgFixed_stru lv_r = { lp_r.temp1, lp_r.pres1, 0, 0, lp_r.valid }; return lv_r; }
+tphgFixed_stru gf_fixed(tphFixed_stru lp_r) { tphgFixed_stru lv_r = { lp_r.temp1, lp_r.pres1, lp_r.humi1, 0, lp_r.valid }; return lv_r; }
+tphgFixed_stru gf_fixed(tphgFixed_stru lp_r) { return lp_r; }
+
+///	read of each class by the same name
+template <class T_comp> tp_stru gf_read(cl_BMP280_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTP(); }
+template <class T_comp> tph_stru gf_read(cl_BME280_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTPH(); }
+template <class T_comp> tphg_stru gf_read(cl_BME680_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTPHG(); }
+template <class T_comp> tpFixed_stru gf_readFixed(cl_BMP280_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTP_fixed(); }
+template <class T_comp> tphFixed_stru gf_readFixed(cl_BME280_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTPH_fixed(); }
+template <class T_comp> tphgFixed_stru gf_readFixed(cl_BME680_T<cl_SimBus, T_comp> &lp_sens) { return lp_sens.readTPHG_fixed(); }
+
+/*	@brief	Expected float result of backend and its tolerance: integer formulas are only converted to float,
+	float formulas are compared with double reference (error of float calculation)	*/
+void gf_reference(const gold_stru &lp_v, uint8_t lp_codeChip, uint8_t lp_backend, tphg_stru &lp_ref, tphg_stru &lp_tol) {
+	if (lp_backend == cd_BE_FLOAT || lp_backend == cd_BE_DOUBLE) {
+		lp_ref = lp_v.flt;
+		tphg_stru lv_tolFloat = { 0.005f, 0.1f, 0.005f, 0.0005f, 0 };
+		tphg_stru lv_tolDouble = { 0.001f, 0.02f, 0.001f, 0.0001f, 0 };
+		lp_tol = lp_backend == cd_BE_FLOAT ? lv_tolFloat : lv_tolDouble;
+		return;
+	}
+	tphg_stru lv_tol = { 0.001f, 0.02f, 0.001f, 0.0001f, 0 };
+	lp_tol = lv_tol;
+	lp_ref.temp1 = lp_v.temp1 / 100.0f;
+	if (lp_codeChip == cd_BME680) {
+		lp_ref.pres1 = (float)lp_v.pres1;
+		lp_ref.humi1 = lp_v.humi1 / 1000.0f;
+		lp_ref.gasr1 = lp_v.gasr1 / 1000.0f;
+		return;
+	}
+	lp_ref.pres1 = lp_backend == cd_BE_INT32 ? (float)lp_v.pres32 : lp_v.pres1 / 256.0f;
+	lp_ref.humi1 = lp_v.humi1 / 1024.0f;
+	lp_ref.gasr1 = 0;
+}
+
+/*	@brief	Golden vectors of class: integer results (_fixed) must be equal, float results of backend within tolerance
+	@param	lp_nval	number of values of class: 2 (T P), 3 (T P H), 4 (T P H G)	*/
+template <class T_sens>
+void gf_gold(T_sens &lp_sens, uint8_t *lp_regs, const gold_stru *lp_gold, uint8_t lp_nval, uint8_t lp_backend,
+		const char *lp_name) {
+	uint8_t lv_chip = lp_sens.codeChip();
+	char lv_what[64];
+	for (uint8_t i = 0; i < cd_NGOLD; i++) {
+		const gold_stru &lv_v = lp_gold[i];
+		gf_simRaw(lp_regs, lv_chip, lv_v);
+		tphgFixed_stru lv_f = gf_fixed(gf_readFixed(lp_sens));
+		uint32_t lv_H = lv_chip == cd_BME680 ? lv_v.humi1 : (lv_v.humi1 * 125) >> 7;	//	%RH/1024 => 0.001 %RH
+		const int64_t lv_got[4] = { lv_f.temp1, lv_f.pres1, lv_f.humi1, lv_f.gasr1 };
+		const int64_t lv_exp[4] = { lv_v.temp1, lv_v.pres1, lv_H, lv_v.gasr1 };
+		tphg_stru lv_r = gf_tphg(gf_read(lp_sens));
+		tphg_stru lv_ref, lv_tol;
+		gf_reference(lv_v, lv_chip, lp_backend, lv_ref, lv_tol);
+		const float lv_gotF[4] = { lv_r.temp1, lv_r.pres1, lv_r.humi1, lv_r.gasr1 };
+		const float lv_expF[4] = { lv_ref.temp1, lv_ref.pres1, lv_ref.humi1, lv_ref.gasr1 };
+		const float lv_tolF[4] = { lv_tol.temp1, lv_tol.pres1, lv_tol.humi1, lv_tol.gasr1 * lv_ref.gasr1 };
+		for (uint8_t k = 0; k < lp_nval; k++) {
+			snprintf(lv_what, sizeof(lv_what), "%s %c _fixed", lp_name, "TPHG"[k]);
+			gf_expect(lv_got[k] == lv_exp[k], lv_what, i, lv_got[k], lv_exp[k]);
+			snprintf(lv_what, sizeof(lv_what), "%s %c", lp_name, "TPHG"[k]);
+			gf_expect(fabs(lv_gotF[k] - lv_expF[k]) <= lv_tolF[k], lv_what, i, lv_gotF[k], lv_expF[k]);
+		}
+	}
+}
+
+//================================================
+//		micro-benchmarks
+//================================================
+float gf_sum(tp_stru lp_r) { return lp_r.temp1 + lp_r.pres1; }
+float gf_sum(tph_stru lp_r) { return lp_r.temp1 + lp_r.pres1 + lp_r.humi1; }
+float gf_sum(tphg_stru lp_r) { return lp_r.temp1 + lp_r.pres1 + lp_r.humi1 + lp_r.gasr1; }
+uint32_t gf_sum(tpFixed_stru lp_r) { return lp_r.temp1 + lp_r.pres1; }
+uint32_t gf_sum(tphFixed_stru lp_r) { return lp_r.temp1 + lp_r.pres1 + lp_r.humi1; }
+uint32_t gf_sum(tphgFixed_stru lp_r) { return lp_r.temp1 + lp_r.pres1 + lp_r.humi1 + lp_r.gasr1; }
+
+double gf_ns(std::chrono::steady_clock::time_point lp_t0, uint32_t lp_n) {
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lp_t0).count() / lp_n;
+}
+
+bool gv_first = true;		///	first object of JSON array "bench"
+
+/*	@brief	Benchmark of sensor object, print one JSON object
+	@param	lp_raw	cd_NGOLD sets of raw regs (6, 8 or 13 bytes) for compRaw()
+	@param	lp_nraw	bytes in one set
+	@param	lp_fail	failed checks of golden vectors of the same object	*/
+template <class T_sens>
+void gf_bench(const char *lp_class, const char *lp_backend, T_sens &lp_sens, const uint8_t *lp_raw, uint8_t lp_nraw,
+		uint32_t lp_fail) {
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	float lv_sum = 0;
+	for (uint32_t i = 0; i < cd_NCOMP; i++) lv_sum += gf_sum(lp_sens.compRaw(lp_raw + (i % cd_NGOLD) * lp_nraw));
+	double lv_nsComp = gf_ns(lv_t0, cd_NCOMP);
+	lv_t0 = std::chrono::steady_clock::now();
+	uint32_t lv_fix = 0;
+	for (uint32_t i = 0; i < cd_NCOMP; i++) lv_fix += gf_sum(lp_sens.compRaw_fixed(lp_raw + (i % cd_NGOLD) * lp_nraw));
+	double lv_nsFixed = gf_ns(lv_t0, cd_NCOMP);
+	lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NREAD; i++) lv_sum += gf_sum(gf_read(lp_sens));
+	double lv_nsRead = gf_ns(lv_t0, cd_NREAD);
+	gv_sink = lv_sum;
+	gv_sinkFix = lv_fix;
+
+	lp_sens.clearBusStat();
+	gf_sum(gf_read(lp_sens));
+	busStat_stru lv_read = lp_sens.busStat();
+	lp_sens.clearBusStat();
+	lp_sens.bus().clearBusTime();
+	uint32_t lv_deadline = lp_sens.start(0);
+	lp_sens.poll(lv_deadline);
+	gf_sum(lp_sens.result());
+	busStat_stru lv_cycle = lp_sens.busStat();
+
+	printf("%s\n    { \"class\": \"%s\", \"backend\": \"%s\", \"ns_comp\": %.1f, \"ns_comp_fixed\": %.1f, \"ns_read\": %.1f,\n"
+		"      \"read_trans\": %u, \"read_bytes\": %u, \"cycle_trans\": %u, \"cycle_bytes\": %u, \"cycle_bus_us\": %u,"
+		" \"golden_failed\": %u }",
+		gv_first ? "" : ",", lp_class, lp_backend, lv_nsComp, lv_nsFixed, lv_nsRead,
+		lv_read.trans, lv_read.bytes, lv_cycle.trans, lv_cycle.bytes, lp_sens.bus().busTime(), lp_fail);
+	gv_first = false;
+}
+
+/*	@brief	Simulated sensor of class with backend T_comp: golden vectors and benchmark	*/
+template <template <class, class, class> class T_cl, class T_comp>
+void gf_run(uint8_t lp_codeChip, const char *lp_class, const char *lp_backend, uint8_t lp_be) {
+	cl_SimBus lv_bus;
+	lv_bus.setClock(400000);
+	uint8_t *lv_regs = lv_bus.addDevice(0x76, lp_codeChip);
+	const gold_stru *lv_gold = gv_goldBME680;
+	uint8_t lv_nraw = 13, lv_nval = 4;
+	if (lp_codeChip == cd_BME680) gf_simCalib(lv_regs, gv_cd680);
+	else {
+		gf_simCalib(lv_regs, gv_cd280);
+		lv_gold = lp_codeChip == cd_BMP280 ? gv_goldBMP280 : gv_goldBME280;
+		lv_nraw = lp_codeChip == cd_BMP280 ? 6 : 8;
+		lv_nval = lp_codeChip == cd_BMP280 ? 2 : 3;
+	}
+	uint8_t lv_raw[cd_NGOLD * 13];
+	for (uint8_t i = 0; i < cd_NGOLD; i++) {
+		gf_simRaw(lv_regs, lp_codeChip, lv_gold[i]);
+		memcpy(lv_raw + i * lv_nraw, lv_regs + (lp_codeChip == cd_BME680 ? 0x1F : 0xF7), lv_nraw);
+	}
+	T_cl<cl_SimBus, T_comp, cd_DEF_INSTR> lv_sens(lv_bus);
+	lv_sens.check(0x76);
+	lv_sens.begin();
+	char lv_name[48];
+	snprintf(lv_name, sizeof(lv_name), "%s %s", lp_class, lp_backend);
+	uint32_t lv_fail = gv_nFail;
+	gf_gold(lv_sens, lv_regs, lv_gold, lv_nval, lp_be, lv_name);
+	gf_bench(lp_class, lp_backend, lv_sens, lv_raw, lv_nraw, gv_nFail - lv_fail);
+}
+
+template <template <class, class, class> class T_cl>
+void gf_runAll(uint8_t lp_codeChip, const char *lp_class) {
+	gf_run<T_cl, cl_compInt32>(lp_codeChip, lp_class, "cl_compInt32", cd_BE_INT32);
+	gf_run<T_cl, cl_compInt64>(lp_codeChip, lp_class, "cl_compInt64", cd_BE_INT64);
+	gf_run<T_cl, cl_compFloat>(lp_codeChip, lp_class, "cl_compFloat", cd_BE_FLOAT);
+	gf_run<T_cl, cl_compDouble>(lp_codeChip, lp_class, "cl_compDouble", cd_BE_DOUBLE);
+}
+
+/*	@brief	Humidity of BME680 by gf_compBatch() is the same as by gf_compTPHG_fixed() (limits 0..100 %RH too),
+	golden vectors and adc_H at both ends	*/
+void gf_batch680(void) {
+	uint32_t lv_adcT[cd_NGOLD + 2], lv_adcP[cd_NGOLD + 2], lv_adcH[cd_NGOLD + 2];
+	int32_t lv_temp[cd_NGOLD + 2], lv_humi[cd_NGOLD + 2];
+	for (uint8_t i = 0; i < cd_NGOLD + 2; i++) {
+		const gold_stru &lv_v = gv_goldBME680[i < cd_NGOLD ? i : 0];
+		lv_adcT[i] = lv_v.adcT;
+		lv_adcP[i] = lv_v.adcP;
+		lv_adcH[i] = i < cd_NGOLD ? lv_v.adcH : i == cd_NGOLD ? 0 : 65535;
+	}
+	gf_compBatch(gv_cd680, lv_adcT, lv_adcP, lv_adcH, NULL, NULL, cd_NGOLD + 2, lv_temp, NULL, lv_humi, NULL);
+	for (uint8_t i = 0; i < cd_NGOLD + 2; i++) {
+		tphgFixed_stru lv_r = gf_compTPHG_fixed(gv_cd680, lv_adcT[i], lv_adcP[i], lv_adcH[i], 0x8000, 0);
+		gf_expect((uint32_t)lv_humi[i] == lv_r.humi1, "BME680 gf_compBatch() humidity", i, lv_humi[i], lv_r.humi1);
+	}
+}
+
+int main() {
+	gf_batch680();
+	printf("{\n  \"bench\": [");
+	gf_runAll<cl_BMP280_T>(cd_BMP280, "cl_BMP280");
+	gf_runAll<cl_BME280_T>(cd_BME280, "cl_BME280");
+	gf_runAll<cl_BME680_T>(cd_BME680, "cl_BME680");
+	printf("\n  ],\n  \"golden\": { \"vectors\": %u, \"checks\": %u, \"failed\": %u }\n}\n",
+		3 * cd_NGOLD, gv_nCheck, gv_nFail);
+	return gv_nFail ? 1 : 0;
+}
+
+//=================================================================================
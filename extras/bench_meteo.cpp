@@ -0,0 +1,151 @@
+/**
+*	@brief		Host (Linux) test of mkigor_BMxx80_meteo.h: max error of fast approximations and derived quantities
+*				against double libm, ns/call of them against float libm (powf, logf, expf), cache of cl_Meteo.
+*	@remarks	g++ -std=c++11 -O2 -I.. bench_meteo.cpp ../mkigor_BMxx80_meteo.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o bench_meteo
+*				exit code 1 if any error is above bound of mkigor_BMxx80_meteo.h
+*/
+
+#include <mkigor_BMxx80_meteo.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+
+#define cd_NCALL	2000000UL	///	calls of each timed function
+
+volatile float gv_sink;			///	results of timed loops, so compiler keeps them
+uint8_t gv_fail = 0;
+
+/*	print max error and check bound	*/
+void gf_report(const char *lp_name, double lp_err, double lp_bound, const char *lp_unit) {
+	bool lv_ok = lp_err < lp_bound;
+	if (!lv_ok) gv_fail = 1;
+	printf("%-28s max error %.3g %s (bound %.3g) %s\n", lp_name, lp_err, lp_unit, lp_bound, lv_ok ? "OK" : "FAILED");
+}
+
+//============================================
+//	Accuracy against double libm
+//============================================
+void gf_accuracy(void) {
+	double lv_eLog = 0, lv_eExp = 0, lv_ePow = 0, lv_eAlt = 0, lv_eSea = 0, lv_eDew = 0, lv_eAbs = 0;
+	for (float x = 1e-6f; x < 1e7f; x *= 1.0001f) {
+		double lv_l = log2((double)x);	// error above rounding of float result
+		lv_eLog = fmax(lv_eLog, fabs(gf_fastLog2(x) - lv_l) - fabs((float)lv_l - lv_l));
+		double lv_p = pow((double)x, 0.190295);
+		lv_ePow = fmax(lv_ePow, fabs(gf_fastPow(x, 0.190295f) - lv_p) / lv_p);
+	}
+	for (float x = -60.0f; x < 60.0f; x += 0.0001f) {
+		double lv_r = exp2((double)x);
+		lv_eExp = fmax(lv_eExp, fabs(gf_fastExp2(x) - lv_r) / lv_r);
+	}
+	double lv_eTop = 0;			// n is clamped to 127: f up to 0.99, result is finite
+	for (float x = 120.0f; x < 140.0f; x += 0.001f) {
+		double lv_r = exp2(fmin((double)x, 127.99));
+		float lv_f = gf_fastExp2(x);
+		lv_eTop = fmax(lv_eTop, isfinite(lv_f) ? fabs(lv_f - lv_r) / lv_r : 1.0);
+	}
+	for (float p = 30000.0f; p <= 110000.0f; p += 0.25f) {
+		lv_eAlt = fmax(lv_eAlt, fabs(gf_altitude(p, 101325.0f) - 44330.0 * (1.0 - pow(p / 101325.0, 0.190295))));
+		for (float h = -400.0f; h <= 8000.0f; h += 700.0f) {
+			double lv_r = p / pow(1.0 - h / 44330.0, 5.255);
+			lv_eSea = fmax(lv_eSea, fabs(gf_seaLevel(p, h) - lv_r) / lv_r);
+		}
+	}
+	for (float t = -40.0f; t <= 85.0f; t += 0.05f) {
+		for (float h = 1.0f; h <= 100.0f; h += 0.05f) {
+			double lv_g = log(h / 100.0) + 17.62 * t / (243.12 + t);
+			lv_eDew = fmax(lv_eDew, fabs(gf_dewPoint(t, h) - 243.12 * lv_g / (17.62 - lv_g)));
+			double lv_a = 216.7 * h / 100.0 * 6.112 * exp(17.62 * t / (243.12 + t)) / (273.15 + t);
+			lv_eAbs = fmax(lv_eAbs, fabs(gf_absHumi(t, h) - lv_a) / lv_a);
+		}
+	}
+	gf_report("gf_fastLog2 1e-6..1e7", lv_eLog, 3e-7, "+ rounding");
+	gf_report("gf_fastExp2 -60..60", lv_eExp, 3e-7, "relative");
+	gf_report("gf_fastExp2 120..140", lv_eTop, 2e-5, "relative");
+	gf_report("gf_fastPow x^0.19", lv_ePow, 5e-7, "relative");
+	gf_report("gf_altitude 300..1100 hPa", lv_eAlt, 0.02, "m");
+	gf_report("gf_seaLevel -400..8000 m", lv_eSea, 1e-6, "relative");
+	gf_report("gf_dewPoint -40..85 C", lv_eDew, 0.001, "C");
+	gf_report("gf_absHumi -40..85 C", lv_eAbs, 2e-6, "relative");
+}
+
+//============================================
+//	Speed against float libm
+//============================================
+/*	ns per call of lp_fn(x), x changes each call	*/
+template <class T_fn>
+double gf_ns(T_fn lp_fn, float lp_x0, float lp_dx) {
+	float lv_sum = 0, x = lp_x0;
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NCALL; i++) {
+		lv_sum += lp_fn(x);
+		x += lp_dx;
+	}
+	gv_sink = lv_sum;
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / cd_NCALL;
+}
+
+void gf_speed(void) {
+	printf("%-20s %8s %8s\n", "ns/call", "fast", "libm");
+	printf("%-20s %8.2f %8.2f\n", "log2", gf_ns([](float x) { return gf_fastLog2(x); }, 1.0f, 0.001f),
+		gf_ns([](float x) { return log2f(x); }, 1.0f, 0.001f));
+	printf("%-20s %8.2f %8.2f\n", "exp", gf_ns([](float x) { return gf_fastExp(x); }, -5.0f, 0.000005f),
+		gf_ns([](float x) { return expf(x); }, -5.0f, 0.000005f));
+	printf("%-20s %8.2f %8.2f\n", "pow", gf_ns([](float x) { return gf_fastPow(x, 0.190295f); }, 1.0f, 0.001f),
+		gf_ns([](float x) { return powf(x, 0.190295f); }, 1.0f, 0.001f));
+	printf("%-20s %8.2f %8.2f\n", "altitude", gf_ns([](float p) { return gf_altitude(p); }, 80000.0f, 0.01f),
+		gf_ns([](float p) { return 44330.0f * (1.0f - powf(p / 101325.0f, 0.190295f)); }, 80000.0f, 0.01f));
+	printf("%-20s %8.2f %8.2f\n", "dew point", gf_ns([](float h) { return gf_dewPoint(21.5f, h); }, 10.0f, 0.00004f),
+		gf_ns([](float h) { float g = logf(h / 100.0f) + 17.62f * 21.5f / (243.12f + 21.5f);
+			return 243.12f * g / (17.62f - g); }, 10.0f, 0.00004f));
+}
+
+//============================================
+//	cl_Meteo: cache of slowly changing samples (oversampling x16, filter x16: noise 0.2 Pa, 0.003 C, 0.01 %RH)
+//============================================
+/*	sample i of series: slow change of T by 2 C and of P by 20 Pa, uniform noise	*/
+tph_stru gf_sample(uint32_t i, uint32_t &lp_seed) {
+	lp_seed = lp_seed * 1103515245UL + 12345;
+	float lv_noise = (float)((lp_seed >> 16) & 0xFF) / 256.0f - 0.5f;	// -0.5..0.5
+	tph_stru lv_tph;
+	lv_tph.temp1 = 21.0f + 0.002f * (float)(i % 1000) + 0.006f * lv_noise;
+	lv_tph.pres1 = 100000.0f + 0.02f * (float)(i % 1000) + 0.4f * lv_noise;
+	lv_tph.humi1 = 45.0f + 0.02f * lv_noise;
+	return lv_tph;
+}
+
+void gf_cache(void) {
+	cl_Meteo lv_met(101325.0f, 120.0f);
+	uint32_t lv_seed = 1;
+	double lv_err = 0;
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NCALL; i++) {
+		tph_stru lv_tph = gf_sample(i, lv_seed);
+		const meteo_stru &lv_res = lv_met.calc(lv_tph);
+		gv_sink = lv_res.alt + lv_res.seaP + lv_res.dew + lv_res.absH;
+		if ((i & 0x3FF) == 0) lv_err = fmax(lv_err, fabs(lv_res.dew - gf_dewPoint(lv_tph.temp1, lv_tph.humi1)));
+	}
+	double lv_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / cd_NCALL;
+	lv_seed = 1;
+	lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < cd_NCALL; i++) {
+		tph_stru lv_tph = gf_sample(i, lv_seed);
+		gv_sink = gf_altitude(lv_tph.pres1) + gf_seaLevel(lv_tph.pres1, 120.0f) + gf_dewPoint(lv_tph.temp1, lv_tph.humi1)
+			+ gf_absHumi(lv_tph.temp1, lv_tph.humi1);
+	}
+	double lv_nsDirect = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / cd_NCALL;
+	meteoStat_stru lv_st = lv_met.stat();
+	printf("cl_Meteo calc(tph_stru): %.2f ns/call (single gf_ functions %.2f), recalculated P %.1f %%, T %.1f %%, H %.1f %%\n",
+		lv_ns, lv_nsDirect, 100.0 * lv_st.recalcP / lv_st.calls, 100.0 * lv_st.recalcT / lv_st.calls,
+		100.0 * lv_st.recalcH / lv_st.calls);
+	gf_report("cl_Meteo dew point by cache", lv_err, 0.01, "C");
+}
+
+int main() {
+	gf_accuracy();
+	gf_speed();
+	gf_cache();
+	printf("%s\n", gv_fail ? "FAILED" : "OK");
+	return gv_fail;
+}
+
+//=================================================================================
@@ -0,0 +1,100 @@
+/**
+*	@brief		Host (Linux) test of mkigor_BMxx80_scan.h: sensors of 3 simulated buses (cl_SimBus) are found by one scan(),
+*				classes of objects, addresses and buses are checked, reset is done only if it is asked,
+*				time of enumeration on i2c bus is compared with check() of each address.
+*	@remarks	g++ -std=c++11 -O2 -I.. bench_scan.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o bench_scan
+*				exit code 1 if any check fails
+*/
+
+#include <mkigor_BMxx80_scan.h>
+#include "test_util.h"
+
+#define cd_STARTUP	2000		///	start up time of sensor after soft reset, us (datasheet, not simulated)
+
+struct count_f {		///	functor of applyAll(): number of objects of each class
+	uint8_t n280, n680, nAll;
+	void operator()(cl_BMP280_T<cl_SimBus> &) { nAll++; }
+	void operator()(cl_BME280_T<cl_SimBus> &) { n280++; nAll++; }
+	void operator()(cl_BME680_T<cl_SimBus> &) { n680++; nAll++; }
+};
+
+///	bus 0: BME280 0x76, BMP280 0x77; bus 1: other device (id 0x55) 0x76, BME680 0x77; bus 2: BME280 0x76
+void gf_sim(cl_SimBus *lp_bus) {
+	for (uint8_t b = 0; b < 3; b++) lp_bus[b].setClock(400000);
+	lp_bus[0].addDevice(0x76, cd_BME280);
+	lp_bus[0].addDevice(0x77, cd_BMP280);
+	lp_bus[1].addDevice(0x76, 0x55);
+	lp_bus[1].addDevice(0x77, cd_BME680);
+	lp_bus[2].addDevice(0x76, cd_BME280);
+}
+
+uint32_t gf_busTime(cl_SimBus *lp_bus) {
+	uint32_t lv_t = 0;
+	for (uint8_t b = 0; b < 3; b++) {
+		lv_t += lp_bus[b].busTime();
+		lp_bus[b].clearBusTime();
+	}
+	return lv_t;
+}
+
+int main() {
+	cl_SimBus lv_bus[3];
+	cl_SimBus *lv_pbus[3] = { &lv_bus[0], &lv_bus[1], &lv_bus[2] };
+	gf_sim(lv_bus);
+
+	//	scan without reset
+	cl_SensorSet_T<cl_SimBus, 6> lv_set;
+	gf_busTime(lv_bus);
+	uint8_t lv_n = lv_set.scan(lv_pbus, 3);
+	uint32_t lv_tScan = gf_busTime(lv_bus);
+	gf_expect(lv_n == 4 && lv_set.size() == 4, "4 sensors are found, other device is skipped");
+	const uint8_t lv_chip[4] = { cd_BME280, cd_BME280, cd_BMP280, cd_BME680 };	// address by address on all buses
+	const uint8_t lv_ibus[4] = { 0, 2, 0, 1 };
+	const uint8_t lv_addr[4] = { 0x76, 0x76, 0x77, 0x77 };
+	for (uint8_t i = 0; i < 4; i++) {
+		gf_expect(lv_set.codeChip(i) == lv_chip[i] && lv_set.busIndex(i) == lv_ibus[i] && lv_set.addr(i) == lv_addr[i],
+			"chip, bus and address of sensor");
+		gf_expect((lv_set.bmp280(i) != NULL) == (lv_chip[i] == cd_BMP280) && (lv_set.bme280(i) != NULL) == (lv_chip[i] == cd_BME280)
+			&& (lv_set.bme680(i) != NULL) == (lv_chip[i] == cd_BME680), "typed object only of its chip");
+	}
+	gf_expect(lv_set.codeChip(4) == 0 && lv_set.bme280(4) == NULL && lv_set.busIndex(4) == cd_SCAN_NONE, "no sensor 4");
+	gf_expect(lv_set.find(cd_BME280) == 0 && lv_set.find(cd_BME280, 1) == 1 && lv_set.find(cd_BME280, 2) == cd_SCAN_NONE
+		&& lv_set.find(cd_BME680) == 3, "find()");
+	gf_expect(lv_set.bme680(3)->codeChip() == cd_BME680 && &lv_set.bme680(3)->bus() == &lv_bus[1], "object is bound to bus");
+	gf_expect(lv_bus[0].regs(0x76)[0xE0] == 0 && lv_bus[1].regs(0x77)[0xE0] == 0, "no soft reset by default");
+	count_f lv_cnt = { 0, 0, 0 };
+	lv_set.applyAll(lv_cnt);
+	gf_expect(lv_cnt.nAll == 4 && lv_cnt.n280 == 2 && lv_cnt.n680 == 1, "applyAll() calls functor of class of each chip");
+	gf_expect(lv_set.beginAll() == 4 && lv_set.bme280(1)->calibOk(), "beginAll()");
+	gf_expect(lv_bus[2].regs(0x76)[0xF2] == cd_OS_x16 && lv_bus[1].regs(0x77)[0x72] == cd_OS_x16, "begin() of each chip is called");
+	gf_busTime(lv_bus);
+
+	//	the same sensors by check() of each address, default reset
+	cl_BMP280_T<cl_SimBus> lv_probe[3] = { cl_BMP280_T<cl_SimBus>(lv_bus[0]), cl_BMP280_T<cl_SimBus>(lv_bus[1]),
+		cl_BMP280_T<cl_SimBus>(lv_bus[2]) };
+	uint8_t lv_nCheck = 0;
+	for (uint8_t b = 0; b < 3; b++)
+		for (uint8_t a = 0x76; a <= 0x77; a++) {
+			uint8_t lv_code = lv_probe[b].check(a);
+			lv_nCheck += lv_code == cd_BMP280 || lv_code == cd_BME280 || lv_code == cd_BME680;
+		}
+	uint32_t lv_tCheck = gf_busTime(lv_bus);
+	gf_expect(lv_nCheck == 4 && lv_bus[0].regs(0x76)[0xE0] == 0xB6, "check() finds the same sensors with reset");
+
+	//	scan with reset
+	for (uint8_t b = 0; b < 3; b++)		// reset reg of check() above
+		for (uint8_t a = 0x76; a <= 0x77; a++)
+			if (lv_bus[b].regs(a)) lv_bus[b].regs(a)[0xE0] = 0;
+	cl_SensorSet_T<cl_SimBus, 2> lv_set2;
+	gf_expect(lv_set2.scan(lv_pbus, 3, true) == 2 && lv_bus[0].regs(0x76)[0xE0] == 0xB6
+		&& lv_bus[0].regs(0x77)[0xE0] == 0, "scan with reset, only T_max sensors");
+	const uint8_t lv_cs[1] = { 0x77 };
+	gf_expect(lv_set2.scan(lv_pbus, 3, lv_cs, 1) == 2 && lv_set2.bmp280(0) && lv_set2.bme680(1), "scan of list of addresses");
+
+	printf("scan of 3 buses, 2 addresses: %u sensors, i2c 400 kHz %u us, host %u us\n", lv_n, lv_tScan, lv_set.scanTime());
+	printf("check() of each address: %u sensors, i2c 400 kHz %u us + start up after reset %u us = %u us\n", lv_nCheck,
+		lv_tCheck, lv_nCheck * cd_STARTUP, lv_tCheck + lv_nCheck * cd_STARTUP);
+	return gf_checks();
+}
+
+//=================================================================================
@@ -0,0 +1,106 @@
+/**
+*	@brief		Host (Linux) test of mkigor_BMxx80_stream.h: throughput of cl_SpscRing between two threads
+*				and cl_SensStream with simulated BME280 in normal mode (virtual time, sensor clock is 3 % faster).
+*	@remarks	g++ -std=c++11 -O2 -pthread -I.. bench_stream.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o bench_stream
+*				exit code 1 if ring changes order of items, stream has duplicates, lost samples or overrun of ring,
+*				or it misses more than 1 % of samples of sensor
+*/
+
+#include <mkigor_BMxx80_stream.h>
+#include <mkigor_BMxx80_plan.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+
+#define cd_NITEMS	20000000UL
+#define cd_MISS_PC	1			///	max missed samples of sensor, %: stream follows clock of sensor
+
+//	planner is constexpr: samples of IIR filter to 75 % of step, ceil(ln(0.25) / ln(1 - 1/c))
+static_assert(gf_filterSteps(cd_FIL_x4) == 5 && gf_filterSteps(cd_FIL_x16) == 22, "gf_filterSteps x4, x16");
+static_assert(gf_filterSteps(cd_FIL_x64) == 89 && gf_filterSteps(cd_FIL_x128) == 177, "gf_filterSteps x64, x128");
+
+uint8_t gv_fail = 0;
+
+cl_SpscRing<streamRaw_stru, 1024> gv_ring;
+
+/*	two threads: producer pushes numbered items, consumer takes them in batches and checks order	*/
+void gf_benchRing(void) {
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	std::thread lv_prod([] {
+		streamRaw_stru lv_item;
+		memset(&lv_item, 0, sizeof(lv_item));
+		for (uint32_t i = 0; i < cd_NITEMS; ) {
+			lv_item.time = i;
+			if (gv_ring.push(lv_item)) i++;
+			else std::this_thread::yield();		// ring is full, consumer must work (also on 1 CPU)
+		}
+	});
+	streamRaw_stru lv_batch[64];
+	uint32_t lv_expect = 0, lv_bad = 0;
+	while (lv_expect < cd_NITEMS) {
+		ringIdx_t lv_n = gv_ring.popBatch(lv_batch, 64);
+		if (lv_n == 0) std::this_thread::yield();
+		for (ringIdx_t i = 0; i < lv_n; i++)
+			if (lv_batch[i].time != lv_expect++) lv_bad++;
+	}
+	lv_prod.join();
+	double lv_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - lv_t0).count();
+	printf("cl_SpscRing 2 threads: %.1f M items/sec, order errors = %u, ring full (push retries) = %u\n",
+		cd_NITEMS / lv_sec / 1e6, lv_bad, gv_ring.overrun());
+	if (lv_bad) gv_fail = 1;
+}
+
+/*	simulated sensor: new data every lp_sensPeriod, conversion (status bit <3>) takes lp_measTime before it	*/
+void gf_benchStream(void) {
+	cl_SimBus lv_bus;
+	uint8_t *lv_regs = lv_bus.addDevice(0x76, cd_BME280);
+	const int16_t lv_cd[12] = { 27504, 26435, -1000, (int16_t)36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+	for (uint8_t i = 0; i < 12; i++) {
+		lv_regs[0x88 + 2 * i] = (uint8_t)lv_cd[i];
+		lv_regs[0x89 + 2 * i] = (uint8_t)(lv_cd[i] >> 8);
+	}
+	cl_BME280_T<cl_SimBus> lv_bme(lv_bus);
+	lv_bme.check(0x76);
+	lv_bme.begin(cd_NOR_MODE, cd_SB_125MS, cd_FIL_x4, cd_OS_x1, cd_OS_x4, cd_OS_x1);
+	static cl_SpscRing<streamRaw_stru, 256> lv_ring;
+	cl_SensStream<cl_BME280_T<cl_SimBus> > lv_stream(lv_bme);
+	uint32_t lv_period = gf_normPeriod(cd_BME280, cd_SB_125MS, cd_OS_x1, cd_OS_x4, cd_OS_x1);
+	uint32_t lv_sensPeriod = lv_period - lv_period * 3 / 100;	// sensor clock is faster than datasheet
+	uint32_t lv_measTime = gf_measTimeTyp(cd_BME280, cd_OS_x1, cd_OS_x4, cd_OS_x1);
+	lv_stream.begin(lv_period, 0);
+	uint32_t lv_nsens = 0, lv_dup = 0, lv_last = 0xFFFFFFFF;
+	streamRaw_stru lv_item;
+	for (uint32_t lv_now = 0; lv_now < 3600000000UL; lv_now += 100) {	// 1 hour, step 100 us
+		uint32_t lv_k = lv_now / lv_sensPeriod;		// sample of sensor, data are updated at end of conversion
+		if (lv_k >= lv_nsens) {
+			lv_nsens = lv_k + 1;
+			uint32_t lv_adcT = 519888 + 16 * (lv_k % 1000);	// data are different in each sample
+			lv_regs[0xFA] = (uint8_t)(lv_adcT >> 12);
+			lv_regs[0xFB] = (uint8_t)(lv_adcT >> 4);
+			lv_regs[0xFC] = (uint8_t)(lv_adcT << 4);
+		}
+		lv_regs[0xF3] = (lv_now % lv_sensPeriod) >= lv_sensPeriod - lv_measTime ? 0x08 : 0x00;
+		lv_stream.poll(lv_now, lv_ring);
+		while (lv_ring.pop(lv_item)) {
+			uint32_t lv_t = ((uint32_t)lv_item.regs[3] << 16) | (lv_item.regs[4] << 8) | lv_item.regs[5];
+			if (lv_t == lv_last) lv_dup++;
+			lv_last = lv_t;
+		}
+	}
+	printf("cl_SensStream 1 hour: sensor samples = %u, stream samples = %u, missed = %u, duplicates = %u, "
+		"reads = %u (%.2f per sample), overrun = %u\n", lv_nsens, lv_stream.samples(), lv_stream.missed(), lv_dup,
+		lv_stream.reads(), (double)lv_stream.reads() / lv_stream.samples(), lv_ring.overrun());
+	//	each sample of sensor is read once or counted as missed (+1 sample of sensor at end of hour)
+	uint32_t lv_count = lv_stream.samples() + lv_stream.missed();
+	if (lv_dup || lv_ring.overrun() || lv_count > lv_nsens || lv_count + 1 < lv_nsens
+		|| lv_stream.missed() * 100 > (uint32_t)cd_MISS_PC * lv_nsens) gv_fail = 1;
+}
+
+int main() {
+	gf_benchRing();
+	gf_benchStream();
+	printf("%s\n", gv_fail ? "FAILED" : "OK");
+	return gv_fail;
+}
+
+//=================================================================================
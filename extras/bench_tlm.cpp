@@ -0,0 +1,179 @@
+/**
+*	@brief		Host (Linux) test of mkigor_BMxx80_tlm.h: bytes per sample of telemetry packets (varint and bit-packing,
+*				payload 51 bytes of LoRa SF10 and 242 bytes of LoRa SF7), round-trip error, samples/s of encoder and decoder.
+*	@remarks	g++ -std=c++11 -O2 -I.. bench_tlm.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp ../mkigor_BMxx80_tlm.cpp
+*				../mkigor_BMxx80_log.cpp -o bench_tlm
+*				./bench_tlm [file.log]	series of recorded raw log (cl_RawLogWriter) or synthetic one week every minute
+*				exit code 1 if any decoded value differs more than step / 2 or number of samples is wrong
+*/
+
+#include <mkigor_BMxx80_tlm.h>
+#include <mkigor_BMxx80_log.h>
+#include "test_util.h"
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#define cd_NSYNT	10080		///	samples of synthetic series, one week every minute
+#define cd_NREP		50			///	repeats of timed loops
+
+uint8_t gv_fail = 0;
+
+/*	synthetic series: daily cycle of T and H, weather front of P, drift of G, noise of sensor	*/
+void gf_synt(std::vector<tphg_stru> &lp_ser) {
+	float lv_gas = 120.0f;
+	for (uint32_t i = 0; i < cd_NSYNT; i++) {
+		double lv_day = 2.0 * M_PI * i / 1440.0;
+		tphg_stru lv_s;
+		lv_s.temp1 = (float)(21.0 + 3.0 * sin(lv_day)) + 0.01f * gf_noise();
+		lv_s.pres1 = (float)(100500.0 + 600.0 * sin(lv_day / 3.5)) + 3.0f * gf_noise();
+		lv_s.humi1 = (float)(45.0 - 10.0 * sin(lv_day)) + 0.05f * gf_noise();
+		lv_gas += 0.2f * gf_noise();
+		lv_s.gasr1 = lv_gas + 0.5f * gf_noise();
+		lp_ser.push_back(lv_s);
+	}
+}
+
+/*	encode series to packets of payload lp_len, return bytes, lp_pk = packets one by one	*/
+size_t gf_encode(const tlmCfg_stru &lp_cfg, uint8_t lp_mode, const std::vector<tphg_stru> &lp_ser, uint16_t lp_len,
+		std::vector<uint8_t> &lp_pk, std::vector<uint16_t> &lp_sizes) {
+	uint8_t lv_buf[256];
+	lp_pk.clear();
+	lp_sizes.clear();
+	size_t i = 0;
+	cl_TlmEncoder lv_enc(lp_cfg);
+	while (i < lp_ser.size()) {
+		uint16_t lv_size = 0;
+		if (lp_mode == cd_TLM_VARINT) {
+			lv_enc.begin(lv_buf, lp_len);
+			while (i < lp_ser.size() && lv_enc.add(lp_ser[i])) i++;
+			lv_size = lv_enc.size();
+			if (lv_enc.count() == 0) return 0;
+		}
+		else {
+			size_t lv_rest = lp_ser.size() - i;
+			uint8_t lv_n = gf_tlmPackBits(lp_cfg, &lp_ser[i], lv_rest > cd_TLM_MAXSAMP ? cd_TLM_MAXSAMP : (uint8_t)lv_rest,
+				lv_buf, lp_len, lv_size);
+			if (lv_n == 0) return 0;
+			i += lv_n;
+		}
+		lp_pk.insert(lp_pk.end(), lv_buf, lv_buf + lv_size);
+		lp_sizes.push_back(lv_size);
+	}
+	return lp_pk.size();
+}
+
+/*	decode all packets, check count and error of each value, return number of bad values	*/
+uint32_t gf_decode(const tlmCfg_stru &lp_cfg, const std::vector<tphg_stru> &lp_ser, const std::vector<uint8_t> &lp_pk,
+		const std::vector<uint16_t> &lp_sizes, bool lp_check) {
+	cl_TlmDecoder lv_dec;
+	size_t lv_pos = 0, i = 0;
+	uint32_t lv_bad = 0;
+	for (size_t k = 0; k < lp_sizes.size(); k++) {
+		if (!lv_dec.begin(&lp_pk[lv_pos], lp_sizes[k])) return 1;
+		tphg_stru lv_s;
+		while (lv_dec.next(lv_s)) {
+			if (lp_check && i < lp_ser.size()) {
+				const float *lv_v = &lv_s.temp1, *lv_o = &lp_ser[i].temp1;
+				for (uint8_t c = 0; c < lp_cfg.nCh; c++) {
+					double lv_step = pow(10.0, lp_cfg.exp[c]);
+					if (fabs((double)lv_v[c] - lv_o[c]) > 0.5 * lv_step + 4e-7 * fabs(lv_o[c])) lv_bad++;
+				}
+			}
+			i++;
+		}
+		lv_pos += lp_sizes[k];
+	}
+	if (i != lp_ser.size()) lv_bad++;
+	return lv_bad;
+}
+
+void gf_bench(const char *lp_name, const tlmCfg_stru &lp_cfg, uint8_t lp_mode, const std::vector<tphg_stru> &lp_ser,
+		uint16_t lp_len) {
+	std::vector<uint8_t> lv_pk;
+	std::vector<uint16_t> lv_sizes;
+	size_t lv_bytes = gf_encode(lp_cfg, lp_mode, lp_ser, lp_len, lv_pk, lv_sizes);
+	uint32_t lv_bad = lv_bytes ? gf_decode(lp_cfg, lp_ser, lv_pk, lv_sizes, true) : 1;
+	if (lv_bad) gv_fail = 1;
+
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint8_t r = 0; r < cd_NREP; r++) gf_encode(lp_cfg, lp_mode, lp_ser, lp_len, lv_pk, lv_sizes);
+	double lv_enc = std::chrono::duration<double>(std::chrono::steady_clock::now() - lv_t0).count();
+	lv_t0 = std::chrono::steady_clock::now();
+	for (uint8_t r = 0; r < cd_NREP; r++) gf_decode(lp_cfg, lp_ser, lv_pk, lv_sizes, false);
+	double lv_dec = std::chrono::duration<double>(std::chrono::steady_clock::now() - lv_t0).count();
+
+	double lv_n = (double)lp_ser.size() * cd_NREP;
+	printf("%-8s payload %3u: %5u packets, %.2f bytes/sample (raw %u, x%.1f), encode %.1f, decode %.1f Msamples/s, bad = %u\n",
+		lp_name, lp_len, (unsigned)lv_sizes.size(), (double)lv_bytes / lp_ser.size(), lp_cfg.nCh * 4u,
+		lp_cfg.nCh * 4.0 * lp_ser.size() / lv_bytes, lv_n / lv_enc * 1e-6, lv_n / lv_dec * 1e-6, lv_bad);
+}
+
+int main(int argc, char **argv) {
+	std::vector<tphg_stru> lv_ser;
+	tlmCfg_stru lv_cfg = { 4, { -2, 0, -2, -1 } };	// T 0.01 C, P 1 Pa, H 0.01 %RH, G 0.1 kOhm
+	if (argc > 1) {
+		cl_RawLogReader lv_log;
+		if (!lv_log.open(argv[1])) {
+			printf("can not open log %s\n", argv[1]);
+			return 1;
+		}
+		for (uint32_t i = 0; i < lv_log.count(); i++) lv_ser.push_back(lv_log.comp(i));
+		lv_cfg.nCh = lv_log.codeChip() == cd_BMP280 ? 2 : lv_log.codeChip() == cd_BME280 ? 3 : 4;
+		printf("log %s: %u samples\n", argv[1], (unsigned)lv_ser.size());
+	}
+	else {
+		gf_synt(lv_ser);
+		printf("synthetic series: %u samples\n", (unsigned)lv_ser.size());
+	}
+	if (lv_ser.empty()) return 1;
+
+	gf_bench("varint", lv_cfg, cd_TLM_VARINT, lv_ser, 51);
+	gf_bench("bitpack", lv_cfg, cd_TLM_BITPACK, lv_ser, 51);
+	gf_bench("varint", lv_cfg, cd_TLM_VARINT, lv_ser, 242);
+	gf_bench("bitpack", lv_cfg, cd_TLM_BITPACK, lv_ser, 242);
+
+	//	edge cases: negative values, big jumps (4 byte varints, 26 bit widths), broken packets
+	tlmCfg_stru lv_cfg2 = { 2, { 0, 0 } };
+	std::vector<tphg_stru> lv_edge;
+	tphg_stru lv_s = { -16000000.0f, 16000000.0f, 0.0f, 0.0f, 0 };
+	lv_edge.push_back(lv_s);
+	lv_s.temp1 = 16000000.0f;
+	lv_s.pres1 = -16000000.0f;
+	lv_edge.push_back(lv_s);
+	lv_s.temp1 = -3.0f;
+	lv_s.pres1 = 0.0f;
+	lv_edge.push_back(lv_s);
+	uint8_t lv_mode[2] = { cd_TLM_VARINT, cd_TLM_BITPACK };
+	for (uint8_t m = 0; m < 2; m++) {
+		std::vector<uint8_t> lv_pk;
+		std::vector<uint16_t> lv_sizes;
+		if (!gf_encode(lv_cfg2, lv_mode[m], lv_edge, 64, lv_pk, lv_sizes) || lv_sizes.size() != 1
+			|| gf_decode(lv_cfg2, lv_edge, lv_pk, lv_sizes, true)) gv_fail = 1;
+		cl_TlmDecoder lv_dec;		// truncated packet: decoder stops without reading out of buffer
+		tphg_stru lv_r;
+		uint8_t lv_got = 0;
+		if (lv_dec.begin(&lv_pk[0], lv_sizes[0] - 1))
+			while (lv_dec.next(lv_r)) lv_got++;
+		if (lv_got >= lv_edge.size()) gv_fail = 1;
+		lv_pk[0] ^= 0xF0;			// wrong version
+		if (lv_dec.begin(&lv_pk[0], lv_sizes[0])) gv_fail = 1;
+	}
+	//	values out of range |v / step| >= 2^24, NaN: not encoded (no overflow of int32_t)
+	uint8_t lv_buf[64];
+	uint16_t lv_size;
+	cl_TlmEncoder lv_enc(lv_cfg2);
+	float lv_big[2] = { 1.0f, 17000000.0f }, lv_nan[2] = { 1.0f, 0.0f };
+	lv_nan[1] = lv_nan[1] / lv_nan[1];
+	lv_enc.begin(lv_buf, sizeof(lv_buf));
+	if (lv_enc.add(lv_big) || lv_enc.add(lv_nan) || !lv_enc.add(lv_edge[0]) || lv_enc.count() != 1) gv_fail = 1;
+	lv_edge[1].pres1 = 1e30f;
+	if (gf_tlmPackBits(lv_cfg2, &lv_edge[0], 3, lv_buf, sizeof(lv_buf), lv_size) != 1
+		|| gf_tlmPackBits(lv_cfg2, &lv_edge[1], 2, lv_buf, sizeof(lv_buf), lv_size) != 0) gv_fail = 1;
+	printf("edge cases (+-16e6, truncated packet, wrong version, out of range): %s\n", gv_fail ? "bad" : "ok");
+	printf("%s\n", gv_fail ? "FAILED" : "OK");
+	return gv_fail;
+}
+
+//=================================================================================
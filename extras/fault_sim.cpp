@@ -0,0 +1,209 @@
+/**
+*	@brief		Host (Linux) fault-injection test of status returns, retries and validity flags of results
+*				with simulated registers cl_SimBus: short reads, NACK of writes, random faults, skipped measuring,
+*				BME680 gas_valid_r / heat_stab_r.
+*	@remarks	g++ -std=c++11 -O2 -I.. fault_sim.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o fault_sim
+*				exit code 1 if any check fails: wrong value is accepted as valid, retries or latency are out of bounds
+*/
+
+#include <mkigor_BMxx80.h>
+#include "test_util.h"
+#include <chrono>
+
+#define cd_NRAND	20000		///	reads of random faults test
+#define cd_SLACK	2000		///	delay of host scheduler (preemption of busy wait), us
+
+typedef cl_BME280_T<cl_SimBus, cl_compInt64, cl_instrFull>	cl_Sens280;
+typedef cl_BME680_T<cl_SimBus, cl_compInt32, cl_instrFull>	cl_Sens680;
+
+bool gf_same(const tph_stru &a, const tph_stru &b) {
+	return a.temp1 == b.temp1 && a.pres1 == b.pres1 && a.humi1 == b.humi1 && a.valid == b.valid;
+}
+
+bool gf_zero(const tph_stru &a) {
+	return a.temp1 == 0 && a.pres1 == 0 && a.humi1 == 0 && a.valid == 0;
+}
+
+uint32_t gf_us(void) {
+	return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*	@brief	Bus errors of reads, writes and calibration without retries: status FALSE, results are 0 and not valid	*/
+void gf_noRetry(cl_SimBus &lp_bus, uint8_t *lp_regs) {
+	cl_Sens280 lv_s(lp_bus);
+	lv_s.check(0x76);
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.begin(), "begin() = FALSE if calibration read fails");
+	gf_expect(!lv_s.calibOk(), "calibOk() = FALSE after failed calibration read");
+	gf_expect(lv_s.readTPH().valid == 0, "read without calibration is not valid");
+	gf_expect(lv_s.begin() && lv_s.calibOk(), "begin() = TRUE without faults");
+	tph_stru lv_ref = lv_s.readTPH();
+	gf_expect(lv_ref.valid == (cd_VAL_T | cd_VAL_P | cd_VAL_H), "reference read is valid");
+	gf_expect(lv_ref.temp1 > 25.0f && lv_ref.temp1 < 25.2f, "reference temperature 25.08 C");
+
+	lp_bus.setFault(1, 0);
+	gf_expect(gf_zero(lv_s.readTPH()), "short read: result is 0, not valid");
+	gf_expect(gf_same(lv_s.readTPH(), lv_ref), "next read is the same as reference");
+	lp_bus.setFault(1, 0);
+	gf_expect(lv_s.readTPH_fixed().valid == 0, "short read of _fixed(): not valid");
+
+	uint8_t lv_id = 0x5A;
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.readReg(0xD0, lv_id) && lv_id == 0x5A, "readReg() status FALSE, data is not changed");
+	gf_expect(lv_s.readReg(0xD0, lv_id) && lv_id == cd_BME280, "readReg() status TRUE, chip id");
+
+	lp_regs[0xF3] = 0x08;		// measuring
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.isMeas(), "isMeas() = FALSE on bus error (wait loop does not stall)");
+	gf_expect(lv_s.isMeas(), "isMeas() = TRUE without fault");
+	lp_regs[0xF3] = 0;
+
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.do1Meas(), "do1Meas() = FALSE on NACK");
+	lp_bus.setFault(1, 0);
+	uint32_t lv_d = lv_s.start(0);
+	gf_expect(lv_s.state() == cd_ST_IDLE && !lv_s.poll(lv_d), "start() with NACK: state IDLE, poll() = FALSE");
+	lv_d = lv_s.start(0);
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.poll(lv_d) && lv_s.state() == cd_ST_IDLE && lv_s.result().valid == 0,
+		"poll() with short read: state IDLE, result() not valid");
+	printf("no retries: status of read, write, calibration, poll()\n");
+}
+
+/*	@brief	Retries with backoff: recovery of short faults, latency of long fault is limited by budget	*/
+void gf_retry(cl_SimBus &lp_bus) {
+	cl_Sens280 lv_s(lp_bus);
+	lv_s.check(0x76);
+	lv_s.begin();
+	tph_stru lv_ref = lv_s.readTPH();
+
+	lv_s.setRetry(5000, 50, 2);
+	lv_s.clearBusStat();
+	lp_bus.setFault(3, 0);
+	gf_expect(gf_same(lv_s.readTPH(), lv_ref), "3 faults, retries: read is the same as reference");
+	gf_expect(lv_s.instr().stat().retries == 3 && lv_s.instr().stat().errors == 3, "3 retries, 3 errors");
+	lp_bus.setFault(2, 0);
+	gf_expect(lv_s.do1Meas(), "2 NACK, retries: do1Meas() = TRUE");
+	lp_bus.setFault(1, 0);
+	lv_s.clearBusStat();
+	gf_expect(lv_s.begin() && lv_s.instr().stat().retries == 1, "fault of calibration read, retry: begin() = TRUE");
+
+	//	waits 100, 200, 400, 800 us = 1500 us, the next wait 1600 us ends after budget 2000 us,
+	//	scheduler of host may delay busy wait, then less retries fit in budget
+	lv_s.setRetry(2000, 100, 2);
+	lv_s.clearBusStat();
+	lp_bus.setFault(1000, 0);
+	uint32_t lv_t0 = gf_us();
+	tph_stru lv_r = lv_s.readTPH();
+	uint32_t lv_lat = gf_us() - lv_t0;
+	uint32_t lv_n = lv_s.instr().stat().retries;
+	gf_expect(gf_zero(lv_r), "long fault: result is 0, not valid");
+	gf_expect(lv_n >= 1 && lv_n <= 4, "long fault: 1..4 retries in budget 2000 us");
+	gf_expect(lv_lat >= 100 * ((1UL << lv_n) - 1) && lv_lat < 2000 + cd_SLACK, "long fault: latency within budget");
+	lp_bus.setFault(0, 0);
+	printf("retries: 3 faults recovered, long fault %u retries, latency %u us (budget 2000 us)\n",
+		(unsigned)lv_n, (unsigned)lv_lat);
+}
+
+/*	@brief	Random faults: valid results are the same as reference, not valid ones are 0	*/
+void gf_random(cl_SimBus &lp_bus, uint32_t lp_budget, uint16_t lp_rate) {
+	cl_Sens280 lv_s(lp_bus);
+	lv_s.check(0x76);
+	lv_s.begin();
+	tph_stru lv_ref = lv_s.readTPH();
+	lv_s.setRetry(lp_budget, 10, 2);
+	lv_s.clearBusStat();
+	lp_bus.setFault(0, lp_rate, 12345);
+	uint32_t lv_valid = 0, lv_wrong = 0;
+	for (uint32_t i = 0; i < cd_NRAND; i++) {
+		tph_stru lv_r = lv_s.readTPH();
+		if (lv_r.valid) {
+			lv_valid++;
+			if (!gf_same(lv_r, lv_ref)) lv_wrong++;
+		}
+		else if (!gf_zero(lv_r)) lv_wrong++;
+	}
+	uint32_t lv_faults = lp_bus.faults();
+	lp_bus.setFault(0, 0);
+	gf_expect(lv_wrong == 0, "random faults: wrong value accepted");
+	if (lp_budget) gf_expect(lv_valid == cd_NRAND, "random faults with retries: all reads are valid");
+	printf("random faults %.1f %%, budget %4u us: %u faults, %u retries, valid %u / %u, wrong %u\n",
+		lp_rate * 100.0 / 65536, (unsigned)lp_budget, (unsigned)lv_faults, (unsigned)lv_s.instr().stat().retries,
+		(unsigned)lv_valid, cd_NRAND, (unsigned)lv_wrong);
+}
+
+/*	@brief	Skipped measuring (adc 0x80000, 0x8000) clears flags of value	*/
+void gf_skipped(cl_SimBus &lp_bus, uint8_t *lp_regs) {
+	cl_Sens280 lv_s(lp_bus);
+	lv_s.check(0x76);
+	lv_s.begin();
+	uint8_t lv_save[8];
+	memcpy(lv_save, lp_regs + 0xF7, 8);
+	lp_regs[0xFD] = 0x80; lp_regs[0xFE] = 0x00;				// adc_H = 0x8000
+	gf_expect(lv_s.readTPH().valid == (cd_VAL_T | cd_VAL_P), "humidity skipped");
+	lp_regs[0xF7] = 0x80; lp_regs[0xF8] = 0x00; lp_regs[0xF9] = 0x00;	// adc_P = 0x80000
+	gf_expect(lv_s.readTPH().valid == cd_VAL_T, "pressure and humidity skipped");
+	gf_expect(lv_s.readTPH_fixed().pres1 == 0, "pressure skipped: value is 0");
+	lp_regs[0xFA] = 0x80; lp_regs[0xFB] = 0x00; lp_regs[0xFC] = 0x00;	// adc_T = 0x80000
+	tphFixed_stru lv_r = lv_s.readTPH_fixed();
+	gf_expect(lv_r.valid == 0 && lv_r.temp1 == 0, "temperature skipped: nothing is valid, value is 0");
+	memcpy(lp_regs + 0xF7, lv_save, 8);
+	preBME280_stru lv_pc;		// free functions and backends without class set flags too
+	gf_precalc(lv_pc, lv_s.calib());
+	gf_expect(gf_compTPH_fixed(lv_pc, 519888, cd_ADC_SKIP, 30000).valid == (cd_VAL_T | cd_VAL_H)
+		&& gf_compTPH(lv_pc, 519888, 415148, cd_ADC_SKIP_H).valid == (cd_VAL_T | cd_VAL_P), "flags of gf_compTPH*()");
+	gf_expect(cl_compInt32::compTPH(lv_s.calib(), lv_pc, 519888, cd_ADC_SKIP, 30000).valid == (cd_VAL_T | cd_VAL_H)
+		&& cl_compDouble::compTPH(lv_s.calib(), lv_pc, cd_ADC_SKIP, 415148, 30000).valid == 0, "flags of backends");
+	printf("skipped measuring: flags of T, P, H\n");
+}
+
+/*	@brief	BME680 gas_valid_r, heat_stab_r of reg 0x2B to flags cd_VAL_G, cd_VAL_HEAT	*/
+void gf_gas(cl_SimBus &lp_bus) {
+	uint8_t *lv_regs = lp_bus.addDevice(0x77, cd_BME680);
+	uint32_t lv_seed = 7;
+	for (uint16_t i = 0; i < 256; i++) {	// pseudo random calibration
+		lv_seed = lv_seed * 1103515245UL + 12345;
+		lv_regs[i] = (uint8_t)(lv_seed >> 16);
+	}
+	lv_regs[0xD0] = cd_BME680;
+	lv_regs[0x1D] = 0x80;
+	lv_regs[0x1F + 3] = 0x7E;				// adc_T is not 0x80000
+	cl_Sens680 lv_s(lp_bus);
+	lv_s.check(0x77);
+	lv_s.begin();
+	gf_expect(gf_compTPHG_fixed(lv_s.calib(), 500000, cd_ADC_SKIP, 20000, 512, 4).valid == (cd_VAL_T | cd_VAL_H)
+		&& cl_compFloat::compTPHG(lv_s.calib(), preBME680_stru(), 500000, 400000, 20000, 512, 4).valid
+		== (cd_VAL_T | cd_VAL_P | cd_VAL_H), "BME680 flags of free functions and backends (without gas flags)");
+	uint32_t lv_time = lv_s.measTime();
+	lp_bus.setFault(1, 0);
+	gf_expect(!lv_s.initGasPointX(0, 320, 100, 20) && lv_s.measTime() == lv_time, "initGasPointX() = FALSE on NACK, time is kept");
+	gf_expect(lv_s.initGasPointX(0, 320, 100, 20) && lv_s.measTime() > lv_time, "initGasPointX() = TRUE, heating time is added");
+	const uint8_t lv_bits[4] = { 0x00, 0x10, 0x20, 0x30 };
+	const uint8_t lv_flag[4] = { 0, cd_VAL_HEAT, cd_VAL_G, cd_VAL_G | cd_VAL_HEAT };
+	lv_s.clearBusStat();
+	for (uint8_t i = 0; i < 4; i++) {
+		lv_regs[0x2B] = (lv_regs[0x2B] & 0xCF) | lv_bits[i];
+		gf_expect((lv_s.readTPHG().valid & (cd_VAL_G | cd_VAL_HEAT)) == lv_flag[i], "BME680 gas flags of readTPHG()");
+		gf_expect((lv_s.readTPHG_fixed().valid & (cd_VAL_G | cd_VAL_HEAT)) == lv_flag[i], "BME680 gas flags of _fixed()");
+	}
+	gf_expect(lv_s.instr().stat().gasInvalid == 4 && lv_s.instr().stat().heatUnstable == 4, "BME680 gas counters");
+	printf("BME680: gas_valid_r, heat_stab_r to flags cd_VAL_G, cd_VAL_HEAT\n");
+}
+
+int main() {
+	cl_SimBus lv_bus;
+	uint8_t *lv_regs = lv_bus.addDevice(0x76, cd_BME280);
+	gf_simBME280(lv_regs);
+
+	gf_noRetry(lv_bus, lv_regs);
+	gf_retry(lv_bus);
+	gf_random(lv_bus, 0, 6554);			// 10 % of transactions fail
+	gf_random(lv_bus, 2000, 6554);
+	gf_skipped(lv_bus, lv_regs);
+	gf_gas(lv_bus);
+
+	return gf_checks();
+}
+
+//=================================================================================
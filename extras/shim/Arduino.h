@@ -0,0 +1,27 @@
+/**
+*	@brief		Minimal Arduino core for host (Linux) build of the library with -DARDUINO (see extras/wire_sim.cpp):
+*				time functions by steady clock, pins do nothing. It is not a full Arduino emulation.
+*/
+
+#ifndef shim_Arduino_h
+#define shim_Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define HIGH	1
+#define LOW		0
+#define INPUT	0
+#define OUTPUT	1
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long lp_ms);
+void delayMicroseconds(unsigned int lp_us);
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+#endif
+
+//=================================================================================
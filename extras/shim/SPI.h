@@ -0,0 +1,29 @@
+/**
+*	@brief		Minimal SPIClass for host (Linux) build with -DARDUINO: no device answers (transfer() returns 0xFF).
+*/
+
+#ifndef shim_SPI_h
+#define shim_SPI_h
+
+#include <Arduino.h>
+
+#define MSBFIRST	1
+#define SPI_MODE0	0
+
+struct SPISettings {
+	SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+	void begin(void) {}
+	void beginTransaction(SPISettings) {}
+	void endTransaction(void) {}
+	uint8_t transfer(uint8_t) { return 0xFF; }
+};
+
+extern SPIClass SPI;
+
+#endif
+
+//=================================================================================
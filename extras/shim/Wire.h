@@ -0,0 +1,52 @@
+/**
+*	@brief		Minimal TwoWire for host (Linux) build with -DARDUINO: i2c transactions of Arduino Wire API
+*				on register maps of devices in RAM (e.g. maps of cl_SimBus::addDevice()).
+*	@remarks	Write of 1 byte sets register pointer, write of more bytes is pairs {address, data} (Bosch sensors),
+*				requestFrom() reads from register pointer with auto increment. Absent address answers NACK.
+*				The transmit buffer is 32 bytes as Wire of AVR, longer write fails.
+*/
+
+#ifndef shim_Wire_h
+#define shim_Wire_h
+
+#include <Arduino.h>
+
+#define cd_WIRE_MAXDEV	4		///	max number of devices on shim bus
+#define cd_WIRE_BUF		32		///	size of transmit and receive buffers
+
+class TwoWire {
+private:
+	uint8_t clv_ndev;
+	uint8_t clv_addr[cd_WIRE_MAXDEV];
+	uint8_t *clv_regs[cd_WIRE_MAXDEV];
+	uint8_t clv_ptr[cd_WIRE_MAXDEV];	///	register pointer of each device
+	uint8_t clv_dev;					///	address of current transmission
+	uint8_t clv_tx[cd_WIRE_BUF];
+	uint8_t clv_ntx;
+	bool clv_over;						///	transmit buffer overflow
+	uint8_t clv_rx[cd_WIRE_BUF];
+	uint8_t clv_nrx, clv_irx;
+	uint32_t clv_nBegin;				///	number of begin() calls
+	int8_t clf_find(uint8_t lp_dev);
+
+public:
+	TwoWire() : clv_ndev(0), clv_dev(0), clv_ntx(0), clv_over(false), clv_nrx(0), clv_irx(0), clv_nBegin(0) {}
+	void attach(uint8_t lp_dev, uint8_t *lp_regs);	///	device with 256 registers lp_regs answers on address lp_dev
+	uint32_t nBegin(void) { return clv_nBegin; }
+
+	void begin(void) { clv_nBegin++; }
+	void setClock(uint32_t) {}
+	void beginTransmission(uint8_t lp_dev);
+	size_t write(uint8_t lp_data);
+	size_t write(const uint8_t *lp_data, size_t lp_n);
+	uint8_t endTransmission(bool lp_stop = true);	///	0 = success, 1 = data too long, 2 = NACK of address
+	uint8_t requestFrom(uint8_t lp_dev, uint8_t lp_n);
+	int available(void) { return clv_nrx - clv_irx; }
+	int read(void) { return clv_irx < clv_nrx ? clv_rx[clv_irx++] : -1; }
+};
+
+extern TwoWire Wire;
+
+#endif
+
+//=================================================================================
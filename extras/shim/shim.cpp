@@ -0,0 +1,97 @@
+/**
+*	@brief		Minimal Arduino core, TwoWire, SPIClass for host (Linux) build with -DARDUINO, see Wire.h
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+#include <chrono>
+#include <thread>
+
+TwoWire Wire;
+SPIClass SPI;
+
+//============================================
+//	time functions by steady clock
+//============================================
+unsigned long micros(void) {
+	return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned long millis(void) {
+	return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void delay(unsigned long lp_ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(lp_ms));
+}
+
+void delayMicroseconds(unsigned int lp_us) {
+	uint32_t lv_t0 = (uint32_t)micros();
+	while ((uint32_t)micros() - lv_t0 < lp_us) {}
+}
+
+//============================================
+//	TwoWire on register maps in RAM
+//============================================
+int8_t TwoWire::clf_find(uint8_t lp_dev) {
+	for (uint8_t i = 0; i < clv_ndev; i++)
+		if (clv_addr[i] == lp_dev) return i;
+	return -1;
+}
+
+void TwoWire::attach(uint8_t lp_dev, uint8_t *lp_regs) {
+	int8_t lv_i = clf_find(lp_dev);
+	if (lv_i < 0) {
+		if (clv_ndev >= cd_WIRE_MAXDEV) return;
+		lv_i = clv_ndev++;
+		clv_addr[lv_i] = lp_dev;
+	}
+	clv_regs[lv_i] = lp_regs;
+	clv_ptr[lv_i] = 0;
+}
+
+void TwoWire::beginTransmission(uint8_t lp_dev) {
+	clv_dev = lp_dev;
+	clv_ntx = 0;
+	clv_over = false;
+}
+
+size_t TwoWire::write(uint8_t lp_data) {
+	if (clv_ntx >= cd_WIRE_BUF) {
+		clv_over = true;
+		return 0;
+	}
+	clv_tx[clv_ntx++] = lp_data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *lp_data, size_t lp_n) {
+	size_t lv_n = 0;
+	while (lv_n < lp_n && write(lp_data[lv_n])) lv_n++;
+	return lv_n;
+}
+
+/*	@brief	1 byte sets register pointer, 2 * n bytes write n pairs {address, data}	*/
+uint8_t TwoWire::endTransmission(bool) {
+	if (clv_over) return 1;
+	int8_t lv_i = clf_find(clv_dev);
+	if (lv_i < 0) return 2;
+	if (clv_ntx == 1) clv_ptr[lv_i] = clv_tx[0];
+	else for (uint8_t i = 0; i + 1 < clv_ntx; i += 2) clv_regs[lv_i][clv_tx[i]] = clv_tx[i + 1];
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t lp_dev, uint8_t lp_n) {
+	clv_nrx = clv_irx = 0;
+	int8_t lv_i = clf_find(lp_dev);
+	if (lv_i < 0) return 0;
+	if (lp_n > cd_WIRE_BUF) lp_n = cd_WIRE_BUF;
+	for (uint8_t i = 0; i < lp_n; i++) clv_rx[i] = clv_regs[lv_i][clv_ptr[lv_i]++];
+	clv_nrx = lp_n;
+	return lp_n;
+}
+
+//=================================================================================
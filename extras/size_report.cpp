@@ -0,0 +1,75 @@
+/**
+*	@brief		Host (Linux) report of RAM (sizeof of object) and code size of sensor classes by chip and instrumentation,
+*				for comparing of changes of class layout.
+*	@remarks	g++ -std=c++11 -Os -I.. size_report.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o size_report
+*				./size_report	sizeof of objects, JSON on stdout
+*				code size of one chip: build with -Dcd_SIZE_CHIP=cd_BMP280 (cd_BME280, cd_BME680)
+*				and -ffunction-sections -Wl,--gc-sections, then compare "size size_report" with -Dcd_SIZE_CHIP=0
+*				(the same for MCU, for ex. avr-size of sketch examples/bench_backend.ino)
+*/
+
+#include <mkigor_BMxx80.h>
+#include <stdio.h>
+
+#ifndef cd_SIZE_CHIP
+#define cd_SIZE_CHIP	0xFF		///	all chips, only sizeof report
+#endif
+
+#define gd_SIZEOF(T)	printf("    \"%s\": %u,\n", #T, (unsigned)sizeof(T))
+
+typedef cl_BMP280_T<cl_SimBus, cl_compInt64, cl_instrNone>	cl_BMP280none;
+typedef cl_BME280_T<cl_SimBus, cl_compInt64, cl_instrNone>	cl_BME280none;
+typedef cl_BME680_T<cl_SimBus, cl_compInt32, cl_instrNone>	cl_BME680none;
+typedef cl_BMP280_T<cl_SimBus, cl_compInt64, cl_instrFull>	cl_BMP280full;
+typedef cl_BME280_T<cl_SimBus, cl_compInt64, cl_instrFull>	cl_BME280full;
+typedef cl_BME680_T<cl_SimBus, cl_compInt32, cl_instrFull>	cl_BME680full;
+
+/*	@brief	Typical use of chip: check(), begin(), start(), poll(), result(), readX(), so its code is linked	*/
+template <class T_sens>
+float gf_use(T_sens &lp_sens) {
+	lp_sens.check(0x76);
+	lp_sens.begin();
+	lp_sens.start(0);
+	lp_sens.poll(lp_sens.measTime());
+	return lp_sens.result().temp1 + lp_sens.result_fixed().temp1;
+}
+
+int main() {
+	printf("{\n  \"sizeof\": {\n");
+	gd_SIZEOF(calibBMP280_stru);
+	gd_SIZEOF(calibBME280_stru);
+	gd_SIZEOF(calibBME680_stru);
+	gd_SIZEOF(preBMP280_stru);
+	gd_SIZEOF(preBME280_stru);
+	gd_SIZEOF(preBME680_stru);
+	gd_SIZEOF(cl_BMP280none);
+	gd_SIZEOF(cl_BME280none);
+	gd_SIZEOF(cl_BME680none);
+	gd_SIZEOF(cl_BMP280);
+	gd_SIZEOF(cl_BME280);
+	gd_SIZEOF(cl_BME680);
+	gd_SIZEOF(cl_BMP280full);
+	gd_SIZEOF(cl_BME280full);
+	gd_SIZEOF(cl_BME680full);
+	printf("    \"cl_SimBus\": %u\n  },\n", (unsigned)sizeof(cl_SimBus));
+
+	float lv_sum = 0;
+	cl_SimBus lv_bus;
+#if cd_SIZE_CHIP == cd_BMP280
+	lv_bus.addDevice(0x76, cd_BMP280);
+	cl_BMP280_T<cl_SimBus> lv_sens(lv_bus);
+	lv_sum = gf_use(lv_sens) + lv_sens.readTP().pres1;
+#elif cd_SIZE_CHIP == cd_BME280
+	lv_bus.addDevice(0x76, cd_BME280);
+	cl_BME280_T<cl_SimBus> lv_sens(lv_bus);
+	lv_sum = gf_use(lv_sens) + lv_sens.readTPH().humi1;
+#elif cd_SIZE_CHIP == cd_BME680
+	lv_bus.addDevice(0x76, cd_BME680);
+	cl_BME680_T<cl_SimBus> lv_sens(lv_bus);
+	lv_sum = gf_use(lv_sens) + lv_sens.readTPHG().gasr1;
+#endif
+	printf("  \"chip\": %u,\n  \"result\": %.1f\n}\n", (unsigned)cd_SIZE_CHIP, lv_sum);
+	return 0;
+}
+
+//=================================================================================
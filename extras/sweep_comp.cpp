@@ -0,0 +1,333 @@
+/**
+*	@brief		Host (Linux) sweep of integer compensation of BMP280, BME280, BME680 over full range of adc values
+*				against double formulas (cl_compDouble), work is divided between all CPU cores.
+*	@remarks	g++ -std=c++11 -O2 -fwrapv -pthread -I.. sweep_comp.cpp ../mkigor_BMxx80.cpp -o sweep_comp
+*				./sweep_comp [number of threads]
+*				(-fwrapv: overflow of 32 bit integer gives the same wrong result as on MCU; build with
+*				-fsanitize=signed-integer-overflow instead of it to see the line of formula with overflow)
+*
+*	For each chip and each calibration block: T for all 2^20 adc_T, P for all 2^20 adc_P at 16 temperatures,
+*	H for all 2^16 adc_H at 16 temperatures, G for all 2^10 adc_G and 16 gas ranges (about 52 M samples per block).
+*	For each integer path it prints max error against double formula in working range of sensor
+*	(-40..85 C, 300..1100 hPa, 0..100 %RH) and in full range of adc, number of overflows (error above cd_OVER_*,
+*	so result of integer formula is wrong, not rounded) with first adc value, and number of zero divisors
+*	(formula returns 0 instead of division by zero).
+*	"H table": humidity by table of gf_humTab() (cd_HTAB_NODE nodes) against integer formula at 16384 temperatures,
+*	exit code is 1 if its max deviation in working range is above cd_HTAB_BOUND.
+*/
+
+#include <mkigor_BMxx80.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#define cd_NTEMP	16			///	temperatures of P, H sweeps (= gas ranges of G sweep), parts of T sweep
+#define cd_OVER_T	1.0			///	error above it is overflow: C, Pa, %RH, % of G
+#define cd_OVER_P	100.0
+#define cd_OVER_H	2.0
+#define cd_OVER_G	5.0
+#define cd_HTAB_NODE	16		///	nodes of table of accelerated humidity (gf_humTab())
+#define cd_HTAB_BOUND	0.06	///	stated max deviation of table from integer formula in working range, %RH
+#define cd_HTAB_HMAX	95.0	///	working range of table check 0..95 %RH: above it int32 formula of BME680 is near
+								///	overflow, its own error against double formula is up to 2 %RH
+
+//================================================
+//		calibration blocks
+//================================================
+///	datasheet BME280, typical sensor, the same with extreme T2 / P9, zero (calibration regs read as 0, bus error)
+const calibBME280_stru gv_cd280[] = {
+	{ 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000, 75, 362, 0, 313, 50, 30 },
+	{ 28485, 26735, 50, 37712, -10500, 3024, 7062, -84, -7, 9900, -10230, 4285, 75, 363, 0, 318, 0, 30 },
+	{ 28485, 32767, 50, 37712, -10500, 3024, 7062, -84, -7, 9900, -10230, 32767, 75, 363, 0, 318, 0, 30 },
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+///	typical sensors (P10 = 30), the same with P10 = 255, zero
+const calibBME680_stru gv_cd680[] = {
+	{ 26159, 26307, 3, 36358, -10434, 88, 7122, -93, 30, 40, -2878, -1553, 30,
+		776, 1004, 0, 45, 20, 120, -100, -30, -12000, 18, 40, 1, -1 },
+	{ 25992, 26519, 3, 36796, -10420, 88, 6426, -109, 30, 34, -219, -3043, 30,
+		752, 1026, 0, 45, 20, 120, -100, -24, -12855, 18, 44, 1, 1 },
+	{ 26159, 26307, 3, 36358, -10434, 88, 7122, -93, 30, 40, -2878, -1553, 255,
+		776, 1004, 0, 45, 20, 120, -100, -30, -12000, 18, 40, 1, -1 },
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+#define cd_NCALIB	4
+
+//================================================
+//		statistics of errors
+//================================================
+struct errStat_stru {
+	double		maxErr[2];		///	[0] working range of sensor, [1] full range of adc
+	uint32_t	maxAdc[2];		///	adc value of max error
+	uint64_t	nOver[2];		///	number of overflows
+	uint32_t	overAdc[2];		///	adc value of first overflow
+	uint64_t	nSamp[2];
+	uint64_t	nDiv0;			///	number of zero divisors (result 0)
+};
+
+///	quantities of each chip (index of errStat_stru)
+enum { cd_Q_T, cd_Q_P64, cd_Q_P32, cd_Q_H, cd_Q_G, cd_Q_HT, cd_NQ };
+const char *gv_qName[cd_NQ] = { "T 0.01 C", "P 64 bit", "P 32 bit", "H", "G", "H table" };
+const double gv_qOver[cd_NQ] = { cd_OVER_T, cd_OVER_P, cd_OVER_P, cd_OVER_H, cd_OVER_G, cd_OVER_H };
+
+void gf_clear(errStat_stru &lp_s) {
+	memset(&lp_s, 0, sizeof(lp_s));
+}
+
+/*	@brief	Add error of one sample
+	@param	lp_inRange	reference value is in working range of sensor	*/
+void gf_add(errStat_stru &lp_s, uint8_t lp_q, bool lp_inRange, uint32_t lp_adc, double lp_got, double lp_ref) {
+	double lv_err = fabs(lp_got - lp_ref);
+	if (lp_q == cd_Q_G) lv_err = lp_ref == 0 ? 0 : 100 * lv_err / lp_ref;		//	%
+	if (lp_ref < 0) return;		//	negative P, H is not result of unsigned integer formulas
+	for (uint8_t r = lp_inRange ? 0 : 1; r < 2; r++) {
+		lp_s.nSamp[r]++;
+		if (lv_err > gv_qOver[lp_q]) {
+			if (lp_s.nOver[r]++ == 0) lp_s.overAdc[r] = lp_adc;
+			continue;
+		}
+		if (lv_err > lp_s.maxErr[r]) {
+			lp_s.maxErr[r] = lv_err;
+			lp_s.maxAdc[r] = lp_adc;
+		}
+	}
+}
+
+void gf_merge(errStat_stru &lp_s, const errStat_stru &lp_a) {
+	for (uint8_t r = 0; r < 2; r++) {
+		if (lp_a.maxErr[r] > lp_s.maxErr[r]) {
+			lp_s.maxErr[r] = lp_a.maxErr[r];
+			lp_s.maxAdc[r] = lp_a.maxAdc[r];
+		}
+		if (lp_s.nOver[r] == 0) lp_s.overAdc[r] = lp_a.overAdc[r];
+		lp_s.nOver[r] += lp_a.nOver[r];
+		lp_s.nSamp[r] += lp_a.nSamp[r];
+	}
+	lp_s.nDiv0 += lp_a.nDiv0;
+}
+
+bool gf_inRangeT(double lp_T) { return lp_T >= -40 && lp_T <= 85; }
+bool gf_inRangeP(double lp_P) { return lp_P >= 30000 && lp_P <= 110000; }
+bool gf_inRangeH(double lp_T, double lp_H) { return gf_inRangeT(lp_T) && lp_H > 0 && lp_H < 100; }	//	not limited
+
+///	integer humidity, %RH
+double gf_humi(const preBME280_stru &lp_pc, uint32_t adc_H, int32_t t_fine) { return gf_compH(lp_pc, adc_H, t_fine) / 1024.0; }
+double gf_humi(const preBME680_stru &lp_pc, uint32_t adc_H, int32_t temp_comp) { return gf_compH(lp_pc, adc_H, temp_comp) / 1000.0; }
+double gf_humiDbl(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc, uint32_t adc_T, uint32_t adc_H) {
+	return cl_compDouble::compTPH(lp_cd, lp_pc, adc_T, cd_ADC_SKIP, adc_H).humi1;
+}
+double gf_humiDbl(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc, uint32_t adc_T, uint32_t adc_H) {
+	return cl_compDouble::compTPHG(lp_cd, lp_pc, adc_T, cd_ADC_SKIP, adc_H, 0x8000, 0).humi1;
+}
+///	precompiled calibration data of calibration data
+template <class T_cd> struct T_pc;
+template <> struct T_pc<calibBME280_stru> { typedef preBME280_stru type; };
+template <> struct T_pc<calibBME680_stru> { typedef preBME680_stru type; };
+///	temperature of humidity formula: t_fine (BME280) or 0.01 C (BME680)
+int32_t gf_tempH(const preBME280_stru &lp_pc, int32_t lp_T, int32_t t_fine) { (void)lp_pc; (void)lp_T; return t_fine; }
+int32_t gf_tempH(const preBME680_stru &lp_pc, int32_t lp_T, int32_t t_fine) { (void)lp_pc; (void)t_fine; return lp_T; }
+
+///	adc_T of part k of sweeps, from 0 to 2^20 - 1
+uint32_t gf_adcT(uint8_t k) { return (uint32_t)(((uint64_t)k * 0xFFFFF) / (cd_NTEMP - 1)); }
+
+//================================================
+//		sweep of one part (calibration block, temperature k), called by worker threads
+//================================================
+///	H by table (lp_pcTab) against integer formula (lp_pc) at every 64th adc_T of part k, every 16th adc_H,
+///	working range is -40..85 C, 0..cd_HTAB_HMAX without overflow of integer formula (error against double formula)
+template <class T_cd, class T_pc>
+void gf_partHtab(const T_cd &lp_cd, const T_pc &lp_pc, const T_pc &lp_pcTab, uint8_t k, errStat_stru &lp_st) {
+	int32_t t_fine;
+	for (uint32_t adc_T = (k << 16); adc_T < ((uint32_t)(k + 1) << 16); adc_T += 64) {
+		int32_t lv_T = gf_compT(lp_pc, adc_T, t_fine);
+		int32_t lv_t = gf_tempH(lp_pc, lv_T, t_fine);
+		for (uint32_t adc = 0; adc < 0x10000; adc += 16) {
+			double lv_ref = gf_humi(lp_pc, adc, lv_t);
+			bool lv_in = gf_inRangeH(lv_T / 100.0, lv_ref) && lv_ref < cd_HTAB_HMAX
+				&& fabs(lv_ref - gf_humiDbl(lp_cd, lp_pc, adc_T, adc)) < cd_OVER_H;
+			gf_add(lp_st, cd_Q_HT, lv_in, adc, gf_humi(lp_pcTab, adc, lv_t), lv_ref);
+		}
+	}
+}
+
+void gf_part(const calibBME280_stru &lp_cd, bool lp_hum, uint8_t k, errStat_stru *lp_st) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	const calibBMP280_stru lv_cd = { lp_cd.T1, lp_cd.T2, lp_cd.T3, lp_cd.P1, lp_cd.P2, lp_cd.P3, lp_cd.P4, lp_cd.P5,
+		lp_cd.P6, lp_cd.P7, lp_cd.P8, lp_cd.P9 };
+	preBMP280_stru lv_pc1;
+	gf_precalc(lv_pc1, lv_cd);
+	int32_t t_fine;
+	//	T, part k of adc_T
+	for (uint32_t adc = (k << 16); adc < ((uint32_t)(k + 1) << 16); adc++) {
+		double lv_ref = cl_compDouble::compTP(lv_cd, lv_pc1, adc, cd_ADC_SKIP).temp1;
+		int32_t lv_T = lp_hum ? gf_compT(lv_pc, adc, t_fine) : gf_compT(lv_pc1, adc, t_fine);
+		gf_add(lp_st[cd_Q_T], cd_Q_T, gf_inRangeT(lv_ref), adc, lv_T / 100.0, lv_ref);
+	}
+	//	P at temperature k
+	uint32_t adc_T = gf_adcT(k);
+	for (uint32_t adc = 0; adc < 0x100000; adc++) {
+		tph_stru lv_ref, lv_p32;
+		uint32_t lv_p64;
+		if (lp_hum) {
+			lv_ref = cl_compDouble::compTPH(lp_cd, lv_pc, adc_T, adc, cd_ADC_SKIP_H);
+			lv_p32 = cl_compInt32::compTPH(lp_cd, lv_pc, adc_T, adc, cd_ADC_SKIP_H);
+			lv_p64 = gf_compTPH_fixed(lv_pc, adc_T, adc, cd_ADC_SKIP_H).pres1;
+		}
+		else {
+			tp_stru lv_r = cl_compDouble::compTP(lv_cd, lv_pc1, adc_T, adc);
+			tp_stru lv_r32 = cl_compInt32::compTP(lv_cd, lv_pc1, adc_T, adc);
+			lv_ref.temp1 = lv_r.temp1;	lv_ref.pres1 = lv_r.pres1;
+			lv_p32.pres1 = lv_r32.pres1;
+			lv_p64 = gf_compTP_fixed(lv_pc1, adc_T, adc).pres1;
+		}
+		bool lv_in = gf_inRangeT(lv_ref.temp1) && gf_inRangeP(lv_ref.pres1);
+		if (lv_ref.pres1 == 0) {	//	divisor of formula is 0
+			lp_st[cd_Q_P64].nDiv0 += lv_p64 == 0;
+			lp_st[cd_Q_P32].nDiv0 += lv_p32.pres1 == 0;
+		}
+		gf_add(lp_st[cd_Q_P64], cd_Q_P64, lv_in, adc, lv_p64 / 256.0, lv_ref.pres1);
+		gf_add(lp_st[cd_Q_P32], cd_Q_P32, lv_in, adc, lv_p32.pres1, lv_ref.pres1);
+	}
+	if (!lp_hum) return;
+	//	H at temperature k, integer %RH/1024
+	for (uint32_t adc = 0; adc < 0x10000; adc++) {
+		tph_stru lv_ref = cl_compDouble::compTPH(lp_cd, lv_pc, adc_T, cd_ADC_SKIP, adc);
+		gf_compT(lv_pc, adc_T, t_fine);
+		double lv_H = gf_compH(lv_pc, adc, t_fine) / 1024.0;
+		gf_add(lp_st[cd_Q_H], cd_Q_H, gf_inRangeH(lv_ref.temp1, lv_ref.humi1), adc, lv_H, lv_ref.humi1);
+	}
+	int32_t lv_val[cd_HTAB_NODE * cd_HNODE_280];
+	humTab_stru lv_ht = { lv_val, 0, cd_HTAB_NODE, 0, 0 };
+	preBME280_stru lv_pcTab = lv_pc;
+	gf_humTab(lv_ht, lv_pcTab);
+	gf_partHtab(lp_cd, lv_pc, lv_pcTab, k, lp_st[cd_Q_HT]);
+}
+
+void gf_part(const calibBME680_stru &lp_cd, bool lp_hum, uint8_t k, errStat_stru *lp_st) {
+	(void)lp_hum;
+	preBME680_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	int32_t t_fine;
+	for (uint32_t adc = (k << 16); adc < ((uint32_t)(k + 1) << 16); adc++) {
+		double lv_ref = cl_compDouble::compTPHG(lp_cd, lv_pc, adc, cd_ADC_SKIP, cd_ADC_SKIP_H, 0x8000, 0).temp1;
+		int32_t lv_T = gf_compT(lv_pc, adc, t_fine);
+		gf_add(lp_st[cd_Q_T], cd_Q_T, gf_inRangeT(lv_ref), adc, lv_T / 100.0, lv_ref);
+	}
+	uint32_t adc_T = gf_adcT(k);
+	gf_compT(lv_pc, adc_T, t_fine);
+	for (uint32_t adc = 0; adc < 0x100000; adc++) {
+		tphg_stru lv_ref = cl_compDouble::compTPHG(lp_cd, lv_pc, adc_T, adc, cd_ADC_SKIP_H, 0x8000, 0);
+		uint32_t lv_P = gf_compP(lv_pc, adc, t_fine);
+		bool lv_in = gf_inRangeT(lv_ref.temp1) && gf_inRangeP(lv_ref.pres1);
+		if (lv_ref.pres1 == 0) lp_st[cd_Q_P32].nDiv0 += lv_P == 0;
+		gf_add(lp_st[cd_Q_P32], cd_Q_P32, lv_in, adc, lv_P, lv_ref.pres1);
+	}
+	for (uint32_t adc = 0; adc < 0x10000; adc++) {
+		tphg_stru lv_ref = cl_compDouble::compTPHG(lp_cd, lv_pc, adc_T, cd_ADC_SKIP, adc, 0x8000, 0);
+		tphgFixed_stru lv_fix = gf_compTPHG_fixed(lv_pc, adc_T, cd_ADC_SKIP, adc, cd_ADC_SKIP_H, 0);
+		gf_add(lp_st[cd_Q_H], cd_Q_H, gf_inRangeH(lv_ref.temp1, lv_ref.humi1), adc, lv_fix.humi1 / 1000.0, lv_ref.humi1);
+	}
+	int32_t lv_val[cd_HTAB_NODE * cd_HNODE_680];
+	humTab_stru lv_ht = { lv_val, 0, cd_HTAB_NODE, 0, 0 };
+	preBME680_stru lv_pcTab = lv_pc;
+	gf_humTab(lv_ht, lv_pcTab);
+	gf_partHtab(lp_cd, lv_pc, lv_pcTab, k, lp_st[cd_Q_HT]);
+	//	G, gas range k
+	for (uint32_t adc = 0; adc < 0x400; adc++) {
+		tphg_stru lv_ref = cl_compDouble::compTPHG(lp_cd, lv_pc, adc_T, cd_ADC_SKIP, cd_ADC_SKIP_H, adc, k);
+		gf_add(lp_st[cd_Q_G], cd_Q_G, true, adc, gf_compG(lv_pc, adc, k) / 1000.0, lv_ref.gasr1);
+	}
+}
+
+//================================================
+//		work of threads: parts (chip, calibration block, k) are taken by atomic counter
+//================================================
+#define cd_NCHIP	3
+const uint8_t gv_chip[cd_NCHIP] = { cd_BMP280, cd_BME280, cd_BME680 };
+const char *gv_chipName[cd_NCHIP] = { "BMP280", "BME280", "BME680" };
+errStat_stru gv_stat[cd_NCHIP][cd_NCALIB][cd_NQ];
+std::mutex gv_mutex;
+std::atomic<uint32_t> gv_next(0);
+
+void gf_worker(void) {
+	const uint32_t lv_nPart = cd_NCHIP * cd_NCALIB * cd_NTEMP;
+	uint32_t lv_part;
+	while ((lv_part = gv_next++) < lv_nPart) {
+		uint8_t c = lv_part / (cd_NCALIB * cd_NTEMP), b = (lv_part / cd_NTEMP) % cd_NCALIB, k = lv_part % cd_NTEMP;
+		errStat_stru lv_st[cd_NQ];
+		for (uint8_t q = 0; q < cd_NQ; q++) gf_clear(lv_st[q]);
+		if (gv_chip[c] == cd_BME680) gf_part(gv_cd680[b], true, k, lv_st);
+		else gf_part(gv_cd280[b], gv_chip[c] == cd_BME280, k, lv_st);
+		std::lock_guard<std::mutex> lv_lock(gv_mutex);
+		for (uint8_t q = 0; q < cd_NQ; q++) gf_merge(gv_stat[c][b][q], lv_st[q]);
+	}
+}
+
+///	time of gf_compH() by table or formula, ns per sample (adc_H 0..65535 at 64 temperatures)
+template <class T_cd>
+double gf_nsHtab(const T_cd &lp_cd, bool lp_tab) {
+	typename T_pc<T_cd>::type lv_pc;
+	int32_t lv_val[cd_HTAB_NODE * cd_HNODE_680];
+	humTab_stru lv_ht = { lv_val, 0, lp_tab ? (uint8_t)cd_HTAB_NODE : (uint8_t)0, 0, 0 };
+	gf_precalc(lv_pc, lp_cd);
+	gf_humTab(lv_ht, lv_pc);
+	volatile uint32_t lv_sum = 0;
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	for (uint32_t adc_T = 0; adc_T < 0x100000; adc_T += 0x4000) {
+		int32_t t_fine;
+		int32_t lv_t = gf_tempH(lv_pc, gf_compT(lv_pc, adc_T, t_fine), t_fine);
+		uint32_t lv_s = 0;
+		for (uint32_t adc = 0; adc < 0x10000; adc++) lv_s += gf_compH(lv_pc, adc, lv_t);
+		lv_sum = lv_sum + lv_s;
+	}
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lv_t0).count() / (64.0 * 0x10000);
+}
+
+int main(int argc, char **argv) {
+	uint32_t lv_nThread = argc > 1 ? atoi(argv[1]) : std::thread::hardware_concurrency();
+	if (lv_nThread == 0) lv_nThread = 1;
+	for (uint8_t c = 0; c < cd_NCHIP; c++)
+		for (uint8_t b = 0; b < cd_NCALIB; b++)
+			for (uint8_t q = 0; q < cd_NQ; q++) gf_clear(gv_stat[c][b][q]);
+	std::chrono::steady_clock::time_point lv_t0 = std::chrono::steady_clock::now();
+	std::vector<std::thread> lv_threads;
+	for (uint32_t i = 0; i < lv_nThread; i++) lv_threads.push_back(std::thread(gf_worker));
+	for (uint32_t i = 0; i < lv_nThread; i++) lv_threads[i].join();
+	double lv_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - lv_t0).count();
+
+	uint64_t lv_nSamp = 0, lv_nOver = 0;
+	printf("chip   calib quantity  | max error in range (adc) | max error full range (adc) | overflows in range, "
+		"full (first adc) | zero divisor\n");
+	for (uint8_t c = 0; c < cd_NCHIP; c++)
+		for (uint8_t b = 0; b < cd_NCALIB; b++)
+			for (uint8_t q = 0; q < cd_NQ; q++) {
+				const errStat_stru &lv_s = gv_stat[c][b][q];
+				if (lv_s.nSamp[1] == 0) continue;
+				lv_nSamp += lv_s.nSamp[1];
+				lv_nOver += lv_s.nOver[1];
+				printf("%s %u     %-9s | %10.4f (%7u)       | %10.4f (%7u)         | %9llu, %9llu (%7u) | %llu\n",
+					gv_chipName[c], b, gv_qName[q], lv_s.maxErr[0], lv_s.maxAdc[0], lv_s.maxErr[1], lv_s.maxAdc[1],
+					(unsigned long long)lv_s.nOver[0], (unsigned long long)lv_s.nOver[1],
+					lv_s.nOver[0] ? lv_s.overAdc[0] : lv_s.overAdc[1], (unsigned long long)lv_s.nDiv0);
+			}
+	printf("samples = %llu, overflows = %llu, threads = %u, time = %.1f s (%.1f M samples/s)\n",
+		(unsigned long long)lv_nSamp, (unsigned long long)lv_nOver, lv_nThread, lv_sec, lv_nSamp / lv_sec / 1e6);
+
+	double lv_htMax = 0;
+	for (uint8_t c = 1; c < cd_NCHIP; c++)
+		for (uint8_t b = 0; b < cd_NCALIB; b++) lv_htMax = fmax(lv_htMax, gv_stat[c][b][cd_Q_HT].maxErr[0]);
+	printf("H table of %u nodes: ns per sample BME280 %.1f (formula %.1f), BME680 %.1f (formula %.1f)\n", cd_HTAB_NODE,
+		gf_nsHtab(gv_cd280[1], true), gf_nsHtab(gv_cd280[1], false),
+		gf_nsHtab(gv_cd680[0], true), gf_nsHtab(gv_cd680[0], false));
+	printf("H table max deviation from integer formula %.4f %%RH, bound %.4f %%RH: %s\n", lv_htMax, cd_HTAB_BOUND,
+		lv_htMax <= cd_HTAB_BOUND ? "OK" : "FAILED");
+	return lv_htMax <= cd_HTAB_BOUND ? 0 : 1;
+}
+
+//=================================================================================
@@ -0,0 +1,54 @@
+/**
+*	@brief		Helpers of host (Linux) tests of extras/: counters of checks, noise of synthetic series,
+*				registers of simulated BME280. Each test is one source file, so it defines them here.
+*/
+
+#ifndef test_util_h
+#define test_util_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+uint32_t gv_nCheck = 0, gv_nFail = 0;
+uint32_t gv_seed = 1;
+
+/*	count check, print lp_what if it fails	*/
+void gf_expect(bool lp_ok, const char *lp_what) {
+	gv_nCheck++;
+	if (lp_ok) return;
+	gv_nFail++;
+	printf("FAIL: %s\n", lp_what);
+}
+
+/*	print number of checks and fails
+	@return	exit code of test, 1 if any check fails	*/
+int gf_checks(void) {
+	printf("%u checks, %u failed: %s\n", (unsigned)gv_nCheck, (unsigned)gv_nFail, gv_nFail ? "FAILED" : "OK");
+	return gv_nFail ? 1 : 0;
+}
+
+/*	uniform noise -0.5..0.5	*/
+float gf_noise(void) {
+	gv_seed = gv_seed * 1103515245UL + 12345;
+	return (float)((gv_seed >> 8) & 0xFFFF) / 65536.0f - 0.5f;
+}
+
+/*	@brief	Calibration of Bosch datasheet BME280 and raw data 25.08 C, 100653 Pa to registers	*/
+void gf_simBME280(uint8_t *lp_regs) {
+	const int32_t lv_c[12] = { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 };
+	for (uint8_t i = 0; i < 12; i++) {
+		lp_regs[0x88 + 2 * i] = (uint8_t)lv_c[i];
+		lp_regs[0x89 + 2 * i] = (uint8_t)(lv_c[i] >> 8);
+	}
+	const uint8_t lv_h[8] = { 75, 0, 0x6A, 0x01, 0, 0x13, 0x29, 0x03 };	// H1 = 75 (0xA1), H2 = 362, H3 = 0, H4 = 313,
+	lp_regs[0xA1] = lv_h[0];											// H5 = 50, H6 = 30 (0xE1..0xE7)
+	for (uint8_t i = 0; i < 7; i++) lp_regs[0xE1 + i] = lv_h[1 + i];
+	lp_regs[0xE7] = 30;
+	const uint8_t lv_raw[8] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x75, 0x30 };	// adc_P 415148, adc_T 519888, adc_H 30000
+	memcpy(lp_regs + 0xF7, lv_raw, 8);
+}
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,46 @@
+/**
+*	@brief		Host (Linux) test of cl_WireBus: the library is built with -DARDUINO and minimal Arduino core of extras/shim,
+*				TwoWire of shim works on register maps of cl_SimBus. Sensor of default bus (global Wire) gives the same
+*				registers and results as sensor on cl_SimBus, absent address fails, Wire.begin() is called once.
+*	@remarks	g++ -std=c++11 -O2 -DARDUINO -I.. -Ishim wire_sim.cpp shim/shim.cpp ../mkigor_BMxx80.cpp ../mkigor_BMxx80_bus.cpp -o wire_sim
+*				exit code 1 if any check fails
+*/
+
+#include <mkigor_BMxx80.h>
+#include "test_util.h"
+
+typedef cl_BME280_T<cl_SimBus>	cl_Sim280;
+
+int main() {
+	cl_SimBus lv_sim;
+	uint8_t *lv_regs = lv_sim.addDevice(0x76, cd_BME280);
+	gf_simBME280(lv_regs);
+	Wire.attach(0x76, lv_regs);
+
+	//	reference: the same registers by cl_SimBus
+	cl_Sim280 lv_ref(lv_sim);
+	gf_expect(lv_ref.check(0x76) == cd_BME280 && lv_ref.begin(), "cl_SimBus: check(), begin()");
+	uint8_t lv_cfgRef[4];
+	memcpy(lv_cfgRef, lv_regs + 0xF2, 4);
+	tph_stru lv_r0 = lv_ref.readTPH();
+
+	memset(lv_regs + 0xF2, 0, 4);
+	cl_BME280 lv_s;						// default bus cl_WireBus::dflt() over global Wire
+	cl_BME280 lv_absent;
+	gf_expect(lv_s.check(0x76) == cd_BME280, "cl_WireBus: check() finds BME280");
+	gf_expect(lv_absent.check(0x77) == 0, "cl_WireBus: absent address 0x77, check() = 0");
+	gf_expect(Wire.nBegin() == 1, "cl_WireBus: Wire.begin() once for 2 sensors");
+	gf_expect(lv_s.begin(), "cl_WireBus: begin() reads calibration");
+	gf_expect(memcmp(lv_regs + 0xF2, lv_cfgRef, 4) == 0, "cl_WireBus: config regs are the same as by cl_SimBus");
+
+	tph_stru lv_r = lv_s.readTPH();
+	gf_expect(lv_r.valid == (cd_VAL_T | cd_VAL_P | cd_VAL_H) && lv_r.temp1 == lv_r0.temp1 && lv_r.pres1 == lv_r0.pres1
+		&& lv_r.humi1 == lv_r0.humi1, "cl_WireBus: readTPH() is the same as by cl_SimBus");
+	tph_stru lv_bad = lv_absent.readTPH();
+	gf_expect(lv_bad.valid == 0 && lv_bad.temp1 == 0, "cl_WireBus: absent sensor, readTPH() is not valid");
+	printf("cl_WireBus: T %.2f C, P %.0f Pa, H %.3f %%RH\n", lv_r.temp1, lv_r.pres1, lv_r.humi1);
+
+	return gf_checks();
+}
+
+//=================================================================================
@@ -22,466 +22,424 @@
 *	example:	- prefix_nameOfFuncOrVar_suffix, gv_tphg_stru => global var (tphg) structure.
 */
 
+
 #include <mkigor_BMxx80.h>
-#include <Arduino.h>
 
-// #define enDEBUG		//	if need addition print info, uncomment it string
+#ifndef ARDUINO
+#include <chrono>
+#endif
 
 //============================================
-//	BMP280, BME280, BME680
-//	cl_BMP280, cl_BME280, cl_BME680 common public metod (function)
+//	BMP280, BME280: the same T P part of calibration data and formulas, shared by both chips
 //============================================
-/*	@brief	Read 1 byte from register with address,
-	@param	address is address of register to read
-	@return	1 byteb read or 0 if operation not success	*/
-uint8_t cl_BMP280::readReg(uint8_t address) {
-	Wire.beginTransmission(clv_i2cAddr);
-	Wire.write(address);
-	if (Wire.endTransmission() != 0) return 0;
-	if (Wire.requestFrom(clv_i2cAddr, 1) == 1) return Wire.read();
-	else return 0;
-}
-
-/*	@brief	Write 1 byte to register with address,
-	@param	address is address of register to write
-	@param	data is byte to write	
-	@return	TRUE if operation is success, otherwise FALSE	*/
-bool cl_BMP280::writeReg(uint8_t address, uint8_t data) {
-	Wire.beginTransmission(clv_i2cAddr);
-	Wire.write(address);
-	Wire.write(data);
-	if (Wire.endTransmission() == 0) return true;
-	else return false;
-}
-
-/*	@brief	Check conection with sensor,
-	fn return chip codes: 0x58=BMP280, 0x60=BME280, 0x61=BME680.
-	i2c address 0x76, 0x77 possible for BMP280 or BME280 or BME680, note: CHECK IT ! 
-	@return	Chip_code is senor is present, if NO return 0	*/
-uint8_t cl_BMP280::check(uint8_t lv_i2caddr) {
-	clv_i2cAddr = lv_i2caddr;
-	Wire.begin();
-	uint8_t lv_error;
-    Wire.beginTransmission(clv_i2cAddr);
-    lv_error = Wire.endTransmission();
-    if (lv_error == 0) {
-        Wire.beginTransmission(clv_i2cAddr);
-        Wire.write(0xD0);   // Select register address = 0xD0 of chip_id
-        Wire.endTransmission();
-        Wire.requestFrom(clv_i2cAddr, 1);
-		if (Wire.available() == 1) {
-			clv_codeChip = Wire.read();
-			reset();
-			return clv_codeChip;
-		}
-    }
-    return 0;
+/*	@brief	Parse T P part of calibration data of BMx280 to structure lp_cd
+	@param	lp_regs88	24 registers read from address 0x88	*/
+template <class T_cd>
+static void gf_parseTP(T_cd &lp_cd, const uint8_t *lp_regs88) {
+	const uint8_t *lv_regs = lp_regs88;
+	lp_cd.T1 = lv_regs[1] << 8 | lv_regs[0];
+	lp_cd.T2 = lv_regs[3] << 8 | lv_regs[2];
+	lp_cd.T3 = lv_regs[5] << 8 | lv_regs[4];
+	lp_cd.P1 = lv_regs[7] << 8 | lv_regs[6];
+	lp_cd.P2 = lv_regs[9] << 8 | lv_regs[8];
+	lp_cd.P3 = lv_regs[11] << 8 | lv_regs[10];
+	lp_cd.P4 = lv_regs[13] << 8 | lv_regs[12];
+	lp_cd.P5 = lv_regs[15] << 8 | lv_regs[14];
+	lp_cd.P6 = lv_regs[17] << 8 | lv_regs[16];
+	lp_cd.P7 = lv_regs[19] << 8 | lv_regs[18];
+	lp_cd.P8 = lv_regs[21] << 8 | lv_regs[20];
+	lp_cd.P9 = lv_regs[23] << 8 | lv_regs[22];
 }
 
-/*	@brief	Software reset of bmp280, bme280, bme680. 
-	@return TRUE if write operation is OK	*/
-bool cl_BMP280::reset(void) {
-	if (cl_BMP280::writeReg(0x0E, 0xB6)) return true;
-    else return false;
+/*	@brief	Precompile T P part of calibration data: fold constant terms of formulas once (in begin()),
+	so per sample compensation is only adc_ dependent arithmetic	*/
+template <class T_pc, class T_cd>
+static void gf_precalcTP(T_pc &lp_pc, const T_cd &lp_cd) {
+	lp_pc.T1 = (int32_t)lp_cd.T1;
+	lp_pc.T1s1 = (int32_t)lp_cd.T1 * 2;
+	lp_pc.T2 = (int32_t)lp_cd.T2;
+	lp_pc.T3 = (int32_t)lp_cd.T3;
+	lp_pc.P1 = (int64_t)lp_cd.P1;
+	lp_pc.P2 = (int64_t)lp_cd.P2;
+	lp_pc.P3 = (int64_t)lp_cd.P3;
+	lp_pc.P4s35 = ((int64_t)lp_cd.P4) * 34359738368;
+	lp_pc.P5 = (int64_t)lp_cd.P5;
+	lp_pc.P6 = (int64_t)lp_cd.P6;
+	lp_pc.P7s4 = ((int64_t)lp_cd.P7) * 16;
+	lp_pc.P8 = (int64_t)lp_cd.P8;
+	lp_pc.P9 = (int64_t)lp_cd.P9;
 }
 
-/*	@brief	Send to sensor command Start Measuring (in FORCED mode)	*/
-void cl_BMP280::do1Meas(void) {
-	uint8_t lv_reg_0xF4 = cl_BMP280::readReg(0xF4);
-	cl_BMP280::writeReg(0xF4, ((lv_reg_0xF4 & 0xFC) | 0x01));
+/*	@brief	Divide by 2^lp_n: shift (floor) of BMP280 datasheet formulas, T_trunc = division (to zero) of Bosch BME280 API.
+	Results differ by 1 LSB for negative terms (below 0 C), so each chip keeps results of its reference formulas	*/
+template <bool T_trunc, class T>
+static inline T gf_sar(T lp_v, uint8_t lp_n) {
+	return T_trunc ? lp_v / ((T)1 << lp_n) : lp_v >> lp_n;
 }
 
-/*	@brief Test if sensor is Measuring 
-	@return TRUE while bmp280 is Measuring of FALSE when it is sleep	*/
-bool cl_BMP280::isMeas(void) {								
-	return (bool)((cl_BMP280::readReg(0xF3) & 0x08) >> 3);
+/*	@brief	Calc raw temperature adc_T to compensate value, kernel of BMP280 and BME280
+	@param	t_fine	returns fine temperature for calc of pressure and humidity
+	@return	temperature, 0.01 C (0 if the temperature module has been disabled)	*/
+template <bool T_trunc, class T_pc>
+static inline int32_t gf_kernT(const T_pc &lp_pc, int32_t adc_T, int32_t &t_fine) {
+	int32_t var1, var2;
+	var1 = gf_sar<T_trunc>((gf_sar<T_trunc>(adc_T, 3) - lp_pc.T1s1) * lp_pc.T2, 11);
+	var2 = gf_sar<T_trunc>(adc_T, 4) - lp_pc.T1;
+	var2 = gf_sar<T_trunc>(gf_sar<T_trunc>(var2 * var2, 12) * lp_pc.T3, 14);
+	var1 = var1 + var2;
+	// if the temperature module has been disabled return '0' (t_fine = 0 gives 0),
+	// select without branch, so loops of gf_compBatch are vectorized
+	var1 = (adc_T == cd_ADC_SKIP ? 0 : var1);
+	t_fine = var1;		// t_fine carries fine temperature as global value
+	return gf_sar<T_trunc>(var1 * 5 + 128, 8);
 }
 
-
+/*	@brief	Calc raw pressure adc_P to compensate value (64 bit integer formula), kernel of BMP280 and BME280
+	@return	pressure, Pa/256 (0 if the pressure module has been disabled)	*/
+template <bool T_trunc, class T_pc>
+static inline uint32_t gf_kernP(const T_pc &lp_pc, int32_t adc_P, int32_t t_fine) {
+	int64_t var1, var2, p;
+	if (adc_P == cd_ADC_SKIP) return 0;	// If the pressure module has been disabled return '0'
+	var1 = ((int64_t)t_fine) - 128000;
+	var2 = var1 * var1 * lp_pc.P6;
+	var2 = var2 + var1 * lp_pc.P5 * 131072;
+	var2 = var2 + lp_pc.P4s35;
+	var1 = gf_sar<T_trunc>(var1 * var1 * lp_pc.P3, 8) + var1 * lp_pc.P2 * 4096;
+	var1 = gf_sar<T_trunc>(((((int64_t)1) << 47) + var1) * lp_pc.P1, 33);
+	if (var1 == 0) return 0;     // avoid exception caused by division by zero
+	p = 1048576 - adc_P;
+	p = ((p * 2147483648) - var2) * 3125 / var1;
+	var1 = gf_sar<T_trunc>(lp_pc.P9 * gf_sar<T_trunc>(p, 13) * gf_sar<T_trunc>(p, 13), 25);
+	var2 = gf_sar<T_trunc>(lp_pc.P8 * p, 19);
+	p = gf_sar<T_trunc>(p + var1 + var2, 8) + lp_pc.P7s4;
+	return (uint32_t)p;
+}
 
 //============================================
 //	BMP280
-//	cl_BMP280, specific private metods (funcs)
+//	parse calibration data and compensation of raw data (bus independent)
 //============================================
-/*	@brief	Read Calibration Data for BMP280 in clv_cd var structure	*/
-void cl_BMP280::clf_readCalibData(void) {
-	uint8_t lv_nregs = 24;
-	uint8_t lv_regs[lv_nregs];		// temporary array for reading registers
-
-	Wire.beginTransmission(clv_i2cAddr);
-	Wire.write(0x88);
-	if (Wire.endTransmission() != 0) return;
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) {    // reading 24 regs
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
-		clv_cd.T1 = lv_regs[1] << 8 | lv_regs[0];
-		clv_cd.T2 = lv_regs[3] << 8 | lv_regs[2];
-		clv_cd.T3 = lv_regs[5] << 8 | lv_regs[4];
-		clv_cd.P1 = lv_regs[7] << 8 | lv_regs[6];
-		clv_cd.P2 = lv_regs[9] << 8 | lv_regs[8];
-		clv_cd.P3 = lv_regs[11] << 8 | lv_regs[10];
-		clv_cd.P4 = lv_regs[13] << 8 | lv_regs[12];
-		clv_cd.P5 = lv_regs[15] << 8 | lv_regs[14];
-		clv_cd.P6 = lv_regs[17] << 8 | lv_regs[16];
-		clv_cd.P7 = lv_regs[19] << 8 | lv_regs[18];
-		clv_cd.P8 = lv_regs[21] << 8 | lv_regs[20];
-		clv_cd.P9 = lv_regs[23] << 8 | lv_regs[22];
-	}
+/*	@brief	Parse Calibration Data for BMP280 to structure lp_cd
+	@param	lp_regs88	24 registers read from address 0x88	*/
+void gf_parseCalib(calibBMP280_stru &lp_cd, const uint8_t *lp_regs88) {
+	gf_parseTP(lp_cd, lp_regs88);
 }
 
-//============================================
-//	cl_BMP280, public metods (funcs)
-//============================================
-/*	@brief Read calibration data and Init sensor with default
-	force mode, filter value: cd_FIL_x2, stand by time 500ms, oversampling value T P : cd_OS_x16	*/
-void cl_BMP280::begin() {
-	begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x16, cd_OS_x16, cd_OS_x16);
-  }
-
-/*	@brief Read calibration data and Init sensor with
-	@param mode		cd_FOR_MODE or cd_NOR_MODE
-	@param t_sb		time standby in cd_NOR_MODE
-	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
-	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
-	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16	*/
-void cl_BMP280::begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p) {	// init bme280
-	cl_BMP280::clf_readCalibData();
-	uint8_t lv_reg_0xF4 = (osrs_t<<5) | (osrs_p<<2) | mode;
-	uint8_t lv_reg_0xF5 = (t_sb << 5) | (filter << 2) | 0x00;
-	cl_BMP280::writeReg(0xF4, lv_reg_0xF4);
-	cl_BMP280::writeReg(0xF5, lv_reg_0xF5);
-};    
-
-/*	@brief Read raw data (adc_ P T) & calc it to compensate value
-	@returns compensate value of T P in structure var		*/
-tp_stru cl_BMP280::readTP(void) {
-	tp_stru lv_tp = { 0, 0 };
-	int32_t  adc_T;
-	uint32_t adc_P;
-	uint8_t lv_nregs = 6;
-	uint8_t lv_regs[lv_nregs];
-
-	Wire.beginTransmission(clv_i2cAddr);   // addr of first byte raw data Humi
-	Wire.write(0xF7);
-	if (Wire.endTransmission() != 0) return lv_tp;	// something wrong with i2c connection and return 0
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) 
-		for (uint8_t i = 0; i < 6; i++) lv_regs[i] = Wire.read();
-	adc_T = ((lv_regs[3] << 16) | (lv_regs[4] << 8) | lv_regs[5]) >> 4;
-	adc_P = ((lv_regs[0] << 16) | (lv_regs[1] << 8) | lv_regs[2]) >> 4;
-
-	int32_t lv_var1, lv_var2, t_fine;
-	if (adc_T == 0x800000) {
-		lv_tp.temp1 = 0;	// if the temperature module has been disabled return '0'
-	}
-	else {
-		lv_var1 = ((((adc_T >> 3) - ((int32_t)clv_cd.T1 << 1))) * ((int32_t)clv_cd.T2)) >> 11;
-		lv_var2 = (((((adc_T >> 4) - ((int32_t)clv_cd.T1)) * ((adc_T >> 4) - ((int32_t)clv_cd.T1))) >> 12) * 
-			((int32_t)clv_cd.T3)) >> 14;
-		t_fine = lv_var1 + lv_var2;		// t_fine carries fine temperature as global value
-		lv_tp.temp1 = ((float)((t_fine * 5 + 128) >> 8)) / 100;
-	}
+/*	@brief	Precompile calibration data once (in begin())	*/
+void gf_precalc(preBMP280_stru &lp_pc, const calibBMP280_stru &lp_cd) {
+	gf_precalcTP(lp_pc, lp_cd);
+}
 
-	int64_t var1, var2, p;
-	if (adc_P == 0x800000) {
-		lv_tp.pres1 = 0;	// If the pressure module has been disabled return '0'
-	}
-	else {
-		var1 = ((int64_t)t_fine) - 128000;
-		var2 = var1 * var1 * (int64_t)clv_cd.P6;
-		var2 = var2 + ((var1 * (int64_t)clv_cd.P5) << 17);
-		var2 = var2 + (((int64_t)clv_cd.P4) << 35);
-		var1 = ((var1 * var1 * (int64_t)clv_cd.P3) >> 8) + ((var1 * (int64_t)clv_cd.P2) << 12);
-		var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)clv_cd.P1) >> 33;
-		if (var1 == 0) {
-			lv_tp.pres1 = 0;     // avoid exception caused by division by zero
-		}
-		else {
-			p = 1048576 - adc_P;
-			p = (((p << 31) - var2) * 3125) / var1;
-			var1 = (((int64_t)clv_cd.P9) * (p >> 13) * (p >> 13)) >> 25;
-			var2 = (((int64_t)clv_cd.P8) * p) >> 19;
-			p = ((p + var1 + var2) >> 8) + (((int64_t)clv_cd.P7) << 4);
-			lv_tp.pres1 = ((float)p) / 256;
-		}
-	}
+/*	@brief	Calc raw temperature adc_T to compensate value (shifts of BMP280 datasheet)
+	@param	t_fine	returns fine temperature for calc of pressure
+	@return	temperature, 0.01 C (0 if the temperature module has been disabled)	*/
+int32_t gf_compT(const preBMP280_stru &lp_pc, int32_t adc_T, int32_t &t_fine) {
+	return gf_kernT<false>(lp_pc, adc_T, t_fine);
+}
+
+/*	@brief	Calc raw pressure adc_P to compensate value (64 bit integer formula)
+	@return	pressure, Pa/256 (0 if the pressure module has been disabled)	*/
+uint32_t gf_compP(const preBMP280_stru &lp_pc, uint32_t adc_P, int32_t t_fine) {
+	return gf_kernP<false>(lp_pc, (int32_t)adc_P, t_fine);
+}
+
+//	the same by not precompiled calibration data, for single calls
+int32_t gf_compT(const calibBMP280_stru &lp_cd, int32_t adc_T, int32_t &t_fine) {
+	preBMP280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compT(lv_pc, adc_T, t_fine);
+}
+uint32_t gf_compP(const calibBMP280_stru &lp_cd, uint32_t adc_P, int32_t t_fine) {
+	preBMP280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compP(lv_pc, adc_P, t_fine);
+}
+
+/*	@brief Calc raw data (adc_ P T) to compensate value, integer only
+	@returns T 0.01 C, P Pa/256 in structure var, valid = cd_VAL_T | cd_VAL_P of measured values		*/
+tpFixed_stru gf_compTP_fixed(const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	tpFixed_stru lv_tp;
+	int32_t t_fine;
+	lv_tp.temp1 = gf_compT(lp_pc, adc_T, t_fine);
+	lv_tp.pres1 = gf_compP(lp_pc, adc_P, t_fine);
+	lv_tp.valid = gf_valid(adc_T, adc_P);
+	return lv_tp;
+}
 
+/*	@brief	The same as gf_compTP_fixed(), but float T C, P Pa	*/
+tp_stru gf_compTP(const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	tpFixed_stru lv_fix = gf_compTP_fixed(lp_pc, adc_T, adc_P);
+	tp_stru lv_tp;
+	lv_tp.temp1 = ((float)lv_fix.temp1) / 100;
+	lv_tp.pres1 = ((float)lv_fix.pres1) / 256;
+	lv_tp.valid = lv_fix.valid;
 	return lv_tp;
 }
 
+//	the same by not precompiled calibration data, for single calls
+tpFixed_stru gf_compTP_fixed(const calibBMP280_stru &lp_cd, int32_t adc_T, uint32_t adc_P) {
+	preBMP280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compTP_fixed(lv_pc, adc_T, adc_P);
+}
+tp_stru gf_compTP(const calibBMP280_stru &lp_cd, int32_t adc_T, uint32_t adc_P) {
+	preBMP280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compTP(lv_pc, adc_T, adc_P);
+}
+
 
 
 //============================================
-//	BME280,
-//	cl_BME280, specific private metods (funcs)
+//	Table of accelerated humidity BME280, BME680 (common part)
 //============================================
-/*	@brief	Read Calibration Data for BME280 in clv_cd var structure	*/
-void cl_BME280::clf_readCalibData(void) {
-	uint8_t lv_nregs = 26;
-	uint8_t lv_regs[lv_nregs];		// temporary array for reading registers
-
-	Wire.beginTransmission(clv_i2cAddr);   // first part request
-	Wire.write(0x88);
-	if (Wire.endTransmission() != 0) return;
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) {    // reading 26 regs
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
-		clv_cd.T1 = lv_regs[1] << 8 | lv_regs[0];   // form struct
-		clv_cd.T2 = lv_regs[3] << 8 | lv_regs[2];
-		clv_cd.T3 = lv_regs[5] << 8 | lv_regs[4];
-		clv_cd.P1 = lv_regs[7] << 8 | lv_regs[6];
-		clv_cd.P2 = lv_regs[9] << 8 | lv_regs[8];
-		clv_cd.P3 = lv_regs[11] << 8 | lv_regs[10];
-		clv_cd.P4 = lv_regs[13] << 8 | lv_regs[12];
-		clv_cd.P5 = lv_regs[15] << 8 | lv_regs[14];
-		clv_cd.P6 = lv_regs[17] << 8 | lv_regs[16];
-		clv_cd.P7 = lv_regs[19] << 8 | lv_regs[18];
-		clv_cd.P8 = lv_regs[21] << 8 | lv_regs[20];
-		clv_cd.P9 = lv_regs[23] << 8 | lv_regs[22];
-		clv_cd.H1 = lv_regs[25];
+/*	@brief	Nodes of table cover lp_tMin..lp_tMax (units of temperature of table) with step 1 << shift,
+	the last node is used only for curvature of the last step
+	@return	FALSE if there is no table (less than 3 nodes)	*/
+static bool gf_htabRange(humTab_stru &lp_ht, int32_t lp_tMin, int32_t lp_tMax) {
+	if (lp_ht.val == NULL || lp_ht.n < 3) {
+		lp_ht.n = 0;
+		return false;
 	}
+	lp_ht.t0 = lp_tMin;
+	lp_ht.shift = 0;
+	while (((int32_t)(lp_ht.n - 2) << lp_ht.shift) < lp_tMax - lp_tMin) lp_ht.shift++;
+	return true;
+}
 
-	lv_nregs = 7;
-	Wire.beginTransmission(clv_i2cAddr);   // second part request 7 regs
-	Wire.write(0xE1);
-	Wire.endTransmission();
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) {
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
-		clv_cd.H2 = lv_regs[1] << 8 | lv_regs[0];
-		clv_cd.H3 = lv_regs[2];
-		clv_cd.H4 = ( ( (int16_t)(int8_t)lv_regs[3] ) * 16) | (int16_t)(lv_regs[4] & 0x0F );
-		clv_cd.H5 = ( ( (int16_t)(int8_t)lv_regs[5] ) * 16) | (int16_t)(lv_regs[4]  >> 4  );
-		clv_cd.H6 = lv_regs[6];
-	};
-#ifdef enDEBUG
-	printf("\nCalibrated data BME280:\n", clv_cd.T1, clv_cd.T2, clv_cd.T3);
-	printf("T1-T3 = %d %d %d \n", clv_cd.T1, clv_cd.T2, clv_cd.T3);
-    printf("P1-p9 = %d %d %d %d %d %d %d %d %d \n", clv_cd.P1, clv_cd.P2, clv_cd.P3, clv_cd.P4, clv_cd.P5, clv_cd.P6, clv_cd.P7, clv_cd.P8, clv_cd.P9);
-    printf("H1-H6 = %d %d %d %d %d %d \n\n", clv_cd.H1, clv_cd.H2, clv_cd.H3, clv_cd.H4, clv_cd.H5, clv_cd.H6);
-#endif
+/*	@brief	Low bits of position between nodes, that are not used, so products of differences of nodes
+	and position fit 32 bit (by max difference of nodes)	*/
+static void gf_htabFrac(humTab_stru &lp_ht, uint8_t lp_nv) {
+	uint32_t lv_max = 0;
+	for (uint16_t i = lp_nv; i < (uint16_t)lp_ht.n * lp_nv; i++) {
+		int32_t lv_d = lp_ht.val[i] - lp_ht.val[i - lp_nv];
+		uint32_t lv_abs = lv_d < 0 ? (uint32_t)0 - (uint32_t)lv_d : (uint32_t)lv_d;
+		if (lv_abs > lv_max) lv_max = lv_abs;
+	}
+	uint8_t lv_bits = 0;
+	while (lv_bits < 32 && (lv_max >> lv_bits) != 0) lv_bits++;
+	lp_ht.fracSh = lv_bits + lp_ht.shift > 29 ? lv_bits + lp_ht.shift - 29 : 0;
+	if (lp_ht.shift - lp_ht.fracSh > 15) lp_ht.fracSh = lp_ht.shift - 15;
+}
+
+/*	@brief	Quadratic interpolation (Newton, nodes i, i + 1, i + 2) of lp_nv values of table at temperature lp_t,
+	without division, terms of formulas are polynomials of temperature up to 2nd degree, so it is near exact
+	@return	FALSE if there is no table or temperature is out of table (then formula is used)	*/
+static inline bool gf_htabVal(const humTab_stru *lp_ht, int32_t lp_t, int32_t *lp_val, uint8_t lp_nv) {
+	if (lp_ht == NULL) return false;
+	uint32_t lv_pos = (uint32_t)(lp_t - lp_ht->t0);
+	if (lv_pos >= ((uint32_t)(lp_ht->n - 2) << lp_ht->shift)) return false;
+	const int32_t *lv_node = lp_ht->val + (uint16_t)(lv_pos >> lp_ht->shift) * lp_nv;
+	uint8_t lv_sh = lp_ht->shift - lp_ht->fracSh;
+	int32_t lv_f = (int32_t)((lv_pos & ((UINT32_C(1) << lp_ht->shift) - 1)) >> lp_ht->fracSh);
+	int32_t lv_f2 = (lv_f * (lv_f - ((int32_t)1 << lv_sh))) >> (lv_sh + 1);	// f (f - 1) / 2, <= 0
+	int32_t lv_round = lv_sh ? (int32_t)1 << (lv_sh - 1) : 0;
+	for (uint8_t i = 0; i < lp_nv; i++) {
+		int32_t lv_d1 = lv_node[i + lp_nv] - lv_node[i];
+		int32_t lv_d2 = lv_node[i + 2 * lp_nv] - lv_node[i + lp_nv] - lv_d1;
+		lp_val[i] = lv_node[i] + ((lv_d1 * lv_f + lv_d2 * lv_f2 + lv_round) >> lv_sh);
+	}
+	return true;
 }
 
 //============================================
-//	cl_BME280, public metods (funcs)
+//	BME280,
+//	parse calibration data and compensation of raw data (bus independent)
 //============================================
-/*	@brief Read calibration data and Init sensor with default
-	force mode, filter value: cd_FIL_x2, stand by time 500ms, oversampling value T P H : cd_OS_x16	*/
-void cl_BME280::begin() {
-	begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x16, cd_OS_x16, cd_OS_x16, cd_OS_x16); // Forse mode, sleep 500ms, filter x16, t p h x16
-}
-
-/*	@brief Read calibration data and Init sensor with
-	@param mode		cd_FOR_MODE or cd_NOR_MODE
-	@param t_sb		time standby in cd_NOR_MODE
-	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
-	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
-	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16
-	@param osrs_h	oversampling value humidity: cd_OS_OFF..cd_OS_x16
-	@returns void	*/
-void cl_BME280::begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h) {	// init bme280
-	cl_BME280::clf_readCalibData();
-	cl_BME280::writeReg(0xF2, osrs_h);		//	write settings to config control registers 0xF2, 0xF4, 0xF5
-	cl_BME280::writeReg(0xF4, ((osrs_t<<5) | (osrs_p<<2) | mode) );
-	cl_BME280::writeReg(0xF5, ((t_sb << 5) | (filter << 2) | 0) );
-};    
-
-/*	@brief Read raw data (adc_ P T H) & calc it to compensate value
-	@returns compensate value of T P H in structure var		*/
-tph_stru cl_BME280::readTPH(void) {
-	tph_stru lv_tph = { 0, 0, 0 };
-	int32_t  adc_T, adc_H, adc_P, var1, var2, var3, var4, var5, t_fine;
-
-	uint8_t lv_nregs = 8;
-	uint8_t lv_regs[lv_nregs];		//	local temp array for store registers
-	Wire.beginTransmission(clv_i2cAddr);   // addr of first byte raw data (adc_ P T H)
-	Wire.write(0xF7);
-	if (Wire.endTransmission() != 0) return lv_tph;
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs)
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
-	adc_T = (((int32_t)lv_regs[3] << 16) | ((int32_t)lv_regs[4] << 8) | lv_regs[5]) >> 4;
-	adc_P = (((int32_t)lv_regs[0] << 16) | ((int32_t)lv_regs[1] << 8) | lv_regs[2]) >> 4;
-	adc_H = ((int32_t)lv_regs[6] << 8) | lv_regs[7];
-#ifdef enDEBUG
-	printf("adc_ T P H = %d %d %d \n", adc_T, adc_P, adc_H);
-#endif
+/*	@brief	Parse Calibration Data for BME280 to structure lp_cd
+	@param	lp_regs88	26 registers read from address 0x88
+	@param	lp_regsE1	7 registers read from address 0xE1	*/
+void gf_parseCalib(calibBME280_stru &lp_cd, const uint8_t *lp_regs88, const uint8_t *lp_regsE1) {
+	gf_parseTP(lp_cd, lp_regs88);		// T P part is the same as BMP280
+	lp_cd.H1 = lp_regs88[25];
 
-	//	Calc T
-	if (adc_T == 0x800000) lv_tph.temp1 = 0;	// if the temperature module has been disabled return '0'
-	else {
-		var1 = (int32_t)((adc_T / 8) - ((int32_t)clv_cd.T1 * 2));
-		var1 = (var1 * ((int32_t)clv_cd.T2)) / 2048;
-		var2 = (int32_t)((adc_T / 16) - ((int32_t)clv_cd.T1));
-		var2 = (((var2 * var2) / 4096) * ((int32_t)clv_cd.T3)) / 16384;
-		t_fine = var1 + var2;
-		lv_tph.temp1 = (float)((t_fine * 5 + 128) / 256) / 100.0;
-	}
+	const uint8_t *lv_regs = lp_regsE1;		// second part 7 regs
+	lp_cd.H2 = lv_regs[1] << 8 | lv_regs[0];
+	lp_cd.H3 = lv_regs[2];
+	lp_cd.H4 = ( ( (int16_t)(int8_t)lv_regs[3] ) * 16) | (int16_t)(lv_regs[4] & 0x0F );
+	lp_cd.H5 = ( ( (int16_t)(int8_t)lv_regs[5] ) * 16) | (int16_t)(lv_regs[4]  >> 4  );
+	lp_cd.H6 = lv_regs[6];
+}
 
-	//	Calc P
-	if (adc_P == 0x800000) lv_tph.pres1 = 0;	// If the pressure module has been disabled return '0'
-	else {
-		int64_t var1_i64, var2_i64, var3_i64, var4_i64;
-
-		var1_i64 = ((int64_t)t_fine) - 128000;
-		var2_i64 = var1_i64 * var1_i64 * (int64_t)clv_cd.P6;
-		var2_i64 = var2_i64 + ((var1_i64 * (int64_t)clv_cd.P5) * 131072);
-		var2_i64 = var2_i64 + (((int64_t)clv_cd.P4) * 34359738368);
-		var1_i64 = ((var1_i64 * var1_i64 * (int64_t)clv_cd.P3) / 256) +
-			((var1_i64 * ((int64_t)clv_cd.P2) * 4096));
-		// var3_i64 = ((int64_t)1) * 140737488355328;
-		var3_i64 = 140737488355328;
-		var1_i64 = (var3_i64 + var1_i64) * ((int64_t)clv_cd.P1) / 8589934592;
-
-		if (var1_i64 == 0) lv_tph.pres1 = 0;	// avoid exception caused by division by zero
-		else {
-			var4_i64 = 1048576 - adc_P;
-			var4_i64 = (((var4_i64 * 2147483648) - var2_i64) * 3125) / var1_i64;
-			var1_i64 = (((int64_t)clv_cd.P9) * (var4_i64 / 8192) * (var4_i64 / 8192)) /	33554432;
-			var2_i64 = (((int64_t)clv_cd.P8) * var4_i64) / 524288;
-			var4_i64 = ((var4_i64 + var1_i64 + var2_i64) / 256) + (((int64_t)clv_cd.P7) * 16);
-
-			lv_tph.pres1 = (float)var4_i64 / 256.0;
-		}
-	}
+/*	@brief	Precompile calibration data: fold constant terms of formulas once (in begin()),
+	so per sample compensation is only adc_ dependent arithmetic	*/
+void gf_precalc(preBME280_stru &lp_pc, const calibBME280_stru &lp_cd) {
+	gf_precalcTP(lp_pc, lp_cd);
+	lp_pc.H1 = (int32_t)lp_cd.H1;
+	lp_pc.H2 = (int32_t)lp_cd.H2;
+	lp_pc.H3 = (int32_t)lp_cd.H3;
+	lp_pc.H4s20 = ((int32_t)lp_cd.H4) * 1048576;
+	lp_pc.H5 = (int32_t)lp_cd.H5;
+	lp_pc.H6 = (int32_t)lp_cd.H6;
+	lp_pc.htab = NULL;
+}
 
-	//	Calc H
-	if (adc_H == 0x8000) lv_tph.humi1 = 0;	// If the humidity module has been disabled return '0'
-	else {
-		var1 = t_fine - ((int32_t)76800);
-		var2 = (int32_t)(adc_H * 16384);
-		var3 = (int32_t)(((int32_t)clv_cd.H4) * 1048576);
-		var4 = ((int32_t)clv_cd.H5) * var1;
-		var5 = (((var2 - var3) - var4) + (int32_t)16384) / 32768;
-		var2 = (var1 * ((int32_t)clv_cd.H6)) / 1024;
-		var3 = (var1 * ((int32_t)clv_cd.H3)) / 2048;
-		var4 = ((var2 * (var3 + (int32_t)32768)) / 1024) + (int32_t)2097152;
-		var2 = ((var4 * ((int32_t)clv_cd.H2)) + 8192) / 16384;
-		var3 = var5 * var2;
-		var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
-		var5 = var3 - ((var4 * ((int32_t)clv_cd.H1)) / 16);
-		var5 = (var5 < 0 ? 0 : var5);
-		var5 = (var5 > 419430400 ? 419430400 : var5);
-		lv_tph.humi1 = (float)(var5 / 4096) / 1024.0;
-	}
+/*	@brief	Calc raw temperature adc_T to compensate value (divisions of Bosch BME280 API)
+	@param	t_fine	returns fine temperature for calc of pressure and humidity
+	@return	temperature, 0.01 C (0 if the temperature module has been disabled)	*/
+int32_t gf_compT(const preBME280_stru &lp_pc, int32_t adc_T, int32_t &t_fine) {
+	return gf_kernT<true>(lp_pc, adc_T, t_fine);
+}
+
+/*	@brief	Calc raw pressure adc_P to compensate value (64 bit integer formula)
+	@return	pressure, Pa/256 (0 if the pressure module has been disabled)	*/
+uint32_t gf_compP(const preBME280_stru &lp_pc, int32_t adc_P, int32_t t_fine) {
+	return gf_kernP<true>(lp_pc, adc_P, t_fine);
+}
+
+/*	@brief	Gain of humidity formula, it depends only on temperature (value of node of table)	*/
+static inline int32_t gf_humGain(const preBME280_stru &lp_pc, int32_t t_fine) {
+	int32_t var1, var2, var3, var4;
+	var1 = t_fine - ((int32_t)76800);
+	var2 = (var1 * lp_pc.H6) / 1024;
+	var3 = (var1 * lp_pc.H3) / 2048;
+	var4 = ((var2 * (var3 + (int32_t)32768)) / 1024) + (int32_t)2097152;
+	return ((var4 * lp_pc.H2) + 8192) / 16384;
+}
 
+/*	@brief	Build table of accelerated humidity of lp_ht.n nodes (gain at t_fine of -40..85 C) in lp_ht.val
+	and attach it to precompiled calibration data	*/
+void gf_humTab(humTab_stru &lp_ht, preBME280_stru &lp_pc) {
+	lp_pc.htab = NULL;
+	if (!gf_htabRange(lp_ht, (int32_t)-40 * 5120, (int32_t)85 * 5120)) return;
+	for (uint8_t i = 0; i < lp_ht.n; i++) lp_ht.val[i] = gf_humGain(lp_pc, lp_ht.t0 + ((int32_t)i << lp_ht.shift));
+	gf_htabFrac(lp_ht, cd_HNODE_280);
+	lp_pc.htab = &lp_ht;
+}
+
+/*	@brief	Humidity formula with gain lp_gain, without branches (kernel of gf_compH and of loop of gf_compBatch)
+	@return	humidity, %RH/1024 (0 if the humidity module has been disabled)	*/
+static inline uint32_t gf_kernH(const preBME280_stru &lp_pc, int32_t adc_H, int32_t t_fine, int32_t lp_gain) {
+	int32_t var1, var2, var3, var4, var5;
+	var1 = t_fine - ((int32_t)76800);
+	var2 = (int32_t)(adc_H * 16384);
+	var3 = lp_pc.H4s20;
+	var4 = lp_pc.H5 * var1;
+	var5 = (((var2 - var3) - var4) + (int32_t)16384) / 32768;
+	var3 = var5 * lp_gain;
+	var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
+	var5 = var3 - ((var4 * lp_pc.H1) / 16);
+	var5 = (var5 < 0 ? 0 : var5);
+	var5 = (var5 > 419430400 ? 419430400 : var5);
+	var5 = (adc_H == cd_ADC_SKIP_H ? 0 : var5);	// If the humidity module has been disabled return '0'
+	return (uint32_t)(var5 / 4096);
+}
+
+/*	@brief	Calc raw humidity adc_H to compensate value, gain is interpolated by table if it is attached
+	@return	humidity, %RH/1024 (0 if the humidity module has been disabled)	*/
+uint32_t gf_compH(const preBME280_stru &lp_pc, int32_t adc_H, int32_t t_fine) {
+	int32_t lv_gain;
+	if (!gf_htabVal(lp_pc.htab, t_fine, &lv_gain, cd_HNODE_280)) lv_gain = gf_humGain(lp_pc, t_fine);
+	return gf_kernH(lp_pc, adc_H, t_fine, lv_gain);
+}
+
+//	the same by not precompiled calibration data, for single calls
+int32_t gf_compT(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t &t_fine) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compT(lv_pc, adc_T, t_fine);
+}
+uint32_t gf_compP(const calibBME280_stru &lp_cd, int32_t adc_P, int32_t t_fine) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compP(lv_pc, adc_P, t_fine);
+}
+uint32_t gf_compH(const calibBME280_stru &lp_cd, int32_t adc_H, int32_t t_fine) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compH(lv_pc, adc_H, t_fine);
+}
+
+/*	@brief	Calc raw data (adc_ P T H) to compensate value, integer only
+	@returns T 0.01 C, P Pa/256, H 0.001 %RH in structure var, valid = cd_VAL_T | cd_VAL_P | cd_VAL_H of measured values	*/
+tphFixed_stru gf_compTPH_fixed(const preBME280_stru &lp_pc, int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	tphFixed_stru lv_tph;
+	int32_t t_fine;
+	lv_tph.temp1 = gf_compT(lp_pc, adc_T, t_fine);
+	lv_tph.pres1 = gf_compP(lp_pc, adc_P, t_fine);
+	lv_tph.humi1 = (gf_compH(lp_pc, adc_H, t_fine) * 125) >> 7;	//	%RH/1024 * 1000/1024 => 0.001 %RH
+	lv_tph.valid = gf_valid(adc_T, adc_P, adc_H);
 	return lv_tph;
 }
 
+/*	@brief	The same as gf_compTPH_fixed(), but float T C, P Pa, H %RH,
+	humidity is calculated from %RH/1024 of gf_compH(), it is more exact than 0.001 %RH	*/
+tph_stru gf_compTPH(const preBME280_stru &lp_pc, int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	tph_stru lv_tph;
+	int32_t t_fine;
+	lv_tph.temp1 = (float)gf_compT(lp_pc, adc_T, t_fine) / 100.0;
+	lv_tph.pres1 = (float)gf_compP(lp_pc, adc_P, t_fine) / 256.0;
+	lv_tph.humi1 = (float)gf_compH(lp_pc, adc_H, t_fine) / 1024.0;
+	lv_tph.valid = gf_valid(adc_T, adc_P, adc_H);
+	return lv_tph;
+}
+
+//	the same by not precompiled calibration data, for single calls
+tphFixed_stru gf_compTPH_fixed(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compTPH_fixed(lv_pc, adc_T, adc_P, adc_H);
+}
+tph_stru gf_compTPH(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	preBME280_stru lv_pc;
+	gf_precalc(lv_pc, lp_cd);
+	return gf_compTPH(lv_pc, adc_T, adc_P, adc_H);
+}
+
 
 
 //============================================
 //	BME680, Bosch Document rev.: 1.9, Date: February 2024, Document N: BST-BME680-DS001-09
-//	cl_BME680, private metods (funcs)
+//	parse calibration data and compensation of raw data (bus independent)
 //============================================
-/*	@brief Read Calibration Data to structure variable clv_cd */
-void cl_BME680::clf_readCalibData(void) {
-	uint8_t lv_nregs = 23;
-	uint8_t lv_regs[lv_nregs];		// temporary array for reading registers
-	Wire.beginTransmission(clv_i2cAddr);	// first part request
-	Wire.write(0x8A);						// Address of start calib. data (coeff.)
-	if (Wire.endTransmission() != 0) return;
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) {    // reading 23 regs from addr 0x8A
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
+/*	@brief	Parse Calibration Data for BME680 to structure lp_cd
+	@param	lp_regs8A	23 registers read from address 0x8A
+	@param	lp_regsE1	14 registers read from address 0xE1
+	@param	lp_regs00	5 registers read from address 0x00	*/
+void gf_parseCalib(calibBME680_stru &lp_cd, const uint8_t *lp_regs8A, const uint8_t *lp_regsE1,
+		const uint8_t *lp_regs00) {
+	const uint8_t *lv_regs = lp_regs8A;
 // T1 0xE9/0xEA, T2 0x8A/0x8B, T3 0x8C
 // P1 0x8E/0x8F, P2	0x90/0x91, P3 0x92, P4 0x94/0x95, P5 0x96/0x97, P6 0x99, P7 0x98, P8 0x9C/0x9D, P9	0x9E/0x9F, P10	0xA0
-		clv_cd.T2 = lv_regs[1] << 8 | lv_regs[0];	// fill struct
-		clv_cd.T3 = lv_regs[2];
-		clv_cd.P1 = lv_regs[5] << 8 | lv_regs[4];
-		clv_cd.P2 = lv_regs[7] << 8 | lv_regs[6];
-		clv_cd.P3 = lv_regs[8];
-		clv_cd.P4 = lv_regs[11] << 8 | lv_regs[10];
-		clv_cd.P5 = lv_regs[13] << 8 | lv_regs[12];
-		clv_cd.P6 = lv_regs[15];
-		clv_cd.P7 = lv_regs[14];
-		clv_cd.P8 = lv_regs[19] << 8 | lv_regs[18];
-		clv_cd.P9 = lv_regs[21] << 8 | lv_regs[20];
-		clv_cd.P10 = lv_regs[22];
-	}
+	lp_cd.T2 = lv_regs[1] << 8 | lv_regs[0];	// fill struct
+	lp_cd.T3 = lv_regs[2];
+	lp_cd.P1 = lv_regs[5] << 8 | lv_regs[4];
+	lp_cd.P2 = lv_regs[7] << 8 | lv_regs[6];
+	lp_cd.P3 = lv_regs[8];
+	lp_cd.P4 = lv_regs[11] << 8 | lv_regs[10];
+	lp_cd.P5 = lv_regs[13] << 8 | lv_regs[12];
+	lp_cd.P6 = lv_regs[15];
+	lp_cd.P7 = lv_regs[14];
+	lp_cd.P8 = lv_regs[19] << 8 | lv_regs[18];
+	lp_cd.P9 = lv_regs[21] << 8 | lv_regs[20];
+	lp_cd.P10 = lv_regs[22];
 
-	lv_nregs = 14;
-	Wire.beginTransmission(clv_i2cAddr);	// second part request 14 regs
-	Wire.write(0xE1);						// Address of 2d part calibr data
-	Wire.endTransmission();
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs) {   // reading
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
+	lv_regs = lp_regsE1;		// second part 14 regs
 // H1 0xE2<3:0>/0xE3, H2 0xE2<7:4>/0xE1, H3 0xE4, H4 0xE5, H5 0xE6, H6 0xE7, H7 0xE8
-		clv_cd.H2 = ((uint16_t)lv_regs[0] << 4) | (lv_regs[1] >> 4);
-		clv_cd.H1 = ((uint16_t)lv_regs[2] << 4) | (lv_regs[1] & 0x0F);
-		clv_cd.H3 = lv_regs[3];
-		clv_cd.H4 = lv_regs[4];
-		clv_cd.H5 = lv_regs[5];
-		clv_cd.H6 = lv_regs[6];
-		clv_cd.H7 = lv_regs[7];
-		clv_cd.T1 = lv_regs[9] << 8 | lv_regs[8];
-// G1 0xED, G2 0xEB/0xEC, G3 0xEE, res_heat_range 0x02 <5:4>, res_heat_val 0x00
-		clv_cd.G2 = lv_regs[11] << 8 | lv_regs[10];
-		clv_cd.G1 = lv_regs[12];
-		clv_cd.G3 = lv_regs[13];
-	};
-#ifdef enDEBUG
-	printf("\nCalibrated data BME680:\n", clv_cd.T1, clv_cd.T2, clv_cd.T3);
-	printf("T1-T3  = %d %d %d \n", clv_cd.T1, clv_cd.T2, clv_cd.T3);
-    printf("P1-p10 = %d %d %d %d %d %d %d %d %d %d \n", clv_cd.P1, clv_cd.P2, clv_cd.P3, clv_cd.P4, clv_cd.P5, clv_cd.P6, clv_cd.P7, clv_cd.P8, clv_cd.P9, clv_cd.P10);
-    printf("H1-H7  = %d %d %d %d %d %d %d \n", clv_cd.H1, clv_cd.H2, clv_cd.H3, clv_cd.H4, clv_cd.H5, clv_cd.H6, clv_cd.H7);
-    printf("G1-G3  = %d %d %d \n\n", clv_cd.G1, clv_cd.G2, clv_cd.G3);
-#endif
-}
+	lp_cd.H2 = ((uint16_t)lv_regs[0] << 4) | (lv_regs[1] >> 4);
+	lp_cd.H1 = ((uint16_t)lv_regs[2] << 4) | (lv_regs[1] & 0x0F);
+	lp_cd.H3 = lv_regs[3];
+	lp_cd.H4 = lv_regs[4];
+	lp_cd.H5 = lv_regs[5];
+	lp_cd.H6 = lv_regs[6];
+	lp_cd.H7 = lv_regs[7];
+	lp_cd.T1 = lv_regs[9] << 8 | lv_regs[8];
+// G1 0xED, G2 0xEB/0xEC, G3 0xEE
+	lp_cd.G2 = lv_regs[11] << 8 | lv_regs[10];
+	lp_cd.G1 = lv_regs[12];
+	lp_cd.G3 = lv_regs[13];
 
-//============================================
-//  cl_BME680, public metods (funcs)
-//============================================
-/*	@brief Send sensor command to Start Measuring 	*/
-void cl_BME680::do1Meas(void) {    // mode FORCED_MODE DO 1 Measuring
-	cl_BME680::writeReg(0x74, cl_BME680::readReg(0x74) | 0x01);
-}
-
-/*	@brief Test if sensor is Measuring 
-	@return TRUE while bme680 is Measuring of FALSE when it is sleep	*/
-bool cl_BME680::isMeas(void) {
-	// Status reg 0x1D, check the bit <6> gas measuring = 1 and the bit <5> data measuring = 1
-	return (bool)((cl_BME680::readReg(0x1D) & 0x60));
-}
-
-/*	@brief Read calibration data and Init sensor with default
-	filter value: cd_FIL_x2 and oversampling value T P H : cd_OS_x16	*/
-void cl_BME680::begin() {
-	cl_BME680::begin(cd_FIL_x2, cd_OS_x16, cd_OS_x16, cd_OS_x16); // default: filter x2, oversampling TPH x16
-}
-
-/*	@brief Read calibration data and Init sensor with
-	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
-	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
-	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16
-	@param osrs_h	oversampling value humidity: cd_OS_OFF..cd_OS_x16
-	@returns void	*/
-void cl_BME680::begin(uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h) {
-	cl_BME680::clf_readCalibData();	// Read calibration coefficients (data) to clas private (local) variable clv_cd
-/*	Select mode, oversampling and filtering = Step 1, 2, 3. (3.2.2 Sensor configuration flow, p.16)
-osrs_h bit <2:0> regs 0x72, osrs_t bit <7:5> regs 0x74, osrs_p bit <4:2> regs 0x72, mode bit <1:0>
-Filtering value (cd_FIL_x..) to Config register address 0x75 bits <4:2>		*/
-	cl_BME680::writeReg(0x72, osrs_h);
-	cl_BME680::writeReg(0x74, ((osrs_t<<5) | (osrs_p<<2) | 0) );
-	cl_BME680::writeReg(0x75, filter << 2);
-};    
-
-/*	@brief Set heating point 0..9 with
-	@param lp_setPoint	number of setpoint 0..9
-	@param lp_tagTemp	target temperature of heating, C 
-	@param lp_duration	time of heating, msec
-	@param lp_ambTemp	ambient temperature of sensor, C	*/
-void cl_BME680::initGasPointX(uint8_t lp_setPoint, uint16_t lp_tagTemp, uint16_t lp_duration, int16_t lp_ambTemp) {
-	//  Up to 10 different hot plate temperature set points can be configured 
-	//	by setting the registers res_heat_X and gas_wait_X, where X = 0…9.
-	//	The internal heater control loop operates on the resistance of the heater structure.
-	//  Hence, the user first needs to convert the target temperature 
-	//	into a device specific target resistance (res_heat_X))
-	//  before writing the resulting register code into the sensor memory map.
-
-	//	Res_heat_X	5Ah-63h,
-	//  Gas_wait_X	64h-6Dh.
-	//  Idac_heat_X	50h-59h will calc by BME680 itself
-
-	//	Step 4 - Enable GAS conversion. run_gas =1 (set bit <4> address reg 0x71) and 
-	//	Step 5 - Select index of heater set-point 0-9. nb_conv = 0 (bits <3:0> address reg 0x71)
-	if (lp_setPoint > 9) lp_setPoint = 9;
-	cl_BME680::writeReg(0x71, (0x10 | lp_setPoint) );
+	lv_regs = lp_regs00;		// factory constants, they are not changed, so read them once
+// res_heat_val 0x00, res_heat_range 0x02 <5:4>, range_switching_error 0x04 <7:4> (signed)
+	lp_cd.res_heat_val = lv_regs[0];
+	lp_cd.res_heat_range = (lv_regs[2] >> 4) & 0x03;
+	lp_cd.range_sw_err = ((int8_t)(lv_regs[4] & 0xF0)) / 16;
+}
 
+/*	@brief	Code of register gas_wait_X for time of heating
+	@param	lp_duration	time of heating, msec
+	@return	bit <5:0> ms and bit <7:6> is multiplier	*/
+uint8_t gf_gasWait(uint16_t lp_duration) {
 	//	Step 6 - Define heater duration Temp in ms, reg gas_wait_X, where X = 0…9. 
 	//	registers address 0x64-0x6D, bit <5:0> ms and bit <7:6> is multiplier
 	if (lp_duration >= 0x0FC0) {
@@ -495,9 +453,18 @@ void cl_BME680::initGasPointX(uint8_t lp_setPoint, uint16_t lp_tagTemp, uint16_t
 		}
 		lp_duration = lp_duration | (lv_mult << 6);
 	}
-	cl_BME680::writeReg(0x64 + lp_setPoint, (uint8_t)lp_duration);
+	return (uint8_t)lp_duration;
+}
 
-	//	Set heater Temp = Step 7.
+/*	@brief	Code of register res_heat_X for target temperature of heating
+	@param	lp_tagTemp		target temperature of heating, C 
+	@param	lp_ambTemp		ambient temperature of sensor, C
+	@return	value for registers 0x5A-0x63	*/
+uint8_t gf_resHeat(const calibBME680_stru &lp_cd, uint16_t lp_tagTemp, int16_t lp_ambTemp) {
+	//  The internal heater control loop operates on the resistance of the heater structure.
+	//  Hence, the user first needs to convert the target temperature 
+	//	into a device specific target resistance (res_heat_X))
+	//  before writing the resulting register code into the sensor memory map.
 	//	Convert temperature to register cspecific val. Set res_heat_X (reg 0x5A-0x63)
 	// G1, G2, G3	- calibration parameters,
 	// targTemp 	- the target heater temperature in degree Celsius,
@@ -507,138 +474,714 @@ void cl_BME680::initGasPointX(uint8_t lp_setPoint, uint16_t lp_tagTemp, uint16_t
 	//	where 'X' corresponds to the temperature profilenumber between 0 and 9 stored in regs 0x5A-0x63
 	// res_heat_range 	- the heater range stored in register address 0x02 <5:4>, and
 	// res_heat_val - the heater resistance correction factor stored in register address 0x00, signed, value from -128 to 127
-	int32_t var1 = (((int32_t)lp_ambTemp * clv_cd.G3) / 10) << 8;
-	int32_t var2 = (clv_cd.G1 + 784) * (((((clv_cd.G2 + 154009) * lp_tagTemp * 5) / 100) + 3276800) / 10);
+	int32_t var1 = (((int32_t)lp_ambTemp * lp_cd.G3) / 10) << 8;
+	int32_t var2 = (lp_cd.G1 + 784) * (((((lp_cd.G2 + 154009) * lp_tagTemp * 5) / 100) + 3276800) / 10);
 	int32_t var3 = var1 + (var2 >> 1);
-	int8_t  res_heat_val   = cl_BME680::readReg(0x00);
-	uint8_t res_heat_range = (cl_BME680::readReg(0x02) >> 4) & 0x03;
-	int32_t var4 = (var3 / (res_heat_range + 4));
-	int32_t var5 = (131 * res_heat_val) + 65536;
+	int32_t var4 = (var3 / (lp_cd.res_heat_range + 4));
+	int32_t var5 = (131 * lp_cd.res_heat_val) + 65536;
 	int32_t res_heat_x100 = (int32_t)(((var4 / var5) - 250) * 34);
-	uint8_t res_heat_X = (uint8_t)((res_heat_x100 + 50) / 100);
-	cl_BME680::writeReg(0x5A + lp_setPoint, res_heat_X);
-}
-
-/*	@brief Read raw data (adc_ P T H G) & calc it to compensate value
-	@returns structure T P H G	*/
-tphg_stru cl_BME680::readTPHG(void) {
-	tphg_stru lv_tphg = { 0, 0, 0, 0 };
-	uint32_t  adc_T, adc_P, adc_H, adc_G;
-	int32_t lv_var1, lv_var2, lv_var3, t_fine, temp_comp;
-
-	// read raw data (adc_ P T H G) from addr 0x1F to 0x1B at once I2C request
-	uint8_t lv_nregs = 13;
-	uint8_t lv_regs[lv_nregs];		//	temp array
-	Wire.beginTransmission(clv_i2cAddr);
-	Wire.write(0x1F);
-	if (Wire.endTransmission() != 0) return lv_tphg;
-	if (Wire.requestFrom(clv_i2cAddr, lv_nregs) == lv_nregs)
-		for (uint8_t i = 0; i < lv_nregs; i++) lv_regs[i] = Wire.read();
-	adc_P = (uint32_t)0 | (lv_regs[0] << 12) | (lv_regs[1] << 4) | (lv_regs[2] >> 4);
-	adc_T = (uint32_t)0 | (lv_regs[3] << 12) | (lv_regs[4] << 4) | (lv_regs[5] >> 4);
-	adc_H = (uint32_t)0 | (lv_regs[6] << 8) | lv_regs[7];
-	adc_G = (uint32_t)0 | ((uint32_t)lv_regs[11] << 2) | (uint32_t)(lv_regs[12] >> 6);
-	uint8_t gas_range = lv_regs[12] & 0x0F;
-	uint8_t range_switching_error = ( (int8_t)(cl_BME680::readReg(0x04) & 0xF0) / 16 );
-#ifdef enDEBUG
-	uint8_t lv_status = cl_BME680::readReg(0x1D);
-	if (lv_status & 0b10000000) Serial.println("new_data_0 = 1, moment when new measuring data have been arrive.");
-	if (lv_status & 0b01000000) Serial.println("gas_measuring = 1, moment gas data is measuring.");
-	if (lv_status & 0b00100000) Serial.println("measuring = 1, moment raw data is measuring.");
-	if (!(lv_regs[12] & 0b00100000)) Serial.println("Gas Not Valid bit<5> = 0 !!!");	// Test for Ok gas measuring
-	if (!(lv_regs[12] & 0b00010000)) Serial.println("Heat Not Stable bit<4> = 0 !!!");	// Test for Ok gas preheating
-	printf("adc_ T P H G =  %d %d %d %d \n", adc_T, adc_P, adc_H, adc_G);
-#endif
+	return (uint8_t)((res_heat_x100 + 50) / 100);
+}
 
-	// Calc T, where par_t1, par_t2 and par_t3 are calibration parameters,
-	// adc_T - the raw temperature data, t_fine - temperature that will use in future calc
-	if (adc_T == 0x800000) lv_tphg.temp1 = 0;	// if the temperature module has been disabled return '0'
-	else {
-		lv_var1 = ((int32_t)adc_T >> 3) - ((int32_t)clv_cd.T1 << 1);
-		lv_var2 = (lv_var1 * (int32_t)clv_cd.T2) >> 11;
-		lv_var3 = ((((lv_var1 >> 1) * (lv_var1 >> 1)) >> 12) * ((int32_t)clv_cd.T3 << 4)) >> 14;
-		t_fine = lv_var2 + lv_var3;
-		lv_tphg.temp1 = ((float)(((t_fine * 5) + 128) >> 8)) / 100;
+/*	@brief	Calc raw temperature adc_T to compensate value,
+	where par_t1, par_t2 and par_t3 are calibration parameters
+	@param	t_fine	returns fine temperature for calc of pressure
+	@return	temperature, 0.01 C (0 if the temperature module has been disabled)	*/
+int32_t gf_compT(const preBME680_stru &lp_pc, uint32_t adc_T, int32_t &t_fine) {
+	int32_t lv_var1, lv_var2, lv_var3;
+	lv_var1 = ((int32_t)adc_T >> 3) - lp_pc.T1s1;
+	lv_var2 = (lv_var1 * lp_pc.T2) >> 11;
+	lv_var3 = ((((lv_var1 >> 1) * (lv_var1 >> 1)) >> 12) * lp_pc.T3s4) >> 14;
+	lv_var1 = lv_var2 + lv_var3;
+	lv_var1 = (adc_T == cd_ADC_SKIP ? 0 : lv_var1);	// if the temperature module has been disabled return '0'
+	t_fine = lv_var1;
+	return ((lv_var1 * 5) + 128) >> 8;
+}
+
+/*	@brief	Calc raw pressure adc_P to compensate value (32 bit integer formula),
+	where par_p1, par_p2, …, par_p10 are calibration parameters
+	@return	pressure, Pa (0 if the pressure module has been disabled)	*/
+uint32_t gf_compP(const preBME680_stru &lp_pc, uint32_t adc_P, int32_t t_fine) {
+	int32_t lv_var1, lv_var2, lv_var3;
+	uint32_t press_comp, lv_cube;
+	if (adc_P == cd_ADC_SKIP) return 0;	// If the pressure module has been disabled return '0'
+	lv_var1 = ((int32_t)t_fine >> 1) - 64000;
+	lv_var2 = ((((lv_var1 >> 2) * (lv_var1 >> 2)) >> 11) * lp_pc.P6) >> 2;
+	lv_var2 = lv_var2 + ((lv_var1 * lp_pc.P5) << 1);
+	lv_var2 = (lv_var2 >> 2) + lp_pc.P4s16;
+	lv_var1 = (((((lv_var1 >> 2) * (lv_var1 >> 2)) >> 13) * lp_pc.P3s5) >> 3) + ((lp_pc.P2 * lv_var1) >> 1);
+	lv_var1 = lv_var1 >> 18;
+	lv_var1 = ((32768 + lv_var1) * lp_pc.P1) >> 15;
+	if (lv_var1 == 0) return 0;	// avoid exception caused by division by zero
+	press_comp = 1048576 - adc_P;
+	press_comp = (uint32_t)((press_comp - (lv_var2 >> 12)) * ((uint32_t)3125));
+	if (press_comp >= (1 << 30))	//	1073741824
+		press_comp = ((press_comp / (uint32_t)lv_var1) << 1);
+	else
+		press_comp = ((press_comp << 1) / (uint32_t)lv_var1);
+	lv_var1 = (lp_pc.P9 * (int32_t)(((press_comp >> 3) * (press_comp >> 3)) >> 13)) >> 12;
+	lv_var2 = ((int32_t)(press_comp >> 2) * lp_pc.P8) >> 13;
+	//	exact (cube * P10) >> 17 without 64 bit, int32 product of Bosch formula overflows above ~104 kPa with P10 = 30
+	lv_cube = (press_comp >> 8) * (press_comp >> 8) * (press_comp >> 8);
+	lv_var3 = (int32_t)((lv_cube >> 17) * (uint32_t)lp_pc.P10 + (((lv_cube & 0x1FFFF) * (uint32_t)lp_pc.P10) >> 17));
+	press_comp = (int32_t)(press_comp)+((lv_var1 + lv_var2 + lv_var3 + lp_pc.P7s7) >> 4);
+	return press_comp;
+}
+
+/*	@brief	Terms of humidity formula, that depend only on temperature (values of node of table):
+	offset of adc_H, gain, factor of quadratic term var4
+	@param	temp_comp	compensated temperature, 0.01 C	*/
+static inline void gf_humTerms(const preBME680_stru &lp_pc, int32_t temp_comp, int32_t *lp_term) {
+	int32_t temp_scaled = (int32_t)temp_comp;
+	lp_term[0] = lp_pc.H1s4 + (((temp_scaled * lp_pc.H3) / ((int32_t)100)) >> 1);
+	lp_term[1] = (lp_pc.H2 * (((temp_scaled *
+		lp_pc.H4) / ((int32_t)100)) +
+		(((temp_scaled * ((temp_scaled * lp_pc.H5) /
+			((int32_t)100))) >> 6) / ((int32_t)100)) + ((int32_t)(1 << 14)))) >> 10;
+	lp_term[2] = (lp_pc.H6s7 +
+		((temp_scaled * lp_pc.H7) / ((int32_t)100))) >> 4;
+}
+
+/*	@brief	Humidity formula with terms lp_term of temperature, without branches
+	(kernel of gf_compH and of loop of gf_compBatch)
+	@return	humidity hum_comp, 0.001 %RH, limits 0..100000 as in Bosch BME68x API
+	(0 if the humidity module has been disabled)	*/
+static inline int32_t gf_kernH(uint32_t adc_H, const int32_t *lp_term) {
+	int32_t lv_var1, lv_var3, lv_var5, lv_var6;
+	lv_var1 = (int32_t)adc_H - lp_term[0];
+	lv_var3 = lv_var1 * lp_term[1];
+	lv_var5 = ((lv_var3 >> 14) * (lv_var3 >> 14)) >> 10;
+	lv_var6 = (lp_term[2] * lv_var5) >> 1;
+	lv_var1 = (((lv_var3 + lv_var6) >> 10) * ((int32_t)1000)) >> 12;
+	lv_var1 = (lv_var1 > 100000 ? 100000 : lv_var1);	// select without branch, loop of gf_compBatch is vectorized
+	lv_var1 = (lv_var1 < 0 ? 0 : lv_var1);
+	return (adc_H == cd_ADC_SKIP_H ? 0 : lv_var1);	// If the humidity module has been disabled return '0'
+}
+
+/*	@brief	Build table of accelerated humidity of lp_ht.n nodes (terms at -40..85 C) in lp_ht.val
+	and attach it to precompiled calibration data	*/
+void gf_humTab(humTab_stru &lp_ht, preBME680_stru &lp_pc) {
+	lp_pc.htab = NULL;
+	if (!gf_htabRange(lp_ht, -4000, 8500)) return;
+	for (uint8_t i = 0; i < lp_ht.n; i++)
+		gf_humTerms(lp_pc, lp_ht.t0 + ((int32_t)i << lp_ht.shift), lp_ht.val + (uint16_t)i * cd_HNODE_680);
+	gf_htabFrac(lp_ht, cd_HNODE_680);
+	lp_pc.htab = &lp_ht;
+}
+
+/*	@brief	Calc raw humidity adc_H to compensate value,
+	where par_h1, par_h2, …, par_h7 are calibration parameters,
+	terms of temperature (5 divisions) are interpolated by table if it is attached
+	@param	temp_comp	compensated temperature, 0.01 C
+	@return	humidity hum_comp, 0.001 %RH, 0..100000 (0 if the humidity module has been disabled)	*/
+int32_t gf_compH(const preBME680_stru &lp_pc, uint32_t adc_H, int32_t temp_comp) {
+	int32_t lv_term[cd_HNODE_680];
+	if (!gf_htabVal(lp_pc.htab, temp_comp, lv_term, cd_HNODE_680)) gf_humTerms(lp_pc, temp_comp, lv_term);
+	return gf_kernH(adc_H, lv_term);
+}
+
+static const uint32_t gv_gasTab1[16] = {	//	gas ADC range constants, BME680 datasheet
+	UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2147483647),
+	UINT32_C(2147483647), UINT32_C(2126008810), UINT32_C(2147483647), UINT32_C(2130303777),
+	UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2143188679), UINT32_C(2136746228),
+	UINT32_C(2147483647), UINT32_C(2126008810), UINT32_C(2147483647), UINT32_C(2147483647) };
+static const uint32_t gv_gasTab2[16] = {
+	UINT32_C(4096000000), UINT32_C(2048000000), UINT32_C(1024000000), UINT32_C(512000000),
+	UINT32_C(255744255),  UINT32_C(127110228),  UINT32_C(64000000),   UINT32_C(32258064),
+	UINT32_C(16016016),   UINT32_C(8000000),    UINT32_C(4000000),    UINT32_C(2000000),
+	UINT32_C(1000000),    UINT32_C(500000),     UINT32_C(250000),     UINT32_C(125000) };
+
+/*	@brief	Calc of GAS sensor resistance consists of 4 steps:
+	1. Read raw gas sensor resistance data (i.e. ADC value) adc_G	
+			register address 0x2A<9:2>/0x2B<7:6> 	=> adc_G
+	2. Range switching error - a calibration parameter, read in begin(),
+			register address 0x04 bits <7:4>		=> lp_cd.range_sw_err
+	3. Read gas ADC range (gas_range) of the measured gas sensor resistance, (see Section 5.3.4)
+			register address 0x2B bits <3:0>	   	=> gas_range
+	4. Convert ADC value (adc_G) into compensated gas sensor resistance (gas_res) in Ohm
+	@return	gas resistance, Ohm	*/
+uint32_t gf_compG(const preBME680_stru &lp_pc, uint32_t adc_G, uint8_t gas_range) {
+	int64_t		var1, var3;
+	uint64_t	var2;
+	var1 = lp_pc.gasVar1[gas_range];
+	var2 = (((int64_t)((int64_t)adc_G << 15) - (int64_t)(16777216)) + var1);
+	var3 = lp_pc.gasVar3[gas_range];
+	return (uint32_t)((var3 + ((int64_t)var2 >> 1)) / (int64_t)var2);
+}
+
+/*	@brief	Constant terms var1, var3 of gas formula for gas_range, they depend only on range_sw_err	*/
+static void gf_gasConst(preBME680_stru &lp_pc, const calibBME680_stru &lp_cd, uint8_t gas_range) {
+	int64_t var1 = (int64_t)((1340 + (5 * (int64_t)lp_cd.range_sw_err)) * ((int64_t)gv_gasTab1[gas_range])) >> 16;
+	lp_pc.gasVar1[gas_range] = (int32_t)var1;
+	lp_pc.gasVar3[gas_range] = (((int64_t)gv_gasTab2[gas_range] * (int64_t)var1) >> 9);
+}
+
+/*	@brief	Precompile calibration data without gas table	*/
+static void gf_precalcTPH(preBME680_stru &lp_pc, const calibBME680_stru &lp_cd) {
+	lp_pc.T1s1 = (int32_t)lp_cd.T1 << 1;
+	lp_pc.T2 = (int32_t)lp_cd.T2;
+	lp_pc.T3s4 = (int32_t)lp_cd.T3 << 4;
+	lp_pc.P1 = (int32_t)lp_cd.P1;
+	lp_pc.P2 = (int32_t)lp_cd.P2;
+	lp_pc.P3s5 = (int32_t)lp_cd.P3 << 5;
+	lp_pc.P4s16 = (int32_t)lp_cd.P4 << 16;
+	lp_pc.P5 = (int32_t)lp_cd.P5;
+	lp_pc.P6 = (int32_t)lp_cd.P6;
+	lp_pc.P7s7 = (int32_t)lp_cd.P7 << 7;
+	lp_pc.P8 = (int32_t)lp_cd.P8;
+	lp_pc.P9 = (int32_t)lp_cd.P9;
+	lp_pc.P10 = (int32_t)lp_cd.P10;
+	lp_pc.H1s4 = (int32_t)((int32_t)lp_cd.H1 << 4);
+	lp_pc.H2 = (int32_t)lp_cd.H2;
+	lp_pc.H3 = (int32_t)lp_cd.H3;
+	lp_pc.H4 = (int32_t)lp_cd.H4;
+	lp_pc.H5 = (int32_t)lp_cd.H5;
+	lp_pc.H6s7 = (int32_t)lp_cd.H6 << 7;
+	lp_pc.H7 = (int32_t)lp_cd.H7;
+	lp_pc.htab = NULL;
+}
+
+/*	@brief	Precompile calibration data: fold constant terms of formulas once (in begin()),
+	gas constants are table for all 16 values of gas_range	*/
+void gf_precalc(preBME680_stru &lp_pc, const calibBME680_stru &lp_cd) {
+	gf_precalcTPH(lp_pc, lp_cd);
+	for (uint8_t i = 0; i < 16; i++) gf_gasConst(lp_pc, lp_cd, i);
+}
+
+//	the same by not precompiled calibration data, for single calls
+int32_t gf_compT(const calibBME680_stru &lp_cd, uint32_t adc_T, int32_t &t_fine) {
+	preBME680_stru lv_pc;
+	gf_precalcTPH(lv_pc, lp_cd);
+	return gf_compT(lv_pc, adc_T, t_fine);
+}
+uint32_t gf_compP(const calibBME680_stru &lp_cd, uint32_t adc_P, int32_t t_fine) {
+	preBME680_stru lv_pc;
+	gf_precalcTPH(lv_pc, lp_cd);
+	return gf_compP(lv_pc, adc_P, t_fine);
+}
+int32_t gf_compH(const calibBME680_stru &lp_cd, uint32_t adc_H, int32_t temp_comp) {
+	preBME680_stru lv_pc;
+	gf_precalcTPH(lv_pc, lp_cd);
+	return gf_compH(lv_pc, adc_H, temp_comp);
+}
+uint32_t gf_compG(const calibBME680_stru &lp_cd, uint32_t adc_G, uint8_t gas_range) {
+	preBME680_stru lv_pc;
+	gf_gasConst(lv_pc, lp_cd, gas_range);	//	only one range is needed
+	return gf_compG(lv_pc, adc_G, gas_range);
+}
+
+/*	@brief	Calc raw data (adc_ P T H G) to compensate value
+	@param	gas_range	gas ADC range, register 0x2B bits <3:0>
+	@returns T 0.01 C, P Pa, H 0.001 %RH, G Ohm in structure var, valid = cd_VAL_T | cd_VAL_P | cd_VAL_H
+	of measured values (gas flags are in reg 0x2B, classes add them)	*/
+tphgFixed_stru gf_compTPHG_fixed(const preBME680_stru &lp_pc, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+		uint32_t adc_G, uint8_t gas_range) {
+	tphgFixed_stru lv_tphg;
+	int32_t t_fine;
+	lv_tphg.temp1 = gf_compT(lp_pc, adc_T, t_fine);
+	lv_tphg.pres1 = gf_compP(lp_pc, adc_P, t_fine);
+	lv_tphg.humi1 = (uint32_t)gf_compH(lp_pc, adc_H, lv_tphg.temp1);	//	0.001 %RH, 0..100000
+	if (adc_G == 0x8000) lv_tphg.gasr1 = 0;	// If the gas module has been disabled return '0'
+	else lv_tphg.gasr1 = gf_compG(lp_pc, adc_G, gas_range);
+	lv_tphg.valid = gf_valid(adc_T, adc_P, adc_H);
+	return lv_tphg;
+}
+
+/*	@brief	The same as gf_compTPHG_fixed(), but float T C, P Pa, H %RH, G kOhm	*/
+tphg_stru gf_compTPHG(const preBME680_stru &lp_pc, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+		uint32_t adc_G, uint8_t gas_range) {
+	tphgFixed_stru lv_fix = gf_compTPHG_fixed(lp_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+	tphg_stru lv_tphg;
+	lv_tphg.temp1 = ((float)lv_fix.temp1) / 100;
+	lv_tphg.pres1 = (float)lv_fix.pres1;
+	lv_tphg.humi1 = ((float)lv_fix.humi1) / 1000;
+	lv_tphg.gasr1 = ((float)lv_fix.gasr1) / 1000;	//	resistance kOm
+	lv_tphg.valid = lv_fix.valid;
+	return lv_tphg;
+}
+
+//	the same by not precompiled calibration data, for single calls
+tphgFixed_stru gf_compTPHG_fixed(const calibBME680_stru &lp_cd, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+		uint32_t adc_G, uint8_t gas_range) {
+	preBME680_stru lv_pc;
+	gf_precalcTPH(lv_pc, lp_cd);
+	gf_gasConst(lv_pc, lp_cd, gas_range);
+	return gf_compTPHG_fixed(lv_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+tphg_stru gf_compTPHG(const calibBME680_stru &lp_cd, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+		uint32_t adc_G, uint8_t gas_range) {
+	preBME680_stru lv_pc;
+	gf_precalcTPH(lv_pc, lp_cd);
+	gf_gasConst(lv_pc, lp_cd, gas_range);
+	return gf_compTPHG(lv_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+
+
+
+//============================================
+//	Compensation backends, selected at compile time by parameter T_comp of sensor classes:
+//	cl_compInt32, cl_compInt64 - Bosch integer formulas, cl_compFloat, cl_compDouble - Bosch float formulas.
+//	Float and double formulas are one template by type of calculation T_f.
+//============================================
+/*	@brief	Calc raw pressure adc_P of BMx280 to compensate value (32 bit integer formula, datasheet BME280 4.2.3)
+	@return	pressure, Pa (0 if the pressure module has been disabled)	*/
+template <class T_cd>
+static uint32_t gf_compP32(const T_cd &lp_cd, int32_t adc_P, int32_t t_fine) {
+	int32_t var1, var2;
+	uint32_t p;
+	if (adc_P == cd_ADC_SKIP) return 0;	// If the pressure module has been disabled return '0'
+	var1 = (t_fine >> 1) - (int32_t)64000;
+	var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)lp_cd.P6);
+	var2 = var2 + ((var1 * ((int32_t)lp_cd.P5)) << 1);
+	var2 = (var2 >> 2) + (((int32_t)lp_cd.P4) << 16);
+	var1 = (((lp_cd.P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t)lp_cd.P2) * var1) >> 1)) >> 18;
+	var1 = ((((32768 + var1)) * ((int32_t)lp_cd.P1)) >> 15);
+	if (var1 == 0) return 0;	// avoid exception caused by division by zero
+	p = (((uint32_t)(((int32_t)1048576) - adc_P) - (var2 >> 12))) * 3125;
+	if (p < 0x80000000) p = (p << 1) / ((uint32_t)var1);
+	else p = (p / (uint32_t)var1) * 2;
+	var1 = (((int32_t)lp_cd.P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+	var2 = (((int32_t)(p >> 2)) * ((int32_t)lp_cd.P8)) >> 13;
+	p = (uint32_t)((int32_t)p + ((var1 + var2 + lp_cd.P7) >> 4));
+	return p;
+}
+
+/*	@brief	Calc raw temperature adc_T of BMx280 by float formula (datasheet BME280 8.1)
+	@param	t_fine	returns fine temperature for calc of pressure and humidity
+	@return	temperature, C	*/
+template <class T_f, class T_cd>
+static T_f gf_fltT(const T_cd &lp_cd, int32_t adc_T, int32_t &t_fine) {
+	T_f var1, var2;
+	if (adc_T == cd_ADC_SKIP) {		// if the temperature module has been disabled return '0'
+		t_fine = 0;
+		return 0;
 	}
+	var1 = (((T_f)adc_T) / 16384 - ((T_f)lp_cd.T1) / 1024) * ((T_f)lp_cd.T2);
+	var2 = (((T_f)adc_T) / 131072 - ((T_f)lp_cd.T1) / 8192);
+	var2 = var2 * var2 * ((T_f)lp_cd.T3);
+	t_fine = (int32_t)(var1 + var2);
+	return (var1 + var2) / 5120;
+}
+
+/*	@brief	Calc raw pressure adc_P of BMx280 by float formula
+	@return	pressure, Pa	*/
+template <class T_f, class T_cd>
+static T_f gf_fltP(const T_cd &lp_cd, int32_t adc_P, int32_t t_fine) {
+	T_f var1, var2, p;
+	if (adc_P == cd_ADC_SKIP) return 0;	// If the pressure module has been disabled return '0'
+	var1 = ((T_f)t_fine / 2) - 64000;
+	var2 = var1 * var1 * ((T_f)lp_cd.P6) / 32768;
+	var2 = var2 + var1 * ((T_f)lp_cd.P5) * 2;
+	var2 = (var2 / 4) + (((T_f)lp_cd.P4) * 65536);
+	var1 = (((T_f)lp_cd.P3) * var1 * var1 / 524288 + ((T_f)lp_cd.P2) * var1) / 524288;
+	var1 = (1 + var1 / 32768) * ((T_f)lp_cd.P1);
+	if (var1 == 0) return 0;	// avoid exception caused by division by zero
+	p = 1048576 - (T_f)adc_P;
+	p = (p - (var2 / 4096)) * 6250 / var1;
+	var1 = ((T_f)lp_cd.P9) * p * p / (T_f)2147483648.0;
+	var2 = p * ((T_f)lp_cd.P8) / 32768;
+	return p + (var1 + var2 + ((T_f)lp_cd.P7)) / 16;
+}
+
+/*	@brief	Calc raw humidity adc_H of BME280 by float formula
+	@return	humidity, %RH	*/
+template <class T_f>
+static T_f gf_fltH(const calibBME280_stru &lp_cd, int32_t adc_H, int32_t t_fine) {
+	T_f var_H;
+	if (adc_H == cd_ADC_SKIP_H) return 0;	// If the humidity module has been disabled return '0'
+	var_H = ((T_f)t_fine) - 76800;
+	var_H = (adc_H - (((T_f)lp_cd.H4) * 64 + ((T_f)lp_cd.H5) / 16384 * var_H)) *
+		(((T_f)lp_cd.H2) / 65536 * (1 + ((T_f)lp_cd.H6) / 67108864 * var_H * (1 + ((T_f)lp_cd.H3) / 67108864 * var_H)));
+	var_H = var_H * (1 - ((T_f)lp_cd.H1) * var_H / 524288);
+	if (var_H > 100) var_H = 100;
+	if (var_H < 0) var_H = 0;
+	return var_H;
+}
+
+static const float gv_gasK1[16] = {	//	gas ADC range constants of float formula, Bosch BME68x API
+	0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, -0.8f, 0.0f, 0.0f, -0.2f, -0.5f, 0.0f, -1.0f, 0.0f, 0.0f };
+static const float gv_gasK2[16] = {
+	0.0f, 0.0f, 0.0f, 0.0f, 0.1f, 0.7f, 0.0f, -0.8f, -0.1f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
 
-	// Calc P, where par_p1, par_p2, …, par_p10 are calibration parameters,
-	// adc_P - the raw pressure data, press_comp - the compensated pressure in Pascal.
-	if (adc_P == 0x800000) {
-		lv_tphg.pres1 = 0;	// If the pressure module has been disabled return '0'
+/*	@brief	Calc raw data (adc_ P T H G) of BME680 by float formulas of Bosch BME68x API
+	@returns T C, P Pa, H %RH, G kOhm in structure var	*/
+template <class T_f>
+static tphg_stru gf_fltTPHG(const calibBME680_stru &lp_cd, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+		uint32_t adc_G, uint8_t gas_range) {
+	tphg_stru lv_tphg = { 0, 0, 0, 0, gf_valid(adc_T, adc_P, adc_H) };
+	T_f var1, var2, var3, var4, t_fine, temp_comp, press_comp, hum_comp;
+	if (adc_T == cd_ADC_SKIP) return lv_tphg;	// if the temperature module has been disabled return '0'
+	var1 = (((T_f)adc_T / 16384) - ((T_f)lp_cd.T1 / 1024)) * ((T_f)lp_cd.T2);
+	var2 = (((T_f)adc_T / 131072) - ((T_f)lp_cd.T1 / 8192));
+	var2 = var2 * var2 * ((T_f)lp_cd.T3 * 16);
+	t_fine = var1 + var2;
+	temp_comp = t_fine / 5120;
+	lv_tphg.temp1 = (float)temp_comp;
+
+	press_comp = 0;
+	var1 = (t_fine / 2) - 64000;
+	var2 = var1 * var1 * ((T_f)lp_cd.P6 / 131072);
+	var2 = var2 + (var1 * (T_f)lp_cd.P5 * 2);
+	var2 = (var2 / 4) + ((T_f)lp_cd.P4 * 65536);
+	var1 = ((((T_f)lp_cd.P3 * var1 * var1) / 16384) + ((T_f)lp_cd.P2 * var1)) / 524288;
+	var1 = (1 + (var1 / 32768)) * (T_f)lp_cd.P1;
+	if (adc_P != cd_ADC_SKIP && (int32_t)var1 != 0) {	// avoid exception caused by division by zero
+		press_comp = 1048576 - (T_f)adc_P;
+		press_comp = ((press_comp - (var2 / 4096)) * 6250) / var1;
+		var1 = ((T_f)lp_cd.P9 * press_comp * press_comp) / (T_f)2147483648.0;
+		var2 = press_comp * ((T_f)lp_cd.P8 / 32768);
+		var3 = (press_comp / 256) * (press_comp / 256) * (press_comp / 256) * ((T_f)lp_cd.P10 / 131072);
+		press_comp = press_comp + (var1 + var2 + var3 + ((T_f)lp_cd.P7 * 128)) / 16;
 	}
-	else {
-		uint32_t press_comp;
-		lv_var1 = ((int32_t)t_fine >> 1) - 64000;
-		lv_var2 = ((((lv_var1 >> 2) * (lv_var1 >> 2)) >> 11) * (int32_t)clv_cd.P6) >> 2;
-		lv_var2 = lv_var2 + ((lv_var1 * (int32_t)clv_cd.P5) << 1);
-		lv_var2 = (lv_var2 >> 2) + ((int32_t)clv_cd.P4 << 16);
-		lv_var1 = (((((lv_var1 >> 2) * (lv_var1 >> 2)) >> 13) * ((int32_t)clv_cd.P3 << 5)) >> 3) + (((int32_t)clv_cd.P2 * lv_var1) >> 1);
-		lv_var1 = lv_var1 >> 18;
-		lv_var1 = ((32768 + lv_var1) * (int32_t)clv_cd.P1) >> 15;
-		press_comp = 1048576 - adc_P;
-		press_comp = (uint32_t)((press_comp - (lv_var2 >> 12)) * ((uint32_t)3125));
-		if (press_comp >= (1 << 30))	//	1073741824
-			press_comp = ((press_comp / (uint32_t)lv_var1) << 1);
-		else
-			press_comp = ((press_comp << 1) / (uint32_t)lv_var1);
-		lv_var1 = ((int32_t)clv_cd.P9 * (int32_t)(((press_comp >> 3) * (press_comp >> 3)) >> 13)) >> 12;
-		lv_var2 = ((int32_t)(press_comp >> 2) * (int32_t)clv_cd.P8) >> 13;
-		lv_var3 = ((int32_t)(press_comp >> 8) * (int32_t)(press_comp >> 8) * (int32_t)(press_comp >> 8) * (int32_t)clv_cd.P10) >> 17;
-		press_comp = (int32_t)(press_comp)+((lv_var1 + lv_var2 + lv_var3 + ((int32_t)clv_cd.P7 << 7)) >> 4);
-		lv_tphg.pres1 = (float)press_comp;
+	lv_tphg.pres1 = (float)press_comp;
+
+	if (adc_H != cd_ADC_SKIP_H) {
+		var1 = (T_f)adc_H - (((T_f)lp_cd.H1 * 16) + (((T_f)lp_cd.H3 / 2) * temp_comp));
+		var2 = var1 * (((T_f)lp_cd.H2 / 262144) * (1 + (((T_f)lp_cd.H4 / 16384) * temp_comp) +
+			(((T_f)lp_cd.H5 / 1048576) * temp_comp * temp_comp)));
+		var3 = (T_f)lp_cd.H6 / 16384;
+		var4 = (T_f)lp_cd.H7 / 2097152;
+		hum_comp = var2 + ((var3 + (var4 * temp_comp)) * var2 * var2);
+		if (hum_comp > 100) hum_comp = 100;
+		if (hum_comp < 0) hum_comp = 0;
+		lv_tphg.humi1 = (float)hum_comp;
 	}
 
-	// Calc H, where par_h1, par_h2, …, par_h7 are calibration parameters,
-	// hum_adc is the raw humidity data, hum_comp - the compensated humidity in percent.
-	int32_t lv_var4, lv_var5, lv_var6, hum_comp;
-	if (adc_H == 0x8000) lv_tphg.humi1 = 0;	// If the humidity module has been disabled return '0'
-	else {
-		int32_t temp_scaled = (int32_t)temp_comp;
-		lv_var1 = (int32_t)adc_H - (int32_t)((int32_t)clv_cd.H1 << 4) -
-			(((temp_scaled * (int32_t)clv_cd.H3) / ((int32_t)100)) >> 1);
-		lv_var2 = ((int32_t)clv_cd.H2 * (((temp_scaled *
-			(int32_t)clv_cd.H4) / ((int32_t)100)) +
-			(((temp_scaled * ((temp_scaled * (int32_t)clv_cd.H5) /
-				((int32_t)100))) >> 6) / ((int32_t)100)) + ((int32_t)(1 << 14)))) >> 10;
-		lv_var3 = lv_var1 * lv_var2;
-		lv_var4 = (((int32_t)clv_cd.H6 << 7) +
-			((temp_scaled * (int32_t)clv_cd.H7) / ((int32_t)100))) >> 4;
-		lv_var5 = ((lv_var3 >> 14) * (lv_var3 >> 14)) >> 10;
-		lv_var6 = (lv_var4 * lv_var5) >> 1;
-		hum_comp = (((lv_var3 + lv_var6) >> 10) * ((int32_t)1000)) >> 12;
-		lv_tphg.humi1 = ((float)hum_comp) / 1024;	// ???
+	if (adc_G != 0x8000) {	// If the gas module has been disabled return '0'
+		var1 = 1340 + (5 * (T_f)lp_cd.range_sw_err);
+		var2 = var1 * (1 + (T_f)gv_gasK1[gas_range] / 100);
+		var3 = 1 + ((T_f)gv_gasK2[gas_range] / 100);
+		var4 = 1 / (var3 * (T_f)0.000000125 * (T_f)(1UL << gas_range) * ((((T_f)adc_G - 512) / var2) + 1));
+		lv_tphg.gasr1 = (float)(var4 / 1000);	//	resistance kOm
 	}
+	return lv_tphg;
+}
 
-	// Calc of GAS sensor resistance consists of 4 steps:
-	// 1. Read raw gas sensor resistance data (i.e. ADC value) adc_G	
-	// 		register address 0x2A<9:2>/0x2B<7:6> 	=> adc_G
-	// 2. Read range switching error - a calibration parameter,
-	// 		register address 0x04 bits <7:4>		=> range_switching_error
-	// 3. Read gas ADC range (gas_range) of the measured gas sensor resistance, (see Section 5.3.4)
-	// 		register address 0x2B bits <3:0>	   	=> gas_range
-	// 4. Convert ADC value (adc_G) into compensated gas sensor resistance (gas_res) in Ohm (kOm)
-	if (adc_G == 0x8000) lv_tphg.gasr1 = 0;	// If the humidity module has been disabled return '0'
-	else {
-		const uint32_t uintTab1[16] = {
-		UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2147483647),
-		UINT32_C(2147483647), UINT32_C(2126008810), UINT32_C(2147483647), UINT32_C(2130303777),
-		UINT32_C(2147483647), UINT32_C(2147483647), UINT32_C(2143188679), UINT32_C(2136746228),
-		UINT32_C(2147483647), UINT32_C(2126008810), UINT32_C(2147483647), UINT32_C(2147483647) };
-		const uint32_t uintTab2[16] = {
-		UINT32_C(4096000000), UINT32_C(2048000000), UINT32_C(1024000000), UINT32_C(512000000),
-		UINT32_C(255744255),  UINT32_C(127110228),  UINT32_C(64000000),   UINT32_C(32258064),
-		UINT32_C(16016016),   UINT32_C(8000000),    UINT32_C(4000000),    UINT32_C(2000000),
-		UINT32_C(1000000),    UINT32_C(500000),     UINT32_C(250000),     UINT32_C(125000) };
-
-		int64_t		var1, var3;
-		uint64_t	var2;
-		var1 = (int64_t)((1340 + (5 * (int64_t)range_switching_error)) * ((int64_t)uintTab1[gas_range])) >> 16;
-		var2 = (((int64_t)((int64_t)adc_G << 15) - (int64_t)(16777216)) + var1);
-		var3 = (((int64_t)uintTab2[gas_range] * (int64_t)var1) >> 9);
-		uint32_t gas_res = (uint32_t)((var3 + ((int64_t)var2 >> 1)) / (int64_t)var2);
-		lv_tphg.gasr1 = ((float)gas_res) / 1000;	//	resistance kOm
+//	cl_compInt32: 32 bit pressure of BMx280, Pa
+tp_stru cl_compInt32::compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	tp_stru lv_tp;
+	int32_t t_fine;
+	lv_tp.temp1 = ((float)gf_compT(lp_pc, adc_T, t_fine)) / 100;
+	lv_tp.pres1 = (float)gf_compP32(lp_cd, (int32_t)adc_P, t_fine);
+	lv_tp.valid = gf_valid(adc_T, adc_P);
+	return lv_tp;
+}
+tph_stru cl_compInt32::compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	tph_stru lv_tph;
+	int32_t t_fine;
+	lv_tph.temp1 = (float)gf_compT(lp_pc, adc_T, t_fine) / 100.0;
+	lv_tph.pres1 = (float)gf_compP32(lp_cd, adc_P, t_fine);
+	lv_tph.humi1 = (float)gf_compH(lp_pc, adc_H, t_fine) / 1024.0;
+	lv_tph.valid = gf_valid(adc_T, adc_P, adc_H);
+	return lv_tph;
+}
+tphg_stru cl_compInt32::compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range) {
+	(void)lp_cd;
+	return gf_compTPHG(lp_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+
+//	cl_compInt64: 64 bit pressure of BMx280, Pa/256 (BME680 has only 32 bit integer formulas)
+tp_stru cl_compInt64::compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	(void)lp_cd;
+	return gf_compTP(lp_pc, adc_T, adc_P);
+}
+tph_stru cl_compInt64::compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	(void)lp_cd;
+	return gf_compTPH(lp_pc, adc_T, adc_P, adc_H);
+}
+tphg_stru cl_compInt64::compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range) {
+	(void)lp_cd;
+	return gf_compTPHG(lp_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+
+//	cl_compFloat, cl_compDouble: float formulas, precompiled calibration data is not used
+tp_stru cl_compFloat::compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	tp_stru lv_tp;
+	int32_t t_fine;
+	(void)lp_pc;
+	lv_tp.temp1 = gf_fltT<float>(lp_cd, adc_T, t_fine);
+	lv_tp.pres1 = gf_fltP<float>(lp_cd, (int32_t)adc_P, t_fine);
+	lv_tp.valid = gf_valid(adc_T, adc_P);
+	return lv_tp;
+}
+tph_stru cl_compFloat::compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	tph_stru lv_tph;
+	int32_t t_fine;
+	(void)lp_pc;
+	lv_tph.temp1 = gf_fltT<float>(lp_cd, adc_T, t_fine);
+	lv_tph.pres1 = gf_fltP<float>(lp_cd, adc_P, t_fine);
+	lv_tph.humi1 = gf_fltH<float>(lp_cd, adc_H, t_fine);
+	lv_tph.valid = gf_valid(adc_T, adc_P, adc_H);
+	return lv_tph;
+}
+tphg_stru cl_compFloat::compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range) {
+	(void)lp_pc;
+	return gf_fltTPHG<float>(lp_cd, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+
+tp_stru cl_compDouble::compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P) {
+	tp_stru lv_tp;
+	int32_t t_fine;
+	(void)lp_pc;
+	lv_tp.temp1 = (float)gf_fltT<double>(lp_cd, adc_T, t_fine);
+	lv_tp.pres1 = (float)gf_fltP<double>(lp_cd, (int32_t)adc_P, t_fine);
+	lv_tp.valid = gf_valid(adc_T, adc_P);
+	return lv_tp;
+}
+tph_stru cl_compDouble::compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+	tph_stru lv_tph;
+	int32_t t_fine;
+	(void)lp_pc;
+	lv_tph.temp1 = (float)gf_fltT<double>(lp_cd, adc_T, t_fine);
+	lv_tph.pres1 = (float)gf_fltP<double>(lp_cd, adc_P, t_fine);
+	lv_tph.humi1 = (float)gf_fltH<double>(lp_cd, adc_H, t_fine);
+	lv_tph.valid = gf_valid(adc_T, adc_P, adc_H);
+	return lv_tph;
+}
+tphg_stru cl_compDouble::compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range) {
+	(void)lp_pc;
+	return gf_fltTPHG<double>(lp_cd, adc_T, adc_P, adc_H, adc_G, gas_range);
+}
+
+
+
+//============================================
+//	Portable image of calibration data: fields in order of structure, little endian, without padding,
+//	for log files and for saving calibration data in flash / RTC memory.
+//============================================
+template <class T> static void gf_put(uint8_t *&lp_p, T lp_v) {		// put field, little endian
+	for (uint8_t i = 0; i < sizeof(T); i++) *lp_p++ = (uint8_t)((uint32_t)lp_v >> (8 * i));
+}
+template <class T> static void gf_get(const uint8_t *&lp_p, T &lp_v) {	// get field, little endian
+	uint32_t lv_v = 0;
+	for (uint8_t i = 0; i < sizeof(T); i++) lv_v |= (uint32_t)(*lp_p++) << (8 * i);
+	lp_v = (T)lv_v;
+}
+
+/*	@brief	Pack (unpack) calibration data of BMP280, 24 bytes
+	@return	size of image, bytes	*/
+uint8_t gf_packCalib(const calibBMP280_stru &lp_cd, uint8_t *lp_buf) {
+	uint8_t *lv_p = lp_buf;
+	gf_put(lv_p, lp_cd.T1);	gf_put(lv_p, lp_cd.T2);	gf_put(lv_p, lp_cd.T3);
+	gf_put(lv_p, lp_cd.P1);	gf_put(lv_p, lp_cd.P2);	gf_put(lv_p, lp_cd.P3);
+	gf_put(lv_p, lp_cd.P4);	gf_put(lv_p, lp_cd.P5);	gf_put(lv_p, lp_cd.P6);
+	gf_put(lv_p, lp_cd.P7);	gf_put(lv_p, lp_cd.P8);	gf_put(lv_p, lp_cd.P9);
+	return lv_p - lp_buf;
+}
+uint8_t gf_unpackCalib(calibBMP280_stru &lp_cd, const uint8_t *lp_buf) {
+	const uint8_t *lv_p = lp_buf;
+	gf_get(lv_p, lp_cd.T1);	gf_get(lv_p, lp_cd.T2);	gf_get(lv_p, lp_cd.T3);
+	gf_get(lv_p, lp_cd.P1);	gf_get(lv_p, lp_cd.P2);	gf_get(lv_p, lp_cd.P3);
+	gf_get(lv_p, lp_cd.P4);	gf_get(lv_p, lp_cd.P5);	gf_get(lv_p, lp_cd.P6);
+	gf_get(lv_p, lp_cd.P7);	gf_get(lv_p, lp_cd.P8);	gf_get(lv_p, lp_cd.P9);
+	return lv_p - lp_buf;
+}
+
+/*	@brief	Pack (unpack) calibration data of BME280, 33 bytes
+	@return	size of image, bytes	*/
+uint8_t gf_packCalib(const calibBME280_stru &lp_cd, uint8_t *lp_buf) {
+	uint8_t *lv_p = lp_buf;
+	gf_put(lv_p, lp_cd.T1);	gf_put(lv_p, lp_cd.T2);	gf_put(lv_p, lp_cd.T3);
+	gf_put(lv_p, lp_cd.P1);	gf_put(lv_p, lp_cd.P2);	gf_put(lv_p, lp_cd.P3);
+	gf_put(lv_p, lp_cd.P4);	gf_put(lv_p, lp_cd.P5);	gf_put(lv_p, lp_cd.P6);
+	gf_put(lv_p, lp_cd.P7);	gf_put(lv_p, lp_cd.P8);	gf_put(lv_p, lp_cd.P9);
+	gf_put(lv_p, lp_cd.H1);	gf_put(lv_p, lp_cd.H2);	gf_put(lv_p, lp_cd.H3);
+	gf_put(lv_p, lp_cd.H4);	gf_put(lv_p, lp_cd.H5);	gf_put(lv_p, lp_cd.H6);
+	return lv_p - lp_buf;
+}
+uint8_t gf_unpackCalib(calibBME280_stru &lp_cd, const uint8_t *lp_buf) {
+	const uint8_t *lv_p = lp_buf;
+	gf_get(lv_p, lp_cd.T1);	gf_get(lv_p, lp_cd.T2);	gf_get(lv_p, lp_cd.T3);
+	gf_get(lv_p, lp_cd.P1);	gf_get(lv_p, lp_cd.P2);	gf_get(lv_p, lp_cd.P3);
+	gf_get(lv_p, lp_cd.P4);	gf_get(lv_p, lp_cd.P5);	gf_get(lv_p, lp_cd.P6);
+	gf_get(lv_p, lp_cd.P7);	gf_get(lv_p, lp_cd.P8);	gf_get(lv_p, lp_cd.P9);
+	gf_get(lv_p, lp_cd.H1);	gf_get(lv_p, lp_cd.H2);	gf_get(lv_p, lp_cd.H3);
+	gf_get(lv_p, lp_cd.H4);	gf_get(lv_p, lp_cd.H5);	gf_get(lv_p, lp_cd.H6);
+	return lv_p - lp_buf;
+}
+
+/*	@brief	Pack (unpack) calibration data of BME680 with heater and gas constants, 37 bytes
+	@return	size of image, bytes	*/
+uint8_t gf_packCalib(const calibBME680_stru &lp_cd, uint8_t *lp_buf) {
+	uint8_t *lv_p = lp_buf;
+	gf_put(lv_p, lp_cd.T1);	gf_put(lv_p, lp_cd.T2);	gf_put(lv_p, lp_cd.T3);
+	gf_put(lv_p, lp_cd.P1);	gf_put(lv_p, lp_cd.P2);	gf_put(lv_p, lp_cd.P3);	gf_put(lv_p, lp_cd.P4);
+	gf_put(lv_p, lp_cd.P5);	gf_put(lv_p, lp_cd.P6);	gf_put(lv_p, lp_cd.P7);	gf_put(lv_p, lp_cd.P8);
+	gf_put(lv_p, lp_cd.P9);	gf_put(lv_p, lp_cd.P10);
+	gf_put(lv_p, lp_cd.H1);	gf_put(lv_p, lp_cd.H2);	gf_put(lv_p, lp_cd.H3);	gf_put(lv_p, lp_cd.H4);
+	gf_put(lv_p, lp_cd.H5);	gf_put(lv_p, lp_cd.H6);	gf_put(lv_p, lp_cd.H7);
+	gf_put(lv_p, lp_cd.G1);	gf_put(lv_p, lp_cd.G2);	gf_put(lv_p, lp_cd.G3);
+	gf_put(lv_p, lp_cd.res_heat_val);	gf_put(lv_p, lp_cd.res_heat_range);	gf_put(lv_p, lp_cd.range_sw_err);
+	return lv_p - lp_buf;
+}
+uint8_t gf_unpackCalib(calibBME680_stru &lp_cd, const uint8_t *lp_buf) {
+	const uint8_t *lv_p = lp_buf;
+	gf_get(lv_p, lp_cd.T1);	gf_get(lv_p, lp_cd.T2);	gf_get(lv_p, lp_cd.T3);
+	gf_get(lv_p, lp_cd.P1);	gf_get(lv_p, lp_cd.P2);	gf_get(lv_p, lp_cd.P3);	gf_get(lv_p, lp_cd.P4);
+	gf_get(lv_p, lp_cd.P5);	gf_get(lv_p, lp_cd.P6);	gf_get(lv_p, lp_cd.P7);	gf_get(lv_p, lp_cd.P8);
+	gf_get(lv_p, lp_cd.P9);	gf_get(lv_p, lp_cd.P10);
+	gf_get(lv_p, lp_cd.H1);	gf_get(lv_p, lp_cd.H2);	gf_get(lv_p, lp_cd.H3);	gf_get(lv_p, lp_cd.H4);
+	gf_get(lv_p, lp_cd.H5);	gf_get(lv_p, lp_cd.H6);	gf_get(lv_p, lp_cd.H7);
+	gf_get(lv_p, lp_cd.G1);	gf_get(lv_p, lp_cd.G2);	gf_get(lv_p, lp_cd.G3);
+	gf_get(lv_p, lp_cd.res_heat_val);	gf_get(lv_p, lp_cd.res_heat_range);	gf_get(lv_p, lp_cd.range_sw_err);
+	return lv_p - lp_buf;
+}
+
+/*	@brief	Size of calibration image of chip (gf_packCalib())
+	@return	24 (BMP280), 33 (BME280), 37 (BME680) bytes, 0 if chip is unknown	*/
+uint8_t gf_calibLen(uint8_t lp_codeChip) {
+	if (lp_codeChip == cd_BMP280) return 24;
+	if (lp_codeChip == cd_BME280) return 33;
+	if (lp_codeChip == cd_BME680) return 37;
+	return 0;
+}
+
+/*	@brief	CRC-16/CCITT: poly 0x1021, init 0xFFFF, without reflection and final xor (check "123456789" = 0x29B1)
+	@return	CRC of lp_n bytes	*/
+uint16_t gf_crc16(const uint8_t *lp_buf, uint16_t lp_n) {
+	uint16_t lv_crc = 0xFFFF;
+	for (uint16_t i = 0; i < lp_n; i++) {
+		lv_crc ^= (uint16_t)lp_buf[i] << 8;
+		for (uint8_t k = 0; k < 8; k++) lv_crc = (lv_crc & 0x8000) ? (uint16_t)((lv_crc << 1) ^ 0x1021) : (uint16_t)(lv_crc << 1);
 	}
+	return lv_crc;
+}
 
-	return lv_tphg;
+/*	@brief	Check blob of saveState(): version, size of calibration image and CRC
+	@return	size of blob, bytes, or 0 if blob is wrong	*/
+uint8_t gf_blobCheck(const uint8_t *lp_blob) {
+	if (lp_blob[0] != cd_BLOB_VERSION || lp_blob[3] > cd_CALIB_MAXLEN) return 0;
+	uint8_t lv_n = cd_BLOB_HDRLEN + lp_blob[3];
+	if (gf_crc16(lp_blob, lv_n) != (uint16_t)(lp_blob[lv_n] | (lp_blob[lv_n + 1] << 8))) return 0;
+	return lv_n + 2;
+}
+
+
+
+//============================================
+//	Batch compensation of raw data arrays (structure of arrays), for reprocessing of logged adc_*.
+//	Results are the same as of single sample functions gf_compT, gf_compP, gf_compH, gf_compG.
+//	Data are processed by chunks, each channel by own simple loop, so compiler can vectorize
+//	loops of T and H (32 bit). Loops of P and G use 64 bit division and stay scalar.
+//============================================
+#define cd_BATCH_CHUNK	32		//	samples in chunk, size of local t_fine buffer
+
+/*	@brief	Compensate arrays of raw T P of BMP280
+	@param	temp	output temperature, 0.01 C
+	@param	pres	output pressure, Pa/256, may be NULL (then adc_P is not used)	*/
+void gf_compBatch(const calibBMP280_stru &lp_cd, const int32_t *adc_T, const uint32_t *adc_P, uint32_t lp_n,
+		int32_t *temp, uint32_t *pres) {
+	preBMP280_stru lv_pc;		//	local precompiled calibration, output arrays can not alias it
+	gf_precalc(lv_pc, lp_cd);
+	int32_t lv_tFine[cd_BATCH_CHUNK];
+	while (lp_n > 0) {
+		uint32_t lv_n = (lp_n < cd_BATCH_CHUNK) ? lp_n : cd_BATCH_CHUNK;
+		for (uint32_t i = 0; i < lv_n; i++) temp[i] = gf_compT(lv_pc, adc_T[i], lv_tFine[i]);
+		if (pres != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++) pres[i] = gf_compP(lv_pc, adc_P[i], lv_tFine[i]);
+			adc_P += lv_n;	pres += lv_n;
+		}
+		adc_T += lv_n;	temp += lv_n;
+		lp_n -= lv_n;
+	}
+}
+
+/*	@brief	Compensate arrays of raw T P H of BME280
+	@param	temp	output temperature, 0.01 C
+	@param	pres	output pressure, Pa/256, may be NULL (then adc_P is not used)
+	@param	humi	output humidity, %RH/1024, may be NULL (then adc_H is not used)	*/
+void gf_compBatch(const calibBME280_stru &lp_cd, const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+		uint32_t lp_n, int32_t *temp, uint32_t *pres, uint32_t *humi) {
+	preBME280_stru lv_pc;		//	local precompiled calibration, output arrays can not alias it
+	gf_precalc(lv_pc, lp_cd);
+	int32_t lv_tFine[cd_BATCH_CHUNK];
+	while (lp_n > 0) {
+		uint32_t lv_n = (lp_n < cd_BATCH_CHUNK) ? lp_n : cd_BATCH_CHUNK;
+		for (uint32_t i = 0; i < lv_n; i++) temp[i] = gf_compT(lv_pc, adc_T[i], lv_tFine[i]);
+		if (pres != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++) pres[i] = gf_compP(lv_pc, adc_P[i], lv_tFine[i]);
+			adc_P += lv_n;	pres += lv_n;
+		}
+		if (humi != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++)		// formula without table, loop has no branches
+				humi[i] = gf_kernH(lv_pc, adc_H[i], lv_tFine[i], gf_humGain(lv_pc, lv_tFine[i]));
+			adc_H += lv_n;	humi += lv_n;
+		}
+		adc_T += lv_n;	temp += lv_n;
+		lp_n -= lv_n;
+	}
+}
+
+/*	@brief	Compensate arrays of raw T P H G of BME680
+	@param	temp	output temperature, 0.01 C
+	@param	pres	output pressure, Pa, may be NULL (then adc_P is not used)
+	@param	humi	output humidity hum_comp, may be NULL (then adc_H is not used)
+	@param	gasr	output gas resistance, Ohm, may be NULL (then adc_G, gas_range are not used)	*/
+void gf_compBatch(const calibBME680_stru &lp_cd, const uint32_t *adc_T, const uint32_t *adc_P, const uint32_t *adc_H,
+		const uint32_t *adc_G, const uint8_t *gas_range, uint32_t lp_n,
+		int32_t *temp, uint32_t *pres, int32_t *humi, uint32_t *gasr) {
+	preBME680_stru lv_pc;		//	local precompiled calibration, output arrays can not alias it
+	gf_precalc(lv_pc, lp_cd);
+	int32_t lv_tFine[cd_BATCH_CHUNK];
+	while (lp_n > 0) {
+		uint32_t lv_n = (lp_n < cd_BATCH_CHUNK) ? lp_n : cd_BATCH_CHUNK;
+		for (uint32_t i = 0; i < lv_n; i++) temp[i] = gf_compT(lv_pc, adc_T[i], lv_tFine[i]);
+		if (pres != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++) pres[i] = gf_compP(lv_pc, adc_P[i], lv_tFine[i]);
+			adc_P += lv_n;	pres += lv_n;
+		}
+		if (humi != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++) {	// formula without table, loop has no branches
+				int32_t lv_term[cd_HNODE_680];
+				gf_humTerms(lv_pc, temp[i], lv_term);
+				humi[i] = gf_kernH(adc_H[i], lv_term);
+			}
+			adc_H += lv_n;	humi += lv_n;
+		}
+		if (gasr != NULL) {
+			for (uint32_t i = 0; i < lv_n; i++) gasr[i] = gf_compG(lv_pc, adc_G[i], gas_range[i]);
+			adc_G += lv_n;	gas_range += lv_n;	gasr += lv_n;
+		}
+		adc_T += lv_n;	temp += lv_n;
+		lp_n -= lv_n;
+	}
+}
+
+#ifndef ARDUINO
+//============================================
+//	Clock of instrumentation cl_instrFull on host (Linux), Arduino uses micros()
+//============================================
+/*	@brief	Time of steady clock, ns (it overflows every 4.3 s, differences of uint32_t are correct)	*/
+uint32_t gf_hostClock(void) {
+	return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*	@brief	Time of steady clock, us, clock of latency budget of retries (as micros() of Arduino)	*/
+uint32_t gf_hostMicros(void) {
+	return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+//============================================
+//	Wait between retries of failed transaction (setRetry())
+//============================================
+/*	@brief	Wait lp_us, us: Arduino delay() + delayMicroseconds() (its argument is 16 bit on AVR), busy wait on host	*/
+void gf_waitUs(uint32_t lp_us) {
+#ifdef ARDUINO
+	if (lp_us >= 1000) delay(lp_us / 1000);
+	delayMicroseconds((unsigned int)(lp_us % 1000));
+#else
+	uint32_t lv_t0 = gf_hostMicros();
+	while ((uint32_t)(gf_hostMicros() - lv_t0) < lp_us) {}
+#endif
 }
-//============================================================================================================
@@ -1,5 +1,7 @@
 /**
 *	@brief		C++ library Arduino framework for Bosch sensors: BMP280, BME280, BME680, via i2c.
+*				Bus transport is template parameter of classes (see mkigor_BMxx80_bus.h),
+*				without Arduino (Linux host) library works with simulated registers cl_SimBus.
 *	@author		Igor Mkprog, mkprogigor@gmail.com
 *	@version	V1.1	@date	10.10.2025
 *	@example	https://github.com/mkprogigor/mkigor_BMxx80/blob/main/examples/test_bme680.ino
@@ -15,19 +17,20 @@
 *		clv_*	- Class private (Local) member (Variable);
 *		cgf_*	- Class public (Global) metod (Function), not need, no usefull, becouse we see parenthesis => ();
 *		clf_*	- Class private (Local) metod (Function);
-*		lp_*	- in function, local parameter.
+*		lp_*	- in function, local parameter;
+*		gf_*	- Global Function (not member of class);
+*		T_*		- Template parameter (type).
 *	suffix:
 *		like ending *_t, as usual, point to the type, informative, but not mandatory to use.
 *		possible is: _i8, _i16, _i32, _i64, _u8, _u16, _u32, _u64, _f, _df, _c, _b, _stru, etc.
 *	example:	- prefix_nameOfFuncOrVar_suffix, gv_tphg_stru => global var (tphg) structure.
 */
 
-#include <Arduino.h>
-#include <Wire.h>
-
 #ifndef mkigor_BMxx80_h
 #define mkigor_BMxx80_h
 
+#include <mkigor_BMxx80_bus.h>
+
 #define cd_NOR_MODE		0x03
 #define cd_FOR_MODE		0x01
 
@@ -60,153 +63,1524 @@
 #define cd_BME280		0x60
 #define cd_BME680		0x61
 
+#define cd_ADC_SKIP		0x80000	///	adc_T, adc_P of skipped measuring (oversampling cd_OS_OFF), 20 bit
+#define cd_ADC_SKIP_H	0x8000	///	adc_H of skipped measuring, 16 bit
+
+#define cd_VAL_T		0x01	///	validity flags of results (field valid): temperature is measured (adc_T is not cd_ADC_SKIP of skipped)
+#define cd_VAL_P		0x02	///	pressure is measured (adc_P is not cd_ADC_SKIP)
+#define cd_VAL_H		0x04	///	humidity is measured (adc_H is not cd_ADC_SKIP_H)
+#define cd_VAL_G		0x08	///	BME680 gas resistance is valid, gas_valid_r = 1
+#define cd_VAL_HEAT		0x10	///	BME680 heater reached target temperature, heat_stab_r = 1
+
+///	field valid: cd_VAL_* flags of measured values, 0 = values are not read (bus error) or calibration data are not read
 struct tp_stru {
 	float temp1;
 	float pres1;
+	uint8_t valid;
 };
 struct tph_stru {
 	float temp1;
 	float pres1;
 	float humi1;
+	uint8_t valid;
 };
 struct tphg_stru {
 	float temp1;
 	float pres1;
 	float humi1;
 	float gasr1;
+	uint8_t valid;
+};
+///	integer results in native units of Bosch formulas, without float operations (MCU without FPU)
+struct tpFixed_stru {
+	int32_t		temp1;		///	0.01 C
+	uint32_t	pres1;		///	Pa/256
+	uint8_t		valid;
+};
+struct tphFixed_stru {
+	int32_t		temp1;		///	0.01 C
+	uint32_t	pres1;		///	Pa/256
+	uint32_t	humi1;		///	0.001 %RH
+	uint8_t		valid;
+};
+struct tphgFixed_stru {
+	int32_t		temp1;		///	0.01 C
+	uint32_t	pres1;		///	Pa
+	uint32_t	humi1;		///	0.001 %RH
+	uint32_t	gasr1;		///	Ohm
+	uint8_t		valid;
+};
+
+///	validity flags of raw adc values, P and H need t_fine of T
+inline uint8_t gf_valid(uint32_t adc_T, uint32_t adc_P) {
+	if (adc_T == cd_ADC_SKIP) return 0;
+	return cd_VAL_T | (adc_P != cd_ADC_SKIP ? cd_VAL_P : 0);
+}
+inline uint8_t gf_valid(uint32_t adc_T, uint32_t adc_P, uint32_t adc_H) {
+	if (adc_T == cd_ADC_SKIP) return 0;
+	return cd_VAL_T | (adc_P != cd_ADC_SKIP ? cd_VAL_P : 0) | (adc_H != cd_ADC_SKIP_H ? cd_VAL_H : 0);
+}
+///	BME680 flags of reg 0x2B: bit <5> gas_valid_r, bit <4> heat_stab_r
+inline uint8_t gf_validGas(uint8_t lp_reg2B) {
+	return ((lp_reg2B & 0x20) ? cd_VAL_G : 0) | ((lp_reg2B & 0x10) ? cd_VAL_HEAT : 0);
+}
+
+#define cd_HEAT_MAXSTEP		10		///	BME680 heater set points 0..9
+struct heatProfile_stru {	///	BME680 heater profile: steps (set points) 0..nStep-1, one step per measuring
+	uint8_t		nStep;		///	1..cd_HEAT_MAXSTEP
+	uint16_t	temp[cd_HEAT_MAXSTEP];		///	target temperature of heating, C
+	uint16_t	duration[cd_HEAT_MAXSTEP];	///	time of heating, ms
+};
+
+#ifndef cd_DEF_BUS			///	default bus transport of classes cl_BMP280, cl_BME280, cl_BME680
+#ifdef ARDUINO
+#define cd_DEF_BUS		cl_WireBus
+#else
+#define cd_DEF_BUS		cl_SimBus
+#endif
+#endif
+
+struct busStat_stru {		///	bus statistics of sensor object
+	uint32_t	trans;		///	number of transactions (i2c start..stop)
+	uint32_t	bytes;		///	number of bytes: register address + data, without i2c address
+};
+
+struct calibBMP280_stru {	/// calibration data (coefficients) BMP280, regs 0x88..0x9F
+	uint16_t	T1;
+	int16_t		T2;
+	int16_t		T3;
+	uint16_t	P1;
+	int16_t		P2;
+	int16_t		P3;
+	int16_t		P4;
+	int16_t		P5;
+	int16_t		P6;
+	int16_t		P7;
+	int16_t		P8;
+	int16_t		P9;
+};
+struct calibBME280_stru {	/// calibration data (coefficients) BME280, regs 0x88..0xA1, 0xE1..0xE7
+	uint16_t	T1;
+	int16_t		T2;
+	int16_t		T3;
+	uint16_t	P1;
+	int16_t		P2;
+	int16_t		P3;
+	int16_t		P4;
+	int16_t		P5;
+	int16_t		P6;
+	int16_t		P7;
+	int16_t		P8;
+	int16_t		P9;
+	uint8_t		H1;
+	int16_t		H2;
+	uint8_t		H3;
+	int16_t		H4;
+	int16_t		H5;
+	int8_t		H6;
+};
+struct calibBME680_stru {	/// calibration data (coefficients) BME680, regs 0x8A..0xA0, 0xE1..0xEE
+	uint16_t 	T1;
+	int16_t		T2;
+	int8_t		T3;
+
+	uint16_t	P1;
+	int16_t		P2;
+	int8_t		P3;
+	int16_t		P4;
+	int16_t		P5;
+	int8_t		P6;
+	int8_t		P7;
+	int16_t		P8;
+	int16_t		P9;
+	uint8_t		P10;
+
+	uint16_t	H1;
+	uint16_t	H2;
+	int8_t		H3;
+	int8_t		H4;
+	int8_t		H5;
+	uint8_t		H6;
+	int8_t		H7;
+
+	int8_t		G1;
+	int16_t		G2;
+	int8_t		G3;
+
+	int8_t		res_heat_val;	///	factory constants of heater and gas ADC, regs 0x00, 0x02, 0x04
+	uint8_t		res_heat_range;
+	int8_t		range_sw_err;
+};
+
+///	table of accelerated humidity (gf_humTab()): terms of humidity formula, that depend only on temperature,
+///	at nodes of working range -40..85 C, per sample they are interpolated instead of multiplies and divisions
+#define cd_HNODE_280	1		///	int32_t values per node: BME280 gain, BME680 offset, gain, quadratic term
+#define cd_HNODE_680	3
+struct humTab_stru {
+	int32_t		*val;		///	values of nodes (user array), n * cd_HNODE_280 or n * cd_HNODE_680
+	int32_t		t0;			///	temperature of node 0: t_fine (BME280) or 0.01 C (BME680)
+	uint8_t		n;			///	number of nodes (min 3), 0 = no table (formula)
+	uint8_t		shift;		///	step of nodes = 1 << shift
+	uint8_t		fracSh;		///	low bits of position between nodes, that are not used (product fits 32 bit)
+};
+
+///	precompiled calibration data: constant terms of formulas are folded once by gf_precalc() (in begin()),
+///	suffix sN of field is shift of coefficient, for ex. P4s35 = P4 << 35
+struct preBMP280_stru {
+	int32_t		T1;
+	int32_t		T1s1;
+	int32_t		T2;
+	int32_t		T3;
+	int64_t		P1;
+	int64_t		P2;
+	int64_t		P3;
+	int64_t		P4s35;
+	int64_t		P5;
+	int64_t		P6;
+	int64_t		P7s4;
+	int64_t		P8;
+	int64_t		P9;
+};
+struct preBME280_stru {
+	int32_t		T1;
+	int32_t		T1s1;
+	int32_t		T2;
+	int32_t		T3;
+	int64_t		P1;
+	int64_t		P2;
+	int64_t		P3;
+	int64_t		P4s35;
+	int64_t		P5;
+	int64_t		P6;
+	int64_t		P7s4;
+	int64_t		P8;
+	int64_t		P9;
+	int32_t		H1;
+	int32_t		H2;
+	int32_t		H3;
+	int32_t		H4s20;
+	int32_t		H5;
+	int32_t		H6;
+	const humTab_stru *htab;	///	table of accelerated humidity, NULL = formula (gf_precalc() sets NULL)
+};
+struct preBME680_stru {
+	int32_t		T1s1;
+	int32_t		T2;
+	int32_t		T3s4;
+	int32_t		P1;
+	int32_t		P2;
+	int32_t		P3s5;
+	int32_t		P4s16;
+	int32_t		P5;
+	int32_t		P6;
+	int32_t		P7s7;
+	int32_t		P8;
+	int32_t		P9;
+	int32_t		P10;
+	int32_t		H1s4;
+	int32_t		H2;
+	int32_t		H3;
+	int32_t		H4;
+	int32_t		H5;
+	int32_t		H6s7;
+	int32_t		H7;
+	const humTab_stru *htab;	///	table of accelerated humidity, NULL = formula (gf_precalc() sets NULL)
+	int32_t		gasVar1[16];	///	terms var1, var3 of gas formula for each gas_range
+	int64_t		gasVar3[16];
 };
 
 //================================================
-//		class cl_BMP280
+//		Bus independent functions: parse calibration registers and compensate raw data (adc_*)
+//================================================
+void gf_parseCalib(calibBMP280_stru &lp_cd, const uint8_t *lp_regs88);	/// 24 regs from 0x88
+void gf_parseCalib(calibBME280_stru &lp_cd, const uint8_t *lp_regs88, const uint8_t *lp_regsE1);	/// 26 regs from 0x88, 7 from 0xE1
+void gf_parseCalib(calibBME680_stru &lp_cd, const uint8_t *lp_regs8A, const uint8_t *lp_regsE1,
+		const uint8_t *lp_regs00);	/// 23 regs from 0x8A, 14 from 0xE1, 5 from 0x00
+///	portable (little endian, without padding) image of calibration data, return size of image, bytes
+#define cd_CALIB_MAXLEN		40		///	max size of calibration image
+uint8_t gf_packCalib(const calibBMP280_stru &lp_cd, uint8_t *lp_buf);
+uint8_t gf_packCalib(const calibBME280_stru &lp_cd, uint8_t *lp_buf);
+uint8_t gf_packCalib(const calibBME680_stru &lp_cd, uint8_t *lp_buf);
+uint8_t gf_unpackCalib(calibBMP280_stru &lp_cd, const uint8_t *lp_buf);
+uint8_t gf_unpackCalib(calibBME280_stru &lp_cd, const uint8_t *lp_buf);
+uint8_t gf_unpackCalib(calibBME680_stru &lp_cd, const uint8_t *lp_buf);
+uint8_t gf_calibLen(uint8_t lp_codeChip);	/// size of image of chip, 0 if chip is unknown
+///	state of sensor object for fast resume() after deep sleep, saveState(), little endian:
+///	version (1), chip code (1), i2c address (1), size of calibration image n (1), shadow of config regs (6),
+///	bits of known shadow regs (1), measTime us (4), heating time us (4, BME680), calibration image (n), CRC-16 (2)
+#define cd_BLOB_VERSION		1
+#define cd_BLOB_HDRLEN		19		///	size of blob without calibration image and CRC
+#define cd_BLOB_MAXLEN		(cd_BLOB_HDRLEN + cd_CALIB_MAXLEN + 2)	///	max size of blob, for ex. RTC_DATA_ATTR uint8_t blob[cd_BLOB_MAXLEN]
+uint16_t	gf_crc16(const uint8_t *lp_buf, uint16_t lp_n);	/// CRC-16/CCITT (poly 0x1021, init 0xFFFF)
+uint8_t		gf_blobCheck(const uint8_t *lp_blob);	/// size of blob, 0 if version, size or CRC is wrong
+void gf_precalc(preBMP280_stru &lp_pc, const calibBMP280_stru &lp_cd);	/// precompile calibration data
+void gf_precalc(preBME280_stru &lp_pc, const calibBME280_stru &lp_cd);
+void gf_precalc(preBME680_stru &lp_pc, const calibBME680_stru &lp_cd);
+///	build table in lp_ht.val of lp_ht.n nodes (n < 3 - no table) and attach it to lp_pc, gf_compH() then uses it
+///	(max deviation from formula with 16 nodes at -40..85 C, 0..95 %RH: BME280 0.005 %RH, BME680 0.06 %RH,
+///	see extras/sweep_comp.cpp), call after each gf_precalc()
+void gf_humTab(humTab_stru &lp_ht, preBME280_stru &lp_pc);
+void gf_humTab(humTab_stru &lp_ht, preBME680_stru &lp_pc);
+///	compensation by precompiled calibration data (fast, for many samples)
+tp_stru		gf_compTP(const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+tph_stru	gf_compTPH(const preBME280_stru &lp_pc, int32_t adc_T, int32_t adc_P, int32_t adc_H);
+tphg_stru	gf_compTPHG(const preBME680_stru &lp_pc, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+				uint32_t adc_G, uint8_t gas_range);
+tpFixed_stru	gf_compTP_fixed(const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+tphFixed_stru	gf_compTPH_fixed(const preBME280_stru &lp_pc, int32_t adc_T, int32_t adc_P, int32_t adc_H);
+tphgFixed_stru	gf_compTPHG_fixed(const preBME680_stru &lp_pc, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+				uint32_t adc_G, uint8_t gas_range);
+int32_t		gf_compT(const preBMP280_stru &lp_pc, int32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const preBMP280_stru &lp_pc, uint32_t adc_P, int32_t t_fine);	/// Pa/256
+int32_t		gf_compT(const preBME280_stru &lp_pc, int32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const preBME280_stru &lp_pc, int32_t adc_P, int32_t t_fine);	/// Pa/256
+uint32_t	gf_compH(const preBME280_stru &lp_pc, int32_t adc_H, int32_t t_fine);	/// %RH/1024
+int32_t		gf_compT(const preBME680_stru &lp_pc, uint32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const preBME680_stru &lp_pc, uint32_t adc_P, int32_t t_fine);	/// Pa
+int32_t		gf_compH(const preBME680_stru &lp_pc, uint32_t adc_H, int32_t temp_comp);	/// 0.001 %RH
+uint32_t	gf_compG(const preBME680_stru &lp_pc, uint32_t adc_G, uint8_t gas_range);	/// Ohm
+///	the same by calibration data, it is precompiled on each call (for single calls)
+tp_stru		gf_compTP(const calibBMP280_stru &lp_cd, int32_t adc_T, uint32_t adc_P);
+tph_stru	gf_compTPH(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t adc_P, int32_t adc_H);
+tphg_stru	gf_compTPHG(const calibBME680_stru &lp_cd, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+				uint32_t adc_G, uint8_t gas_range);
+tpFixed_stru	gf_compTP_fixed(const calibBMP280_stru &lp_cd, int32_t adc_T, uint32_t adc_P);
+tphFixed_stru	gf_compTPH_fixed(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t adc_P, int32_t adc_H);
+tphgFixed_stru	gf_compTPHG_fixed(const calibBME680_stru &lp_cd, uint32_t adc_T, uint32_t adc_P, uint32_t adc_H,
+				uint32_t adc_G, uint8_t gas_range);
+int32_t		gf_compT(const calibBMP280_stru &lp_cd, int32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const calibBMP280_stru &lp_cd, uint32_t adc_P, int32_t t_fine);	/// Pa/256
+int32_t		gf_compT(const calibBME280_stru &lp_cd, int32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const calibBME280_stru &lp_cd, int32_t adc_P, int32_t t_fine);	/// Pa/256
+uint32_t	gf_compH(const calibBME280_stru &lp_cd, int32_t adc_H, int32_t t_fine);	/// %RH/1024
+int32_t		gf_compT(const calibBME680_stru &lp_cd, uint32_t adc_T, int32_t &t_fine);	/// 0.01 C
+uint32_t	gf_compP(const calibBME680_stru &lp_cd, uint32_t adc_P, int32_t t_fine);	/// Pa
+int32_t		gf_compH(const calibBME680_stru &lp_cd, uint32_t adc_H, int32_t temp_comp);	/// 0.001 %RH
+uint32_t	gf_compG(const calibBME680_stru &lp_cd, uint32_t adc_G, uint8_t gas_range);	/// Ohm
+///	batch compensation of arrays (structure of arrays), output arrays of P H G may be NULL
+void gf_compBatch(const calibBMP280_stru &lp_cd, const int32_t *adc_T, const uint32_t *adc_P, uint32_t lp_n,
+		int32_t *temp, uint32_t *pres);
+void gf_compBatch(const calibBME280_stru &lp_cd, const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+		uint32_t lp_n, int32_t *temp, uint32_t *pres, uint32_t *humi);
+void gf_compBatch(const calibBME680_stru &lp_cd, const uint32_t *adc_T, const uint32_t *adc_P, const uint32_t *adc_H,
+		const uint32_t *adc_G, const uint8_t *gas_range, uint32_t lp_n,
+		int32_t *temp, uint32_t *pres, int32_t *humi, uint32_t *gasr);
+uint8_t		gf_gasWait(uint16_t lp_duration);	/// code of reg gas_wait_X for heating time, ms
+uint8_t		gf_resHeat(const calibBME680_stru &lp_cd, uint16_t lp_tagTemp, int16_t lp_ambTemp);	/// code of reg res_heat_X
+
+//================================================
+//		Time of forced measuring by settings of begin() (datasheet formulas, max values), for start() / poll()
+//================================================
+///	number of samples for oversampling value cd_OS_OFF..cd_OS_x16
+constexpr uint8_t gf_osCount(uint8_t lp_os) {
+	return lp_os == cd_OS_OFF ? 0 : (lp_os >= cd_OS_x16 ? 16 : (uint8_t)(1 << (lp_os - 1)));
+}
+///	BMP280, BME280 (osrs_h = cd_OS_OFF for BMP280), us: 1.25 + 2.3*T + (2.3*P + 0.575) + (2.3*H + 0.575) ms
+constexpr uint32_t gf_measTime280(uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH) {
+	return 1250 + 2300UL * gf_osCount(lp_osT) + (lp_osP ? 2300UL * gf_osCount(lp_osP) + 575 : 0)
+		+ (lp_osH ? 2300UL * gf_osCount(lp_osH) + 575 : 0);
+}
+///	BME680 T P H without heater, us (as Bosch BME68x API): 1963 us per sample, 4 + 5 switching times, wake up
+constexpr uint32_t gf_measTime680(uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH) {
+	return 1963UL * (gf_osCount(lp_osT) + gf_osCount(lp_osP) + gf_osCount(lp_osH)) + 477UL * 4 + 477UL * 5 + 1000;
+}
+///	heating time of code of reg gas_wait_X (gf_gasWait()), ms
+constexpr uint16_t gf_gasWaitTime(uint8_t lp_code) {
+	return (uint16_t)((lp_code & 0x3F) << (2 * (lp_code >> 6)));
+}
+
+#define cd_ST_IDLE		0		///	states of asynchronous measuring start() / poll(): no measuring or bus error
+#define cd_ST_WAIT		1		///	conversion, bus is not used until deadline
+#define cd_ST_READY		2		///	raw data are read, result() compensates it
+#define cd_POLL_RETRY	1000	///	if sensor is still busy at deadline, next check after it, us
+#define cd_RESET_POLL	20		///	max reads of chip id / status after soft reset in check(), until sensor is ready
+#define cd_SHADOW_N		6		///	shadow of config regs 0xF0..0xF5 (BMx280) or 0x70..0x75 (BME680)
+#define cd_RETRY_BACKOFF	100		///	default wait before the first retry of failed transaction, us (setRetry())
+
+//================================================
+//		Compensation backends, parameter T_comp of sensor classes, resolved at compile time:
+//		each backend has static functions compTP, compTPH, compTPHG (float results T C, P Pa, H %RH, G kOhm)
+//================================================
+class cl_compInt32 {	///	32 bit integer formulas (AVR), BMx280 pressure Pa, default of cl_BME680
+public:
+	static tp_stru compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+	static tph_stru compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H);
+	static tphg_stru compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range);
+};
+class cl_compInt64 {	///	BMx280 pressure by 64 bit integer formula, default of cl_BMP280, cl_BME280
+public:					///	(BME680 has only 32 bit integer formulas, the same as cl_compInt32)
+	static tp_stru compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+	static tph_stru compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H);
+	static tphg_stru compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range);
+};
+class cl_compFloat {	///	float formulas (MCU with FPU: ESP32, Cortex-M4F)
+public:
+	static tp_stru compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+	static tph_stru compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H);
+	static tphg_stru compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range);
+};
+class cl_compDouble {	///	double formulas, reference
+public:
+	static tp_stru compTP(const calibBMP280_stru &lp_cd, const preBMP280_stru &lp_pc, int32_t adc_T, uint32_t adc_P);
+	static tph_stru compTPH(const calibBME280_stru &lp_cd, const preBME280_stru &lp_pc,
+		int32_t adc_T, int32_t adc_P, int32_t adc_H);
+	static tphg_stru compTPHG(const calibBME680_stru &lp_cd, const preBME680_stru &lp_pc,
+		uint32_t adc_T, uint32_t adc_P, uint32_t adc_H, uint32_t adc_G, uint8_t gas_range);
+};
+
+//================================================
+//		Instrumentation policies, parameter T_instr of sensor classes, resolved at compile time:
+//		static clock(), bus(bytes, ok, t0), poll(), retry(), comp(t0), gas(reg 0x2B), busStat(), clear().
+//		Empty hooks are removed by compiler, user policy (callback) is a class with the same methods.
 //================================================
-class cl_BMP280 {
+#ifndef cd_INSTR_CLOCK		///	clock of timers of cl_instrFull, for ex. #define cd_INSTR_CLOCK() (DWT->CYCCNT) - CPU cycles
+#ifdef ARDUINO
+#define cd_INSTR_CLOCK()	micros()
+#else
+#define cd_INSTR_CLOCK()	gf_hostClock()
+#endif
+#endif
+
+#ifndef ARDUINO
+uint32_t gf_hostClock(void);		///	ns of steady clock of host (Linux), clock of cl_instrFull
+uint32_t gf_hostMicros(void);		///	us of steady clock of host (Linux), clock of retries
+#endif
+void gf_waitUs(uint32_t lp_us);		///	wait between retries of failed transaction, us
+
+#ifndef cd_RETRY_CLOCK		///	clock of latency budget of retries, us
+#ifdef ARDUINO
+#define cd_RETRY_CLOCK()	micros()
+#else
+#define cd_RETRY_CLOCK()	gf_hostMicros()
+#endif
+#endif
+
+struct instrStat_stru {		///	statistics of cl_instrFull, times are in ticks of cd_INSTR_CLOCK() (us by micros())
+	uint32_t	trans;		///	number of transactions (i2c start..stop, SPI CS low..high), with probe of check()
+	uint32_t	bytes;		///	number of bytes: register address + data, without i2c address
+	uint32_t	errors;		///	failed transactions: NACK, short read, bus error
+	uint32_t	busTime;	///	time of transactions
+	uint32_t	polls;		///	status reads with sensor still measuring: isMeas() = TRUE, poll() at deadline is too early
+	uint32_t	compN;		///	number of compensations of raw data (read*(), result*(), compRaw*())
+	uint32_t	compTime;	///	time of compensations
+	uint32_t	gasInvalid;	///	BME680 compensated samples with gas_valid_r = 0
+	uint32_t	heatUnstable;	///	BME680 compensated samples with heat_stab_r = 0
+	uint32_t	retries;	///	repeated transactions after failed ones (setRetry())
+};
+
+class cl_instrNone {		///	no instrumentation, busStat() is 0, the smallest and fastest code
+public:
+	static uint32_t clock(void) { return 0; }
+	void bus(uint8_t lp_bytes, bool lp_ok, uint32_t lp_t0) { (void)lp_bytes; (void)lp_ok; (void)lp_t0; }
+	void poll(void) {}
+	void retry(void) {}
+	void comp(uint32_t lp_t0) { (void)lp_t0; }
+	void gas(uint8_t lp_reg2B) { (void)lp_reg2B; }
+	busStat_stru busStat(void) { busStat_stru lv_st = { 0, 0 }; return lv_st; }
+	void clear(void) {}
+};
+
+class cl_instrBus : public cl_instrNone {	///	counters of transactions and bytes only, default (cd_DEF_INSTR)
 private:
+	busStat_stru clv_st;
+
+public:
+	void bus(uint8_t lp_bytes, bool lp_ok, uint32_t lp_t0) {
+		(void)lp_ok; (void)lp_t0;
+		clv_st.trans++;
+		clv_st.bytes += lp_bytes;
+	}
+	busStat_stru busStat(void) { return clv_st; }
+	void clear(void) { clv_st.trans = 0; clv_st.bytes = 0; }
+};
+
+class cl_instrFull {		///	all counters and timers of instrStat_stru, read by stat()
+private:
+	instrStat_stru clv_st;
+
+public:
+	static uint32_t clock(void) { return cd_INSTR_CLOCK(); }
+	void bus(uint8_t lp_bytes, bool lp_ok, uint32_t lp_t0) {
+		clv_st.trans++;
+		clv_st.bytes += lp_bytes;
+		if (!lp_ok) clv_st.errors++;
+		clv_st.busTime += clock() - lp_t0;
+	}
+	void poll(void) { clv_st.polls++; }
+	void retry(void) { clv_st.retries++; }
+	void comp(uint32_t lp_t0) {
+		clv_st.compN++;
+		clv_st.compTime += clock() - lp_t0;
+	}
+	void gas(uint8_t lp_reg2B) {		///	reg 0x2B bit <5> gas_valid_r, bit <4> heat_stab_r
+		if (!(lp_reg2B & 0x20)) clv_st.gasInvalid++;
+		if (!(lp_reg2B & 0x10)) clv_st.heatUnstable++;
+	}
+	busStat_stru busStat(void) { busStat_stru lv_st = { clv_st.trans, clv_st.bytes }; return lv_st; }
+	const instrStat_stru &stat(void) { return clv_st; }
+	void clear(void) { memset(&clv_st, 0, sizeof(clv_st)); }
+};
+
+#ifndef cd_DEF_INSTR		///	default instrumentation of classes cl_BMP280, cl_BME280, cl_BME680
+#define cd_DEF_INSTR	cl_instrBus
+#endif
+
+//================================================
+//		Chip traits, parameter T_chip of cl_BMxx80_T: register map and calibration layout of chip,
+//		constants are resolved at compile time, so object has only state and code of its own chip
+//================================================
+class cl_chipBMP280 {
+public:
+	typedef calibBMP280_stru	calib_t;	///	calibration data
+	typedef preBMP280_stru		pre_t;		///	precompiled calibration data
+	static constexpr uint8_t code = cd_BMP280;
+	static constexpr uint8_t addr = 0x77;		///	default i2c address
+	static constexpr uint8_t regShadow = 0xF0;	///	first reg of shadow of config regs
+	static constexpr uint8_t maskWrite = 0x30;	///	bits of writable regs of shadow: 0xF4 ctrl_meas, 0xF5 config
+	static constexpr uint8_t regCtrl = 0xF4;	///	ctrl_meas, mode bits <1:0>
+	static constexpr uint8_t regStatus = 0xF3;
+	static constexpr uint8_t maskMeas = 0x08;	///	status bit <3> measuring (isMeas())
+	static constexpr uint8_t maskReady = 0x09;	///	data are ready, when (status & maskReady) == valReady (poll()):
+	static constexpr uint8_t valReady = 0x00;	///	bits <3> measuring, <0> im_update = 0
+	static constexpr uint8_t regData = 0xF7;	///	raw data adc_ P T
+	static constexpr uint8_t nData = 6;
+	static constexpr uint8_t regCal0 = 0x88, nCal0 = 24;	///	blocks of calibration regs
+	static constexpr uint8_t regCal1 = 0x00, nCal1 = 0;
+	static constexpr uint8_t regCal2 = 0x00, nCal2 = 0;
+	static void parse(calib_t &lp_cd, const uint8_t *lp_regs) { gf_parseCalib(lp_cd, lp_regs); }	/// blocks one by one
+};
+
+class cl_chipBME280 {
+public:
+	typedef calibBME280_stru	calib_t;
+	typedef preBME280_stru		pre_t;
+	static constexpr uint8_t code = cd_BME280;
+	static constexpr uint8_t addr = 0x76;
+	static constexpr uint8_t regShadow = 0xF0;
+	static constexpr uint8_t maskWrite = 0x34;	///	0xF2 ctrl_hum, 0xF4, 0xF5
+	static constexpr uint8_t regCtrl = 0xF4;
+	static constexpr uint8_t regStatus = 0xF3;
+	static constexpr uint8_t maskMeas = 0x08;
+	static constexpr uint8_t maskReady = 0x09;
+	static constexpr uint8_t valReady = 0x00;
+	static constexpr uint8_t regData = 0xF7;	///	raw data adc_ P T H
+	static constexpr uint8_t nData = 8;
+	static constexpr uint8_t regCal0 = 0x88, nCal0 = 26;
+	static constexpr uint8_t regCal1 = 0xE1, nCal1 = 7;
+	static constexpr uint8_t regCal2 = 0x00, nCal2 = 0;
+	static void parse(calib_t &lp_cd, const uint8_t *lp_regs) { gf_parseCalib(lp_cd, lp_regs, lp_regs + nCal0); }
+};
+
+class cl_chipBME680 {
+public:
+	typedef calibBME680_stru	calib_t;
+	typedef preBME680_stru		pre_t;
+	static constexpr uint8_t code = cd_BME680;
+	static constexpr uint8_t addr = 0x77;
+	static constexpr uint8_t regShadow = 0x70;	///	regs 0x70..0x75
+	static constexpr uint8_t maskWrite = 0x37;	///	0x70..0x72 ctrl_gas, ctrl_hum, 0x74, 0x75 (0x73 is not config)
+	static constexpr uint8_t regCtrl = 0x74;
+	static constexpr uint8_t regStatus = 0x1D;
+	static constexpr uint8_t maskMeas = 0x60;	///	bits <6> gas_measuring, <5> measuring
+	static constexpr uint8_t maskReady = 0xE0;	///	bit <7> new_data_0 = 1, <6> gas_measuring = 0, <5> measuring = 0
+	static constexpr uint8_t valReady = 0x80;
+	static constexpr uint8_t regData = 0x1F;	///	raw data adc_ P T H G, gas_range, gas_valid_r, heat_stab_r
+	static constexpr uint8_t nData = 13;
+	static constexpr uint8_t regCal0 = 0x8A, nCal0 = 23;
+	static constexpr uint8_t regCal1 = 0xE1, nCal1 = 14;
+	static constexpr uint8_t regCal2 = 0x00, nCal2 = 5;		///	heater and gas ADC constants 0x00..0x04
+	static void parse(calib_t &lp_cd, const uint8_t *lp_regs) {
+		gf_parseCalib(lp_cd, lp_regs, lp_regs + nCal0, lp_regs + nCal0 + nCal1);
+	}
+};
+
+//================================================
+//		class cl_BMxx80_T, common part of sensors: bus, shadow of config regs, retries, asynchronous measuring,
+//		calibration data of chip T_chip. Classes of chips inherit it and add compensation of their raw data.
+//================================================
+template <class T_chip, class T_bus = cd_DEF_BUS, class T_instr = cd_DEF_INSTR>
+class cl_BMxx80_T {
+protected:
+	T_bus	*clv_bus;			/// bus transport, methods are called directly (static dispatch)
 	uint8_t clv_i2cAddr;
 	uint8_t clv_codeChip;
-	struct {		/// clv_cd = structure of calibration data (coefficients)
-		uint16_t	T1;
-		int16_t		T2;
-		int16_t		T3;
-		uint16_t	P1;
-		int16_t		P2;
-		int16_t		P3;
-		int16_t		P4;
-		int16_t		P5;
-		int16_t		P6;
-		int16_t		P7;
-		int16_t		P8;
-		int16_t		P9;
-	} clv_cd;
-	void clf_readCalibData(void);	/// read calibration coeff, datas
+	T_instr clv_instr;			/// instrumentation: counters, timers or nothing (cl_instrNone)
+	uint8_t clv_state;			/// state of asynchronous measuring: cd_ST_IDLE, cd_ST_WAIT, cd_ST_READY
+	uint32_t clv_deadline;		/// expected end of conversion, us
+	uint32_t clv_measTime;		/// max time of forced measuring by settings of begin(), us
+	uint8_t clv_raw[T_chip::nData];	/// raw data read by poll() from T_chip::regData
+	uint8_t clv_shadow[cd_SHADOW_N];	/// last value written (or set by setReg()) of config regs from T_chip::regShadow
+	uint8_t clv_dirty;			/// bit i = clv_shadow[i] is set, but not written to sensor, flush() writes it
+	uint8_t clv_known;			/// bit i = clv_shadow[i] is the same as reg of sensor (written or read by resync())
+	uint32_t clv_budget;		/// latency budget of retries of failed transaction, us, 0 = no retries
+	uint16_t clv_backoff;		/// wait before the first retry, us
+	uint8_t clv_backMul;		/// multiplier of wait after each retry
+	bool clv_calib;				/// calibration data are read (begin(), resume()), else results are not valid
+	typename T_chip::calib_t clv_cd;	/// clv_cd = structure of calibration data (coefficients)
+	typename T_chip::pre_t clv_pc;		/// clv_cd precompiled by begin(), used by compensation
+	void clf_init(void) {
+		clv_i2cAddr = T_chip::addr;
+		clv_codeChip = 0;		///	default code chip 0 => not found.
+		clv_state = cd_ST_IDLE;
+		clv_measTime = 0;		///	it is set by begin()
+		memset(clv_shadow, 0, cd_SHADOW_N);
+		clv_dirty = 0;
+		clv_known = 0;			///	shadow is unknown until write or resync()
+		clv_calib = false;		///	results are not valid until begin()
+		setRetry(0);			///	one attempt of each transaction
+		clearBusStat();
+	}
+	void clf_trigger(uint8_t lp_reg, uint8_t lp_mode) {	/// set mode bits <1:0> of ctrl_meas, written by flush() always
+		uint8_t i = lp_reg - T_chip::regShadow;
+		clv_shadow[i] = (clv_shadow[i] & 0xFC) | lp_mode;
+		clv_dirty |= 1 << i;
+	}
+	uint32_t clf_start(uint32_t lp_now) {	/// conversion is started, set deadline
+		clv_deadline = lp_now + clv_measTime;
+		clv_state = cd_ST_WAIT;
+		return clv_deadline;
+	}
+	bool clf_poll(uint32_t lp_now);		/// read status and data at deadline, TRUE when data are in clv_raw
+	bool clf_backoff(uint32_t lp_start, uint32_t &lp_wait);	/// wait before retry, FALSE if latency budget is over
+	bool clf_readRegs(uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n) {	/// burst read from sensor, with retries
+		uint32_t lv_start = clv_budget ? cd_RETRY_CLOCK() : 0, lv_wait = clv_backoff;
+		for (;;) {
+			uint32_t lv_t0 = T_instr::clock();
+			bool lv_ok = clv_bus->readRegs(clv_i2cAddr, lp_reg, lp_buf, lp_n);
+			clv_instr.bus(1 + lp_n, lv_ok, lv_t0);
+			if (lv_ok || !clf_backoff(lv_start, lv_wait)) return lv_ok;
+		}
+	}
+	bool clf_writeRegs(const uint8_t *lp_pairs, uint8_t lp_npairs);	/// burst write of pairs {reg, data}
+	bool clf_readCalibData(void);	/// read calibration blocks of T_chip, parse and precompile it
+	uint8_t clf_saveState(uint8_t *lp_blob, uint32_t lp_heatTime);
+	bool clf_resume(const uint8_t *lp_blob, uint32_t &lp_heatTime);	/// check blob and chip, restore shadow, calibration
+	bool clf_resumeMeas(uint32_t lp_now) {	/// write known config regs with FORCED mode at once
+		clv_dirty = clv_known & T_chip::maskWrite;	///	not reserved and read only regs of shadow
+		clf_trigger(T_chip::regCtrl, cd_FOR_MODE);
+		if (!flush()) return false;
+		clf_start(lp_now);
+		return true;
+	}
 
 public:
-	cl_BMP280() {				///	default class constructor
-		clv_i2cAddr = 0x77;		///	default BMP280 i2c address
-		clv_codeChip = 0;		///	default code chip 0 => not found.
+	cl_BMxx80_T() {				///	default class constructor
+		clv_bus = &T_bus::dflt();	///	default bus of transport
+		clf_init();
 	}
-	uint8_t readReg(uint8_t address);	/// read 1 byte from bme280 register by i2c
+	cl_BMxx80_T(T_bus &lp_bus) {	///	class constructor with bus, for ex. cl_WireBus(Wire1)
+		clv_bus = &lp_bus;
+		clf_init();
+	}
+	T_bus &bus(void) { return *clv_bus; }	/// bus transport of sensor
+	void setClock(uint32_t lp_hz) { clv_bus->setClock(lp_hz); }	/// set bus clock, Hz
+	busStat_stru busStat(void) { return clv_instr.busStat(); }	/// transactions and bytes since last clearBusStat()
+	void clearBusStat(void) { clv_instr.clear(); }	/// clear all counters and timers of instrumentation
+	T_instr &instr(void) { return clv_instr; }	/// instrumentation, for ex. instr().stat() of cl_instrFull
+	void setRetry(uint32_t lp_budget, uint16_t lp_backoff = cd_RETRY_BACKOFF, uint8_t lp_mul = 2) {	/// retries of failed
+		clv_budget = lp_budget;		///	transaction until latency budget, us, is over, wait lp_backoff us, then x lp_mul
+		clv_backoff = lp_backoff;
+		clv_backMul = lp_mul;
+	}
+	bool calibOk(void) { return clv_calib; }	/// TRUE if calibration data are read by begin() or resume()
+	bool readRegs(uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n) { return clf_readRegs(lp_reg, lp_buf, lp_n); }	/// burst read
+	uint8_t codeChip(void) { return clv_codeChip; }	/// chip code found by check()
+	const typename T_chip::calib_t &calib(void) { return clv_cd; }	/// calibration data read by begin()
+	uint8_t saveState(uint8_t *lp_blob) { return clf_saveState(lp_blob, 0); }	/// state after begin() to blob, return size
+	bool resume(const uint8_t *lp_blob, uint32_t lp_now);	/// instead of check(), begin(), start() after deep sleep
+	uint8_t readReg(uint8_t address);	/// read 1 byte from bme280 register by i2c, 0 if bus error
+	bool readReg(uint8_t address, uint8_t &data);	/// the same with status, TRUE if byte is read
 	bool				writeReg(uint8_t address, uint8_t data);	/// write 1 byte to bme280 register
+	bool setReg(uint8_t address, uint8_t data);	/// set config reg in shadow, it is written by flush() if changed
+	uint8_t shadowReg(uint8_t address);	/// last value of config reg in shadow (written or set by setReg())
+	bool flush(void);					/// write all changed config regs in one i2c transmission
+	bool resync(void);					/// read config regs from sensor to shadow (after reset or power loss)
 	bool				reset(void);	/// bme280 software reset 
-	uint8_t check(uint8_t lv_i2caddr);	/// function with parameter default value
+	uint8_t check(uint8_t lv_i2caddr, bool lp_reset = true);	/// function with parameter default value
 	///	check sensor with i2c address or DEFAULT i2c address, return code chip
-	void do1Meas(void);					/// DO 1 MEASurement and go to sleep (only for FORCED_MODE)
-	bool isMeas(void);					/// returns TRUE while the bme280 IS MEASuring
+	bool attach(uint8_t lp_addr, uint8_t lp_codeChip) {	/// sensor found by scan (chip id is read), instead of check()
+		if (lp_codeChip != T_chip::code) return false;	///	without bus transactions and reset, FALSE if other chip
+		clv_i2cAddr = lp_addr;
+		clv_codeChip = lp_codeChip;
+		return true;
+	}
+	bool do1Meas(void);					/// DO 1 MEASurement and go to sleep (only for FORCED_MODE)
+	bool isMeas(void);					/// returns TRUE while the sensor IS MEASuring, FALSE if bus error
+	uint32_t measTime(void) { return clv_measTime; }	/// max time of forced measuring, us
+	uint8_t state(void) { return clv_state; }		/// state of asynchronous measuring, cd_ST_*
+	bool ready(void) { return clv_state == cd_ST_READY; }	/// TRUE when poll() has read new data
+	uint32_t deadline(void) { return clv_deadline; }	/// expected end of conversion of start(), us
+	uint32_t start(uint32_t lp_now);	/// do1Meas() without waiting, return expected ready time, us (as micros())
+	bool poll(uint32_t lp_now) { return clf_poll(lp_now); }	/// read data once at ready time, TRUE when data are ready
+	bool readRaw(uint8_t *lp_regs) { return clf_readRegs(T_chip::regData, lp_regs, T_chip::nData); }	/// raw data regs
+};
 
-	void begin();						/// init BMP280 with default parameters FORCED mode and max measuring 
-	void begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p); // overloaded function init
-	tp_stru readTP(void);				/// read, calculate and return structure T, P
+//================================================
+//		class cl_BMP280
+//================================================
+template <class T_bus = cd_DEF_BUS, class T_comp = cl_compInt64, class T_instr = cd_DEF_INSTR>
+class cl_BMP280_T : public cl_BMxx80_T<cl_chipBMP280, T_bus, T_instr> {
+private:
+	static void clf_decode(const uint8_t *lp_regs, int32_t &adc_T, uint32_t &adc_P);	/// decode 6 regs from 0xF7
+
+public:
+	cl_BMP280_T() {}			///	default class constructor, default i2c address 0x77
+	cl_BMP280_T(T_bus &lp_bus) : cl_BMxx80_T<cl_chipBMP280, T_bus, T_instr>(lp_bus) {}	/// class constructor with bus
+	bool begin();						/// init BMP280 with default parameters FORCED mode and max measuring 
+	bool begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p); // overloaded function init
+	tp_stru readTP(void);				/// read, calculate (by backend T_comp) and return structure T, P
+	tpFixed_stru readTP_fixed(void);	/// the same by integer formulas, T 0.01 C, P Pa/256
+	tp_stru result(void);				/// compensate data read by poll(), like readTP()
+	tpFixed_stru result_fixed(void);	/// the same like readTP_fixed()
+	tp_stru compRaw(const uint8_t *lp_regs);	/// compensate regs of readRaw() (6 regs from 0xF7), like readTP()
+	tpFixed_stru compRaw_fixed(const uint8_t *lp_regs);	/// the same like readTP_fixed()
 };
 
 //================================================
-//						class cl_BME280, inherits cl_BMP280
+//						class cl_BME280
 //================================================
-class cl_BME280 : public cl_BMP280 {
+template <class T_bus = cd_DEF_BUS, class T_comp = cl_compInt64, class T_instr = cd_DEF_INSTR>
+class cl_BME280_T : public cl_BMxx80_T<cl_chipBME280, T_bus, T_instr> {
 private:
-	uint8_t clv_i2cAddr;
-	uint8_t clv_codeChip;
-	struct {			/// clv_cd = structure of calibration data (coefficients)
-		uint16_t	T1;
-		int16_t		T2;
-		int16_t		T3;
-		uint16_t	P1;
-		int16_t		P2;
-		int16_t		P3;
-		int16_t		P4;
-		int16_t		P5;
-		int16_t		P6;
-		int16_t		P7;
-		int16_t		P8;
-		int16_t		P9;
-		uint8_t		H1;
-		int16_t		H2;
-		uint8_t		H3;
-		int16_t		H4;
-		int16_t		H5;
-		int8_t		H6;
-	} clv_cd;
-	void clf_readCalibData(void);	/// read calibration coeff(data)
+	humTab_stru clv_ht;			/// table of accelerated humidity in user array, built after each gf_precalc()
+	static void clf_decode(const uint8_t *lp_regs, int32_t &adc_T, int32_t &adc_P, int32_t &adc_H);	/// 8 regs from 0xF7
 
 public:
-	cl_BME280() {					/// default class constructor
-		clv_i2cAddr = 0x76;			/// default BME280 i2c address
-		clv_codeChip = 0;			/// default code chip 0 => not found.
+	cl_BME280_T() {					/// default class constructor, default i2c address 0x76
+		humTable(NULL, 0);
+	}
+	cl_BME280_T(T_bus &lp_bus) : cl_BMxx80_T<cl_chipBME280, T_bus, T_instr>(lp_bus) {	/// class constructor with bus
+		humTable(NULL, 0);
+	}
+	void humTable(int32_t *lp_buf, uint16_t lp_len) {	/// accelerated humidity by table in user array (len / cd_HNODE_280 nodes), 0 = formula
+		clv_ht.val = lp_buf;
+		clv_ht.n = lp_len / cd_HNODE_280 > 255 ? 255 : lp_len / cd_HNODE_280;
+		gf_humTab(clv_ht, this->clv_pc);
 	}
 
-	void begin();	/// init BMx280 with default parameters FORCED mode and max measuring 
-	void begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h); // overloaded function init
-	tph_stru readTPH(void);			/// read, calculate and return structure T, P, H
+	bool begin();	/// init BMx280 with default parameters FORCED mode and max measuring 
+	bool begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h); // overloaded function init
+	bool resume(const uint8_t *lp_blob, uint32_t lp_now);	/// instead of check(), begin(), start() after deep sleep
+	tph_stru readTPH(void);			/// read, calculate (by backend T_comp) and return structure T, P, H
+	tphFixed_stru readTPH_fixed(void);	/// the same by integer formulas, T 0.01 C, P Pa/256, H 0.001 %RH
+	tph_stru result(void);			/// compensate data read by poll(), like readTPH()
+	tphFixed_stru result_fixed(void);	/// the same like readTPH_fixed()
+	tph_stru compRaw(const uint8_t *lp_regs);	/// compensate regs of readRaw() (8 regs from 0xF7), like readTPH()
+	tphFixed_stru compRaw_fixed(const uint8_t *lp_regs);	/// the same like readTPH_fixed()
 };
 
 //================================================
-//	class cl_BME680, inherits cl_BMP280
+//	class cl_BME680
 //================================================
-class cl_BME680 : public cl_BMP280 {
+template <class T_bus = cd_DEF_BUS, class T_comp = cl_compInt32, class T_instr = cd_DEF_INSTR>
+class cl_BME680_T : public cl_BMxx80_T<cl_chipBME680, T_bus, T_instr> {
 private:
-	uint8_t clv_i2cAddr;
-	uint8_t clv_codeChip;
-	struct {	/// clv_cd = structure of calibration data (coefficients)
-		uint16_t 	T1;
-		int16_t		T2;
-		int8_t		T3;
-
-		uint16_t	P1;
-		int16_t		P2;
-		int8_t		P3;
-		int16_t		P4;
-		int16_t		P5;
-		int8_t		P6;
-		int8_t		P7;
-		int16_t		P8;
-		int16_t		P9;
-		uint8_t		P10;
-
-		uint16_t	H1;
-		uint16_t	H2;
-		int8_t		H3;
-		int8_t		H4;
-		int8_t		H5;
-		uint8_t		H6;
-		int8_t		H7;
-
-		int8_t		G1;
-		int16_t		G2;
-		int8_t		G3;
-	} clv_cd;
-	void clf_readCalibData(void);	/// read calibration coeff(data)
+	humTab_stru clv_ht;			/// table of accelerated humidity in user array, built after each gf_precalc()
+	uint32_t clv_heatTime;		/// heating time of active set point, us, part of clv_measTime
+	uint8_t clv_nStep;			/// number of steps of heater profile, 0 = single set point of initGasPointX()
+	uint8_t clv_step;			/// step of profile of next (or current) measuring
+	bool clv_profDone;			/// the last step of profile is read by poll()
+	uint8_t clv_gasWait[cd_HEAT_MAXSTEP];	/// codes of regs gas_wait_X of profile
+	uint32_t clv_gasVec[cd_HEAT_MAXSTEP];	/// gas resistance of each step of profile, Ohm
+	void clf_init(void) {
+		clv_heatTime = 0;
+		clv_nStep = 0;
+		clv_step = 0;
+		clv_profDone = false;
+		humTable(NULL, 0);
+	}
+	void clf_setHeatTime(uint8_t lp_wait) {	/// heating time of code gas_wait_X is part of clv_measTime
+		this->clv_measTime -= clv_heatTime;
+		clv_heatTime = 1000UL * gf_gasWaitTime(lp_wait);
+		this->clv_measTime += clv_heatTime;
+	}
+	void clf_nextStep(void);		/// store gas resistance of step read by poll(), go to next step
+	static void clf_decode(const uint8_t *lp_regs, uint32_t &adc_T, uint32_t &adc_P, uint32_t &adc_H, uint32_t &adc_G,
+		uint8_t &gas_range);	/// decode 13 regs from 0x1F
 
 public:
-	cl_BME680() {				/// default class constructor
-		clv_i2cAddr = 0x77;		/// default BME280 i2c address
-		clv_codeChip = 0;		/// default code chip 0 => not found.
+	cl_BME680_T() {					/// default class constructor, default i2c address 0x77
+		clf_init();
+	}
+	cl_BME680_T(T_bus &lp_bus) : cl_BMxx80_T<cl_chipBME680, T_bus, T_instr>(lp_bus) {	/// class constructor with bus
+		clf_init();
+	}
+	void humTable(int32_t *lp_buf, uint16_t lp_len) {	/// accelerated humidity by table in user array (len / cd_HNODE_680 nodes), 0 = formula
+		clv_ht.val = lp_buf;
+		clv_ht.n = lp_len / cd_HNODE_680 > 255 ? 255 : lp_len / cd_HNODE_680;
+		gf_humTab(clv_ht, this->clv_pc);
 	}
-	void initGasPointX(uint8_t point = 0, uint16_t tagTemp = 350, uint16_t duration = 100, int16_t ambTemp = 20);
-	void do1Meas(void);			/// mode FORCED_MODE DO 1 Measuring}
-	bool isMeas(void);			/// returns TRUE while bme680 is Measuring
-	void begin();				/// init BMx280 with default parameters FORCED mode and max measuring 
-	void begin(uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h); // overloaded function
-	tphg_stru readTPHG(void);	/// read, calculate and return structure T, P, H, G
+	bool initGasPointX(uint8_t point = 0, uint16_t tagTemp = 350, uint16_t duration = 100, int16_t ambTemp = 20);
+	bool setHeatProfile(const heatProfile_stru &lp_prof, int16_t ambTemp = 20);	/// all set points by 2 i2c transmissions
+	uint8_t heatStep(void) { return clv_step; }		/// step of profile of next start()
+	bool profileDone(void) { return clv_profDone; }	/// TRUE after poll() of the last step, until next start()
+	const uint32_t *gasVector(void) { return clv_gasVec; }	/// gas resistance of steps of profile, Ohm
+	bool begin();				/// init BMx280 with default parameters FORCED mode and max measuring 
+	bool begin(uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h); // overloaded function
+	uint8_t saveState(uint8_t *lp_blob) { return this->clf_saveState(lp_blob, clv_heatTime); }	/// with heating time
+	bool resume(const uint8_t *lp_blob, uint32_t lp_now);	/// instead of check(), begin(), start() after deep sleep
+	tphg_stru readTPHG(void);	/// read, calculate (by backend T_comp) and return structure T, P, H, G
+	tphgFixed_stru readTPHG_fixed(void);	/// the same by integer formulas, T 0.01 C, P Pa, H 0.001 %RH, G Ohm
+	uint32_t start(uint32_t lp_now);	/// do1Meas() (next step of profile) without waiting, return expected ready time (T P H + heating), us
+	bool poll(uint32_t lp_now);		/// read data once at ready time, return TRUE when data are ready
+	tphg_stru result(void);			/// compensate data read by poll(), like readTPHG()
+	tphgFixed_stru result_fixed(void);	/// the same like readTPHG_fixed()
+	tphg_stru compRaw(const uint8_t *lp_regs);	/// compensate regs of readRaw() (13 regs from 0x1F), like readTPHG()
+	tphgFixed_stru compRaw_fixed(const uint8_t *lp_regs);	/// the same like readTPHG_fixed()
 };
 
+typedef cl_BMP280_T<>	cl_BMP280;		///	classes with default bus transport
+typedef cl_BME280_T<>	cl_BME280;
+typedef cl_BME680_T<>	cl_BME680;
+
+//============================================
+//	BMP280, BME280, BME680
+//	cl_BMxx80_T, common part of cl_BMP280, cl_BME280, cl_BME680, public metods (functions)
+//============================================
+/*	@brief	Read 1 byte from register with address,
+	@param	address is address of register to read
+	@return	1 byteb read or 0 if operation not success (use readReg(address, data) to know it)	*/
+template <class T_chip, class T_bus, class T_instr>
+uint8_t cl_BMxx80_T<T_chip, T_bus, T_instr>::readReg(uint8_t address) {
+	uint8_t lv_data;
+	if (clf_readRegs(address, &lv_data, 1)) return lv_data;
+	else return 0;
+}
+
+/*	@brief	Read 1 byte from register with address and status of bus
+	@param	address is address of register to read
+	@param	data	byte read, it is not changed if operation not success
+	@return	TRUE if operation is success	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::readReg(uint8_t address, uint8_t &data) {
+	uint8_t lv_data;
+	if (!clf_readRegs(address, &lv_data, 1)) return false;
+	data = lv_data;
+	return true;
+}
+
+/*	@brief	Wait before retry of failed transaction: backoff grows lp_mul times after each retry (setRetry()),
+	retry is not started, if its wait ends after latency budget from the first attempt
+	@param	lp_start	time of the first attempt, us (cd_RETRY_CLOCK())
+	@param	lp_wait		wait before this retry, us, it is multiplied for next one
+	@return	TRUE if transaction must be repeated, FALSE if retries are off or budget is over	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_backoff(uint32_t lp_start, uint32_t &lp_wait) {
+	if (clv_budget == 0 || (uint32_t)(cd_RETRY_CLOCK() - lp_start) + lp_wait > clv_budget) return false;
+	gf_waitUs(lp_wait);
+	lp_wait *= clv_backMul;
+	clv_instr.retry();
+	return true;
+}
+
+/*	@brief	Write 1 byte to register with address,
+	@param	address is address of register to write
+	@param	data is byte to write	
+	@return	TRUE if operation is success, otherwise FALSE	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::writeReg(uint8_t address, uint8_t data) {
+	uint8_t lv_pair[2] = { address, data };
+	return clf_writeRegs(lv_pair, 1);
+}
+
+/*	@brief	Burst write of pairs {reg, data} in one i2c transmission, written config regs are stored to shadow,
+	failed transaction is repeated in latency budget of setRetry() (writes of registers are idempotent)
+	@param	lp_pairs	pairs {address, data}
+	@param	lp_npairs	number of pairs
+	@return	TRUE if operation is success	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_writeRegs(const uint8_t *lp_pairs, uint8_t lp_npairs) {
+	uint32_t lv_start = clv_budget ? cd_RETRY_CLOCK() : 0, lv_wait = clv_backoff;
+	bool lv_ok;
+	do {
+		uint32_t lv_t0 = T_instr::clock();
+		lv_ok = clv_bus->writeRegs(clv_i2cAddr, lp_pairs, lp_npairs);
+		clv_instr.bus(2 * lp_npairs, lv_ok, lv_t0);
+	} while (!lv_ok && clf_backoff(lv_start, lv_wait));
+	if (!lv_ok) return false;
+	for (uint8_t k = 0; k < lp_npairs; k++) {
+		uint8_t i = lp_pairs[2 * k] - T_chip::regShadow;
+		if (i >= cd_SHADOW_N) continue;
+		clv_shadow[i] = lp_pairs[2 * k + 1];
+		clv_dirty &= ~(1 << i);
+		clv_known |= 1 << i;
+	}
+	return true;
+}
+
+/*	@brief	Set config register in shadow without bus transaction, flush() writes all changed regs at once
+	@param	address	0xF2, 0xF4, 0xF5 (BMx280) or 0x70..0x75 (BME680)
+	@param	data	value of register
+	@return	FALSE if register is not in shadow (use writeReg())	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::setReg(uint8_t address, uint8_t data) {
+	uint8_t i = address - T_chip::regShadow;
+	if (i >= cd_SHADOW_N) return false;
+	if (!(clv_known & (1 << i)) || clv_shadow[i] != data) clv_dirty |= 1 << i;
+	clv_shadow[i] = data;
+	return true;
+}
+
+/*	@brief	Value of config register in shadow, last written or set by setReg(), without bus transaction
+	@param	address	0xF2, 0xF4, 0xF5 (BMx280) or 0x70..0x75 (BME680)
+	@return	value or 0 if register is not in shadow	*/
+template <class T_chip, class T_bus, class T_instr>
+uint8_t cl_BMxx80_T<T_chip, T_bus, T_instr>::shadowReg(uint8_t address) {
+	uint8_t i = address - T_chip::regShadow;
+	if (i >= cd_SHADOW_N) return 0;
+	return clv_shadow[i];
+}
+
+/*	@brief	Write changed config regs (dirty) of shadow in one i2c transmission, in order of address
+	(ctrl_hum before ctrl_meas, as datasheet needs)
+	@return	TRUE if operation is success or nothing to write	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::flush(void) {
+	uint8_t lv_pairs[2 * cd_SHADOW_N];
+	uint8_t lv_n = 0;
+	for (uint8_t i = 0; i < cd_SHADOW_N; i++) {
+		if (!(clv_dirty & (1 << i))) continue;
+		lv_pairs[2 * lv_n] = T_chip::regShadow + i;
+		lv_pairs[2 * lv_n + 1] = clv_shadow[i];
+		lv_n++;
+	}
+	if (lv_n == 0) return true;
+	return clf_writeRegs(lv_pairs, lv_n);
+}
+
+/*	@brief	Read config regs of sensor to shadow in one i2c request, changes of setReg() without flush() are lost
+	@return	TRUE if operation is success	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::resync(void) {
+	if (!clf_readRegs(T_chip::regShadow, clv_shadow, cd_SHADOW_N)) return false;
+	clv_dirty = 0;
+	clv_known = (1 << cd_SHADOW_N) - 1;
+	return true;
+}
+
+/*	@brief	Save state of object to blob: chip, i2c address, shadow of config regs, measTime, calibration image, CRC
+	@param	lp_blob		buffer of cd_BLOB_MAXLEN bytes
+	@param	lp_heatTime	heating time of active set point, us (BME680), else 0
+	@return	size of blob, bytes	*/
+template <class T_chip, class T_bus, class T_instr>
+uint8_t cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_saveState(uint8_t *lp_blob, uint32_t lp_heatTime) {
+	uint8_t lv_ncalib = gf_packCalib(clv_cd, lp_blob + cd_BLOB_HDRLEN);
+	lp_blob[0] = cd_BLOB_VERSION;
+	lp_blob[1] = clv_codeChip;
+	lp_blob[2] = clv_i2cAddr;
+	lp_blob[3] = lv_ncalib;
+	memcpy(lp_blob + 4, clv_shadow, cd_SHADOW_N);
+	lp_blob[10] = clv_known;
+	for (uint8_t i = 0; i < 4; i++) {
+		lp_blob[11 + i] = (uint8_t)(clv_measTime >> (8 * i));
+		lp_blob[15 + i] = (uint8_t)(lp_heatTime >> (8 * i));
+	}
+	uint8_t lv_n = cd_BLOB_HDRLEN + lv_ncalib;
+	uint16_t lv_crc = gf_crc16(lp_blob, lv_n);
+	lp_blob[lv_n] = (uint8_t)lv_crc;
+	lp_blob[lv_n + 1] = (uint8_t)(lv_crc >> 8);
+	return lv_n + 2;
+}
+
+/*	@brief	Check blob (version, CRC), read chip id (one i2c request) and restore i2c address, shadow, measTime
+	and calibration data. Soft reset and calibration reads of check(), begin() are not done, sensor keeps its
+	registers in sleep.
+	@param	lp_heatTime	heating time of blob, us
+	@return	TRUE if state is restored, FALSE if blob is wrong or it is other chip	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_resume(const uint8_t *lp_blob, uint32_t &lp_heatTime) {
+	clv_state = cd_ST_IDLE;
+	if (gf_blobCheck(lp_blob) == 0) return false;
+	clv_i2cAddr = lp_blob[2];
+	clv_bus->begin();
+	uint8_t lv_chip;
+	if (!clf_readRegs(0xD0, &lv_chip, 1) || lv_chip != lp_blob[1]) return false;
+	if (gf_unpackCalib(clv_cd, lp_blob + cd_BLOB_HDRLEN) != lp_blob[3]) return false;
+	clv_codeChip = lv_chip;
+	memcpy(clv_shadow, lp_blob + 4, cd_SHADOW_N);
+	clv_known = lp_blob[10];
+	clv_dirty = 0;
+	clv_measTime = 0;
+	lp_heatTime = 0;
+	for (uint8_t i = 0; i < 4; i++) {
+		clv_measTime |= (uint32_t)lp_blob[11 + i] << (8 * i);
+		lp_heatTime |= (uint32_t)lp_blob[15 + i] << (8 * i);
+	}
+	gf_precalc(clv_pc, clv_cd);
+	clv_calib = true;
+	return true;
+}
+
+/*	@brief	Fast start after deep sleep instead of check(), begin(), start(): check blob, verify chip id,
+	restore calibration and start measuring (FORCED mode) with settings of blob. 2 i2c transactions.
+	@param	lp_blob	blob of saveState()
+	@param	lp_now	current time, us (micros())
+	@return	TRUE if measuring is started (then poll()), FALSE - use check(), begin()	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::resume(const uint8_t *lp_blob, uint32_t lp_now) {
+	uint32_t lv_heatTime;
+	return clf_resume(lp_blob, lv_heatTime) && clf_resumeMeas(lp_now);
+}
+
+/*	@brief	Read blocks of calibration regs of chip (T_chip::regCal*) in clv_cd var structure and precompile it
+	@return	TRUE if data are read, else results are not valid	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_readCalibData(void) {
+	uint8_t lv_regs[T_chip::nCal0 + T_chip::nCal1 + T_chip::nCal2];	// blocks one by one
+	clv_calib = false;
+	if (!clf_readRegs(T_chip::regCal0, lv_regs, T_chip::nCal0)) return false;
+	if (T_chip::nCal1 && !clf_readRegs(T_chip::regCal1, lv_regs + T_chip::nCal0, T_chip::nCal1)) return false;
+	if (T_chip::nCal2 && !clf_readRegs(T_chip::regCal2, lv_regs + T_chip::nCal0 + T_chip::nCal1, T_chip::nCal2))
+		return false;
+	T_chip::parse(clv_cd, lv_regs);
+	gf_precalc(clv_pc, clv_cd);
+	clv_calib = true;
+	return true;
+}
+
+/*	@brief	Check conection with sensor,
+	fn return chip codes: 0x58=BMP280, 0x60=BME280, 0x61=BME680.
+	i2c address 0x76, 0x77 possible for BMP280 or BME280 or BME680, note: CHECK IT ! 
+	@param	lv_i2caddr	i2c address or CS pin of SPI
+	@param	lp_reset	soft reset and wait of start up (2 ms), FALSE - sensor keeps its registers
+	@return	Chip_code is senor is present, if NO return 0	*/
+template <class T_chip, class T_bus, class T_instr>
+uint8_t cl_BMxx80_T<T_chip, T_bus, T_instr>::check(uint8_t lv_i2caddr, bool lp_reset) {
+	clv_i2cAddr = lv_i2caddr;
+	clv_bus->begin();
+	uint32_t lv_t0 = T_instr::clock();
+	bool lv_ok = clv_bus->probe(clv_i2cAddr);
+	clv_instr.bus(0, lv_ok, lv_t0);
+	if (lv_ok) {
+		if (clf_readRegs(0xD0, &clv_codeChip, 1)) {	// register address = 0xD0 of chip_id
+			if (!lp_reset) return clv_codeChip;
+			reset();
+			for (uint8_t i = 0; i < cd_RESET_POLL; i++) {	// start up after reset (2 ms), NVM is copied to regs
+				uint8_t lv_id = 0, lv_st = 0;
+				if (!clf_readRegs(0xD0, &lv_id, 1) || lv_id != clv_codeChip) continue;	// sensor does not answer yet
+				if (clv_codeChip == cd_BME680 || (clf_readRegs(0xF3, &lv_st, 1) && !(lv_st & 0x01))) break;	// im_update = 0
+			}
+			return clv_codeChip;
+		}
+	}
+	return 0;
+}
+
+/*	@brief	Software reset of bmp280, bme280, bme680. 
+	@return TRUE if write operation is OK	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::reset(void) {
+	clv_dirty = 0;
+	clv_known = 0;		// regs of sensor are default after reset, shadow is unknown until write or resync()
+	return writeReg(0xE0, 0xB6);
+}
+
+/*	@brief	Send to sensor command Start Measuring (in FORCED mode)
+	@return	TRUE if command is written	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::do1Meas(void) {
+	clf_trigger(T_chip::regCtrl, cd_FOR_MODE);		// ctrl_meas from shadow, one write without read
+	return flush();
+}
+
+/*	@brief Test if sensor is Measuring: status bit <3> measuring (BMx280), bits <6> gas_measuring, <5> measuring (BME680)
+	@return TRUE while sensor is Measuring of FALSE when it is sleep or bus error (wait loop is not stalled)	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::isMeas(void) {
+	uint8_t lv_st;
+	if (!readReg(T_chip::regStatus, lv_st)) return false;
+	bool lv_meas = (lv_st & T_chip::maskMeas) != 0;
+	if (lv_meas) clv_instr.poll();
+	return lv_meas;
+}
+
+/*	@brief	Step read of asynchronous measuring: before deadline it does nothing (bus is free),
+	at deadline it reads status register and data (T_chip::regStatus..regData + nData - 1) in one i2c request.
+	@param	lp_now	current time, us (micros()), compare is correct after overflow of time
+	@return	TRUE when data are read to clv_raw	*/
+template <class T_chip, class T_bus, class T_instr>
+bool cl_BMxx80_T<T_chip, T_bus, T_instr>::clf_poll(uint32_t lp_now) {
+	const uint8_t lv_n = T_chip::regData + T_chip::nData - T_chip::regStatus;
+	if (clv_state == cd_ST_READY) return true;
+	if (clv_state != cd_ST_WAIT || (int32_t)(lp_now - clv_deadline) < 0) return false;
+	uint8_t lv_regs[lv_n];
+	if (!clf_readRegs(T_chip::regStatus, lv_regs, lv_n)) {
+		clv_state = cd_ST_IDLE;		// something wrong with i2c connection
+		return false;
+	}
+	if ((lv_regs[0] & T_chip::maskReady) != T_chip::valReady) {		// sensor is still busy, check it once more later
+		clv_deadline = lp_now + cd_POLL_RETRY;
+		clv_instr.poll();
+		return false;
+	}
+	memcpy(clv_raw, lv_regs + lv_n - T_chip::nData, T_chip::nData);
+	clv_state = cd_ST_READY;
+	return true;
+}
+
+/*	@brief	Start measuring (FORCED mode) without waiting, time of conversion is set by begin()
+	@param	lp_now	current time, us (micros())
+	@return	expected time of end of conversion, us, then call poll(), state() is cd_ST_IDLE if bus error	*/
+template <class T_chip, class T_bus, class T_instr>
+uint32_t cl_BMxx80_T<T_chip, T_bus, T_instr>::start(uint32_t lp_now) {
+	bool lv_ok = do1Meas();
+	clf_start(lp_now);
+	if (!lv_ok) clv_state = cd_ST_IDLE;		// old data of sensor must not be read as new ones
+	return clv_deadline;
+}
+
+//============================================
+//	BMP280
+//	cl_BMP280, public metods (funcs)
+//============================================
+/*	@brief Read calibration data and Init sensor with default
+	force mode, filter value: cd_FIL_x2, stand by time 500ms, oversampling value T P : cd_OS_x16
+	@return	TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BMP280_T<T_bus, T_comp, T_instr>::begin() {
+	return begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x16, cd_OS_x16, cd_OS_x16);
+}
+
+/*	@brief Read calibration data and Init sensor with
+	@param mode		cd_FOR_MODE or cd_NOR_MODE
+	@param t_sb		time standby in cd_NOR_MODE
+	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
+	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
+	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16
+	@return	TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BMP280_T<T_bus, T_comp, T_instr>::begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p) {
+	bool lv_ok = this->clf_readCalibData();
+	this->clv_measTime = gf_measTime280(osrs_t, osrs_p, cd_OS_OFF);
+	this->setReg(0xF4, (osrs_t<<5) | (osrs_p<<2) | mode);
+	this->setReg(0xF5, (t_sb << 5) | (filter << 2) | 0x00);
+	this->clv_dirty |= 0x30;		// begin() writes all settings (regs 0xF4, 0xF5) in one i2c transmission
+	return this->flush() && lv_ok;
+}
+
+/*	@brief Decode 20 bit values adc_ P T from 6 regs 0xF7..0xFC	*/
+template <class T_bus, class T_comp, class T_instr>
+void cl_BMP280_T<T_bus, T_comp, T_instr>::clf_decode(const uint8_t *lp_regs, int32_t &adc_T, uint32_t &adc_P) {
+	adc_T = ((lp_regs[3] << 16) | (lp_regs[4] << 8) | lp_regs[5]) >> 4;
+	adc_P = ((lp_regs[0] << 16) | (lp_regs[1] << 8) | lp_regs[2]) >> 4;
+}
+
+/*	@brief Read raw data (adc_ P T) & calc it to compensate value
+	@returns compensate value of T P in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tp_stru cl_BMP280_T<T_bus, T_comp, T_instr>::readTP(void) {
+	tp_stru lv_tp = { 0, 0, 0 };
+	uint8_t lv_regs[6];
+	if (!this->readRaw(lv_regs)) return lv_tp;	// something wrong with i2c connection and return 0
+	return compRaw(lv_regs);
+}
+
+/*	@brief Read raw data (adc_ P T) & calc it to compensate value without float operations
+	@returns T 0.01 C, P Pa/256 in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tpFixed_stru cl_BMP280_T<T_bus, T_comp, T_instr>::readTP_fixed(void) {
+	tpFixed_stru lv_tp = { 0, 0, 0 };
+	uint8_t lv_regs[6];
+	if (!this->readRaw(lv_regs)) return lv_tp;	// something wrong with i2c connection and return 0
+	return compRaw_fixed(lv_regs);
+}
+
+/*	@brief Calc raw data read by poll() to compensate value
+	@returns T P in structure var, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tp_stru cl_BMP280_T<T_bus, T_comp, T_instr>::result(void) {
+	tp_stru lv_tp = { 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tp;
+	return compRaw(this->clv_raw);
+}
+
+/*	@brief Calc raw data read by poll() to compensate value without float operations
+	@returns T 0.01 C, P Pa/256 in structure var, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tpFixed_stru cl_BMP280_T<T_bus, T_comp, T_instr>::result_fixed(void) {
+	tpFixed_stru lv_tp = { 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tp;
+	return compRaw_fixed(this->clv_raw);
+}
+
+/*	@brief Calc 6 raw regs from 0xF7 (this->readRaw(), log, stream) to compensate value
+	@returns T P in structure var, valid = cd_VAL_T | cd_VAL_P of measured values		*/
+template <class T_bus, class T_comp, class T_instr>
+tp_stru cl_BMP280_T<T_bus, T_comp, T_instr>::compRaw(const uint8_t *lp_regs) {
+	int32_t  adc_T;
+	uint32_t adc_P;
+	clf_decode(lp_regs, adc_T, adc_P);
+	uint32_t lv_t0 = T_instr::clock();
+	tp_stru lv_res = T_comp::compTP(this->clv_cd, this->clv_pc, adc_T, adc_P);
+	this->clv_instr.comp(lv_t0);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P) : 0;
+	return lv_res;
+}
+
+/*	@brief Calc 6 raw regs from 0xF7 to compensate value without float operations
+	@returns T 0.01 C, P Pa/256 in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tpFixed_stru cl_BMP280_T<T_bus, T_comp, T_instr>::compRaw_fixed(const uint8_t *lp_regs) {
+	int32_t  adc_T;
+	uint32_t adc_P;
+	clf_decode(lp_regs, adc_T, adc_P);
+	uint32_t lv_t0 = T_instr::clock();
+	tpFixed_stru lv_res = gf_compTP_fixed(this->clv_pc, adc_T, adc_P);
+	this->clv_instr.comp(lv_t0);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P) : 0;
+	return lv_res;
+}
+
+//============================================
+//	BME280,
+//	cl_BME280, public metods (funcs)
+//============================================
+/*	@brief Read calibration data and Init sensor with default
+	force mode, filter value: cd_FIL_x2, stand by time 500ms, oversampling value T P H : cd_OS_x16
+	@return	TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME280_T<T_bus, T_comp, T_instr>::begin() {
+	return begin(cd_FOR_MODE, cd_SB_500MS, cd_FIL_x16, cd_OS_x16, cd_OS_x16, cd_OS_x16); // Forse mode, sleep 500ms, filter x16, t p h x16
+}
+
+/*	@brief Read calibration data and Init sensor with
+	@param mode		cd_FOR_MODE or cd_NOR_MODE
+	@param t_sb		time standby in cd_NOR_MODE
+	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
+	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
+	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16
+	@param osrs_h	oversampling value humidity: cd_OS_OFF..cd_OS_x16
+	@returns TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME280_T<T_bus, T_comp, T_instr>::begin(uint8_t mode, uint8_t t_sb, uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h) {
+	bool lv_ok = this->clf_readCalibData();
+	if (lv_ok) gf_humTab(clv_ht, this->clv_pc);	// table is built after each gf_precalc()
+	this->clv_measTime = gf_measTime280(osrs_t, osrs_p, osrs_h);
+	this->setReg(0xF2, osrs_h);		//	settings to config control registers 0xF2, 0xF4, 0xF5
+	this->setReg(0xF4, ((osrs_t<<5) | (osrs_p<<2) | mode) );
+	this->setReg(0xF5, ((t_sb << 5) | (filter << 2) | 0) );
+	this->clv_dirty |= 0x34;		// all are written in one i2c transmission, 0xF2 before 0xF4
+	return this->flush() && lv_ok;
+}
+
+/*	@brief Decode values adc_ P T H from 8 regs 0xF7..0xFE	*/
+template <class T_bus, class T_comp, class T_instr>
+void cl_BME280_T<T_bus, T_comp, T_instr>::clf_decode(const uint8_t *lp_regs, int32_t &adc_T, int32_t &adc_P, int32_t &adc_H) {
+	adc_T = (((int32_t)lp_regs[3] << 16) | ((int32_t)lp_regs[4] << 8) | lp_regs[5]) >> 4;
+	adc_P = (((int32_t)lp_regs[0] << 16) | ((int32_t)lp_regs[1] << 8) | lp_regs[2]) >> 4;
+	adc_H = ((int32_t)lp_regs[6] << 8) | lp_regs[7];
+}
+
+/*	@brief Read raw data (adc_ P T H) & calc it to compensate value
+	@returns compensate value of T P H in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tph_stru cl_BME280_T<T_bus, T_comp, T_instr>::readTPH(void) {
+	tph_stru lv_tph = { 0, 0, 0, 0 };
+	uint8_t lv_regs[8];
+	if (!this->readRaw(lv_regs)) return lv_tph;	// something wrong with i2c connection and return 0
+	return compRaw(lv_regs);
+}
+
+/*	@brief Read raw data (adc_ P T H) & calc it to compensate value without float operations
+	@returns T 0.01 C, P Pa/256, H 0.001 %RH in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tphFixed_stru cl_BME280_T<T_bus, T_comp, T_instr>::readTPH_fixed(void) {
+	tphFixed_stru lv_tph = { 0, 0, 0, 0 };
+	uint8_t lv_regs[8];
+	if (!this->readRaw(lv_regs)) return lv_tph;	// something wrong with i2c connection and return 0
+	return compRaw_fixed(lv_regs);
+}
+
+/*	@brief Calc raw data read by poll() to compensate value
+	@returns T P H in structure var, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tph_stru cl_BME280_T<T_bus, T_comp, T_instr>::result(void) {
+	tph_stru lv_tph = { 0, 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tph;
+	return compRaw(this->clv_raw);
+}
+
+/*	@brief Calc raw data read by poll() to compensate value without float operations
+	@returns T 0.01 C, P Pa/256, H 0.001 %RH in structure var, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tphFixed_stru cl_BME280_T<T_bus, T_comp, T_instr>::result_fixed(void) {
+	tphFixed_stru lv_tph = { 0, 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tph;
+	return compRaw_fixed(this->clv_raw);
+}
+
+/*	@brief Calc 8 raw regs from 0xF7 (readRaw(), log, stream) to compensate value
+	@returns T P H in structure var, valid = cd_VAL_T | cd_VAL_P | cd_VAL_H of measured values		*/
+template <class T_bus, class T_comp, class T_instr>
+tph_stru cl_BME280_T<T_bus, T_comp, T_instr>::compRaw(const uint8_t *lp_regs) {
+	int32_t adc_T, adc_P, adc_H;
+	clf_decode(lp_regs, adc_T, adc_P, adc_H);
+	uint32_t lv_t0 = T_instr::clock();
+	tph_stru lv_res = T_comp::compTPH(this->clv_cd, this->clv_pc, adc_T, adc_P, adc_H);
+	this->clv_instr.comp(lv_t0);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P, adc_H) : 0;
+	return lv_res;
+}
+
+/*	@brief Calc 8 raw regs from 0xF7 to compensate value without float operations
+	@returns T 0.01 C, P Pa/256, H 0.001 %RH in structure var		*/
+template <class T_bus, class T_comp, class T_instr>
+tphFixed_stru cl_BME280_T<T_bus, T_comp, T_instr>::compRaw_fixed(const uint8_t *lp_regs) {
+	int32_t adc_T, adc_P, adc_H;
+	clf_decode(lp_regs, adc_T, adc_P, adc_H);
+	uint32_t lv_t0 = T_instr::clock();
+	tphFixed_stru lv_res = gf_compTPH_fixed(this->clv_pc, adc_T, adc_P, adc_H);
+	this->clv_instr.comp(lv_t0);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P, adc_H) : 0;
+	return lv_res;
+}
+
+/*	@brief	Fast start after deep sleep instead of check(), begin(), start(), 2 i2c transactions
+	@param	lp_blob	blob of saveState()
+	@param	lp_now	current time, us (micros())
+	@return	TRUE if measuring is started (then poll()), FALSE - use check(), begin()	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME280_T<T_bus, T_comp, T_instr>::resume(const uint8_t *lp_blob, uint32_t lp_now) {
+	uint32_t lv_heatTime;
+	if (!this->clf_resume(lp_blob, lv_heatTime)) return false;
+	gf_humTab(clv_ht, this->clv_pc);
+	return this->clf_resumeMeas(lp_now);
+}
+
+//============================================
+//	BME680, Bosch Document rev.: 1.9, Date: February 2024, Document N: BST-BME680-DS001-09
+//	cl_BME680, public metods (funcs)
+//============================================
+/*	@brief Read calibration data and Init sensor with default
+	filter value: cd_FIL_x2 and oversampling value T P H : cd_OS_x16
+	@return	TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::begin() {
+	return begin(cd_FIL_x2, cd_OS_x16, cd_OS_x16, cd_OS_x16); // default: filter x2, oversampling TPH x16
+}
+
+/*	@brief Read calibration data and Init sensor with
+	@param filter	filter value: cd_FIL_OFF .. cd_FIL_x128
+	@param osrs_t	oversampling value temperature: cd_OS_OFF..cd_OS_x16
+	@param osrs_p	oversampling value pressure: cd_OS_OFF..cd_OS_x16
+	@param osrs_h	oversampling value humidity: cd_OS_OFF..cd_OS_x16
+	@returns TRUE if calibration data are read and settings are written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::begin(uint8_t filter, uint8_t osrs_t, uint8_t osrs_p, uint8_t osrs_h) {
+	bool lv_ok = this->clf_readCalibData();	// Read calibration coefficients (data) to clas variable clv_cd
+	if (lv_ok) gf_humTab(clv_ht, this->clv_pc);
+/*	Select mode, oversampling and filtering = Step 1, 2, 3. (3.2.2 Sensor configuration flow, p.16)
+osrs_h bit <2:0> regs 0x72, osrs_t bit <7:5> regs 0x74, osrs_p bit <4:2> regs 0x72, mode bit <1:0>
+Filtering value (cd_FIL_x..) to Config register address 0x75 bits <4:2>		*/
+	this->clv_measTime = gf_measTime680(osrs_t, osrs_p, osrs_h) + clv_heatTime;
+	this->setReg(0x72, osrs_h);
+	this->setReg(0x74, (osrs_t<<5) | (osrs_p<<2));
+	this->setReg(0x75, filter << 2);
+	this->clv_dirty |= 0x34;		// all are written in one i2c transmission, 0x72 before 0x74
+	return this->flush() && lv_ok;
+}
+
+/*	@brief Set heating point 0..9 with
+	@param lp_setPoint	number of setpoint 0..9
+	@param lp_tagTemp	target temperature of heating, C 
+	@param lp_duration	time of heating, msec
+	@param lp_ambTemp	ambient temperature of sensor, C
+	@return	TRUE if set point is written, else profile and time of start() are not changed	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::initGasPointX(uint8_t lp_setPoint, uint16_t lp_tagTemp, uint16_t lp_duration, int16_t lp_ambTemp) {
+	//  Up to 10 different hot plate temperature set points can be configured 
+	//	by setting the registers res_heat_X (5Ah-63h) and gas_wait_X (64h-6Dh), where X = 0…9.
+	//	Step 4 - Enable GAS conversion. run_gas =1 (set bit <4> address reg 0x71) and 
+	//	Step 5 - Select index of heater set-point 0-9. nb_conv = 0 (bits <3:0> address reg 0x71)
+	if (lp_setPoint > 9) lp_setPoint = 9;
+	//	Step 6 - Define heater duration Temp in ms, reg gas_wait_X, where X = 0…9. 
+	//	Step 7 - Set heater Temp, res_heat_X (reg 0x5A-0x63), heater constants are read in begin().
+	//	All 3 registers are written by one i2c transmission.
+	uint8_t lv_wait = gf_gasWait(lp_duration);
+	uint8_t lv_pairs[6] = {
+		0x71,					(uint8_t)(0x10 | lp_setPoint),
+		(uint8_t)(0x64 + lp_setPoint),	lv_wait,
+		(uint8_t)(0x5A + lp_setPoint),	gf_resHeat(this->clv_cd, lp_tagTemp, lp_ambTemp) };
+	if (!this->clf_writeRegs(lv_pairs, 3)) return false;
+	clv_nStep = 0;				// single set point, profile is off
+	clf_setHeatTime(lv_wait);	// time of start() = T P H + heating of active set point
+	return true;
+}
+
+/*	@brief	Fast start after deep sleep instead of check(), begin(), start(), 2 i2c transactions
+	@param	lp_blob	blob of saveState()
+	@param	lp_now	current time, us (micros())
+	@return	TRUE if measuring is started (then poll()), FALSE - use check(), begin()	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::resume(const uint8_t *lp_blob, uint32_t lp_now) {
+	if (!this->clf_resume(lp_blob, clv_heatTime)) return false;
+	gf_humTab(clv_ht, this->clv_pc);
+	clv_nStep = 0;
+	return this->clf_resumeMeas(lp_now);
+}
+
+/*	@brief Set heater profile: set points 0..nStep-1, start() measures next step each time (nb_conv = step),
+	poll() stores gas resistance of step to gasVector(). Call it after begin() (heater constants).
+	All res_heat_X are written by one i2c transmission and all gas_wait_X (with reg 0x71) by another one.
+	@param lp_prof		steps of profile, temperature C and duration ms
+	@param lp_ambTemp	ambient temperature of sensor, C
+	@return	TRUE if profile is written	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::setHeatProfile(const heatProfile_stru &lp_prof, int16_t lp_ambTemp) {
+	if (lp_prof.nStep == 0 || lp_prof.nStep > cd_HEAT_MAXSTEP) return false;
+	uint8_t lv_heat[2 * cd_HEAT_MAXSTEP];		// pairs {0x5A + X, res_heat_X}
+	uint8_t lv_wait[2 * cd_HEAT_MAXSTEP + 2];	// pairs {0x64 + X, gas_wait_X}, {0x71, run_gas | nb_conv = 0}
+	for (uint8_t i = 0; i < lp_prof.nStep; i++) {
+		clv_gasWait[i] = gf_gasWait(lp_prof.duration[i]);
+		clv_gasVec[i] = 0;
+		lv_heat[2 * i] = 0x5A + i;
+		lv_heat[2 * i + 1] = gf_resHeat(this->clv_cd, lp_prof.temp[i], lp_ambTemp);
+		lv_wait[2 * i] = 0x64 + i;
+		lv_wait[2 * i + 1] = clv_gasWait[i];
+	}
+	lv_wait[2 * lp_prof.nStep] = 0x71;
+	lv_wait[2 * lp_prof.nStep + 1] = 0x10;
+	clv_nStep = 0;
+	if (!this->clf_writeRegs(lv_heat, lp_prof.nStep)) return false;
+	if (!this->clf_writeRegs(lv_wait, lp_prof.nStep + 1)) return false;
+	clv_nStep = lp_prof.nStep;
+	clv_step = 0;
+	clv_profDone = false;
+	clf_setHeatTime(clv_gasWait[0]);
+	return true;
+}
+
+/*	@brief Store gas resistance of step of profile read by poll() (0 if heating is not stable or gas is not valid),
+	next step, after the last step profile is done and next start() begins it again	*/
+template <class T_bus, class T_comp, class T_instr>
+void cl_BME680_T<T_bus, T_comp, T_instr>::clf_nextStep(void) {
+	uint32_t adc_T, adc_P, adc_H, adc_G;
+	uint8_t gas_range;
+	clf_decode(this->clv_raw, adc_T, adc_P, adc_H, adc_G, gas_range);
+	//	reg 0x2B bit <5> gas_valid_r = 1, bit <4> heat_stab_r = 1
+	clv_gasVec[clv_step] = (this->clv_raw[12] & 0x30) == 0x30 ? gf_compG(this->clv_pc, adc_G, gas_range) : 0;
+	if (++clv_step >= clv_nStep) {
+		clv_step = 0;
+		clv_profDone = true;
+	}
+}
+
+/*	@brief Decode values adc_ P T H G and gas_range from 13 regs 0x1F..0x2B	*/
+template <class T_bus, class T_comp, class T_instr>
+void cl_BME680_T<T_bus, T_comp, T_instr>::clf_decode(const uint8_t *lp_regs, uint32_t &adc_T, uint32_t &adc_P, uint32_t &adc_H,
+		uint32_t &adc_G, uint8_t &gas_range) {
+	adc_P = (uint32_t)0 | (lp_regs[0] << 12) | (lp_regs[1] << 4) | (lp_regs[2] >> 4);
+	adc_T = (uint32_t)0 | (lp_regs[3] << 12) | (lp_regs[4] << 4) | (lp_regs[5] >> 4);
+	adc_H = (uint32_t)0 | (lp_regs[6] << 8) | lp_regs[7];
+	adc_G = (uint32_t)0 | ((uint32_t)lp_regs[11] << 2) | (uint32_t)(lp_regs[12] >> 6);
+	gas_range = lp_regs[12] & 0x0F;
+}
+
+/*	@brief Read raw data (adc_ P T H G) & calc it to compensate value
+	@returns structure T P H G	*/
+template <class T_bus, class T_comp, class T_instr>
+tphg_stru cl_BME680_T<T_bus, T_comp, T_instr>::readTPHG(void) {
+	tphg_stru lv_tphg = { 0, 0, 0, 0, 0 };
+	uint8_t lv_regs[13];
+	if (!this->readRaw(lv_regs)) return lv_tphg;	// something wrong with i2c connection and return 0
+	return compRaw(lv_regs);
+}
+
+/*	@brief Read raw data (adc_ P T H G) & calc it to compensate value without float operations
+	@returns T 0.01 C, P Pa, H 0.001 %RH, G Ohm in structure var	*/
+template <class T_bus, class T_comp, class T_instr>
+tphgFixed_stru cl_BME680_T<T_bus, T_comp, T_instr>::readTPHG_fixed(void) {
+	tphgFixed_stru lv_tphg = { 0, 0, 0, 0, 0 };
+	uint8_t lv_regs[13];
+	if (!this->readRaw(lv_regs)) return lv_tphg;	// something wrong with i2c connection and return 0
+	return compRaw_fixed(lv_regs);
+}
+
+/*	@brief	Start measuring T P H G (FORCED mode) without waiting, time of conversion is set by begin(), initGasPointX()
+	@param	lp_now	current time, us (micros())
+	@return	expected time of end of conversion, us, then call poll()	*/
+template <class T_bus, class T_comp, class T_instr>
+uint32_t cl_BME680_T<T_bus, T_comp, T_instr>::start(uint32_t lp_now) {
+	bool lv_ok;
+	if (clv_nStep == 0) lv_ok = this->do1Meas();
+	else {	//	profile: set point nb_conv = step and FORCED mode in one i2c transmission
+		this->setReg(0x71, 0x10 | clv_step);
+		this->clf_trigger(0x74, cd_FOR_MODE);
+		lv_ok = this->flush();
+		clv_profDone = false;
+		clf_setHeatTime(clv_gasWait[clv_step]);
+	}
+	this->clf_start(lp_now);
+	if (!lv_ok) this->clv_state = cd_ST_IDLE;	// old data of sensor must not be read as new ones
+	return this->clv_deadline;
+}
+
+/*	@brief Read status and raw data (adc_ P T H G) once at ready time of start(), regs 0x1D..0x2B in one i2c request
+	@param	lp_now	current time, us (micros())
+	@return	TRUE when data are ready, then call result()	*/
+template <class T_bus, class T_comp, class T_instr>
+bool cl_BME680_T<T_bus, T_comp, T_instr>::poll(uint32_t lp_now) {
+	//	status reg 0x1D: bit <7> new_data_0 = 1, bit <6> gas_measuring = 0, bit <5> measuring = 0
+	if (this->clv_state != cd_ST_WAIT) return this->clv_state == cd_ST_READY;
+	if (!this->clf_poll(lp_now)) return false;
+	if (clv_nStep) clf_nextStep();
+	return true;
+}
+
+/*	@brief Calc raw data read by poll() to compensate value
+	@returns structure T P H G, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tphg_stru cl_BME680_T<T_bus, T_comp, T_instr>::result(void) {
+	tphg_stru lv_tphg = { 0, 0, 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tphg;
+	return compRaw(this->clv_raw);
+}
+
+/*	@brief Calc raw data read by poll() to compensate value without float operations
+	@returns T 0.01 C, P Pa, H 0.001 %RH, G Ohm in structure var, 0 if data are not ready	*/
+template <class T_bus, class T_comp, class T_instr>
+tphgFixed_stru cl_BME680_T<T_bus, T_comp, T_instr>::result_fixed(void) {
+	tphgFixed_stru lv_tphg = { 0, 0, 0, 0, 0 };
+	if (this->clv_state != cd_ST_READY) return lv_tphg;
+	return compRaw_fixed(this->clv_raw);
+}
+
+/*	@brief Calc 13 raw regs from 0x1F (readRaw(), log) to compensate value
+	@returns structure T P H G, valid = cd_VAL_* of measured values and gas_valid_r, heat_stab_r	*/
+template <class T_bus, class T_comp, class T_instr>
+tphg_stru cl_BME680_T<T_bus, T_comp, T_instr>::compRaw(const uint8_t *lp_regs) {
+	uint32_t adc_T, adc_P, adc_H, adc_G;
+	uint8_t gas_range;
+	clf_decode(lp_regs, adc_T, adc_P, adc_H, adc_G, gas_range);
+	uint32_t lv_t0 = T_instr::clock();
+	tphg_stru lv_res = T_comp::compTPHG(this->clv_cd, this->clv_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+	this->clv_instr.comp(lv_t0);
+	this->clv_instr.gas(lp_regs[12]);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P, adc_H) | gf_validGas(lp_regs[12]) : 0;
+	return lv_res;
+}
+
+/*	@brief Calc 13 raw regs from 0x1F to compensate value without float operations
+	@returns T 0.01 C, P Pa, H 0.001 %RH, G Ohm in structure var	*/
+template <class T_bus, class T_comp, class T_instr>
+tphgFixed_stru cl_BME680_T<T_bus, T_comp, T_instr>::compRaw_fixed(const uint8_t *lp_regs) {
+	uint32_t adc_T, adc_P, adc_H, adc_G;
+	uint8_t gas_range;
+	clf_decode(lp_regs, adc_T, adc_P, adc_H, adc_G, gas_range);
+	uint32_t lv_t0 = T_instr::clock();
+	tphgFixed_stru lv_res = gf_compTPHG_fixed(this->clv_pc, adc_T, adc_P, adc_H, adc_G, gas_range);
+	this->clv_instr.comp(lv_t0);
+	this->clv_instr.gas(lp_regs[12]);
+	lv_res.valid = this->clv_calib ? gf_valid(adc_T, adc_P, adc_H) | gf_validGas(lp_regs[12]) : 0;
+	return lv_res;
+}
+
 #endif
 
-//=================================================================================
\ No newline at end of file
+//=================================================================================
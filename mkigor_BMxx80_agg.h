@@ -0,0 +1,239 @@
+/**
+*	@brief		Streaming statistics of BMP280, BME280, BME680 readings: running min / max / mean / variance,
+*				EWMA and sliding window, O(1) per sample and constant memory, without history of samples.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Channel cl_AggChan<T_val, T_sum, T_sh, T_nBlk> keeps for values T_val (float of tph_stru or
+*	int32_t of raw adc_ / _fixed() results) sums of differences d = x - k in T_sum (float or int64_t), k is first
+*	sample, so per sample there is no division and integer sums are exact:
+*		mean = k + S / n, variance = (S2 - S * S / n) / (n - 1), where S = sum of d, S2 = sum of d * d;
+*	EWMA with alpha = 1 / 2^T_sh:	E += x - E / 2^T_sh, ewma = E / 2^T_sh (T_sh fraction bits for integers);
+*	window of T_nBlk blocks of blkLen samples: each block has its own min, max, k, S, S2, the oldest block is
+*	dropped at once when new block begins, so window is the last (T_nBlk - 1) * blkLen + 1 .. T_nBlk * blkLen samples.
+*	Blocks are merged by window() (Chan's parallel variance formula), it is O(T_nBlk) at report time.
+*	Running statistics are for report period (clear() after each report), EWMA and window continue.
+*	Example: 1 sample/s, report every minute, window of the last 5 minutes:
+*		cl_SensAgg<cl_AggF, 3> agg(60);		// T P H, blocks of 60 samples
+*		agg.add(bme.readTPH());
+*		agg_stru<float> t = agg.ch(0).run(); agg.clear();
+*/
+
+#ifndef mkigor_BMxx80_agg_h
+#define mkigor_BMxx80_agg_h
+
+#include <mkigor_BMxx80.h>
+
+template <class T_val>
+struct agg_stru {		///	statistics of channel, all 0 if n = 0
+	uint32_t	n;		///	number of samples
+	T_val		min;
+	T_val		max;
+	float		mean;
+	float		var;	///	sample variance (n - 1), 0 if n < 2
+};
+
+template <class T_val, class T_sum>
+struct aggAcc_stru {	///	accumulator of running statistics or of block of window
+	uint32_t	n;
+	T_val		min;
+	T_val		max;
+	T_val		k;		///	first sample, shift of sums
+	T_sum		s;		///	sum of x - k
+	T_sum		s2;		///	sum of (x - k)^2
+};
+
+//================================================
+//		class cl_AggChan, statistics of one channel
+//================================================
+template <class T_val, class T_sum, uint8_t T_sh = 4, uint8_t T_nBlk = 5>
+class cl_AggChan {
+private:
+	typedef aggAcc_stru<T_val, T_sum> acc_t;
+	acc_t clv_run;				///	running statistics since clear()
+	acc_t clv_blk[T_nBlk];		///	blocks of window, ring
+	uint8_t clv_cur;			///	current block
+	uint16_t clv_blkLen;		///	samples in block
+	bool clv_ewmaOn;			///	EWMA has first sample
+	T_sum clv_ewma;				///	EWMA * 2^T_sh
+	static_assert(T_nBlk >= 1 && T_sh < 31, "window needs 1 block at least, T_sh < 31");
+	static void clf_add(acc_t &lp_acc, T_val x);
+	static void clf_merge(agg_stru<T_val> &lp_res, float &lp_m2, const acc_t &lp_acc, T_val lp_ref);
+
+public:
+	typedef T_val val_t;
+	cl_AggChan(uint16_t lp_blkLen = 60) {
+		clv_ewmaOn = false;
+		clv_ewma = 0;
+		clv_run.n = 0;
+		clv_run.k = 0;
+		setWindow(lp_blkLen);
+	}
+	void add(T_val x);		/// add sample: running, EWMA, window, O(1)
+	void clear(void) { clv_run.n = 0; }		/// new period of running statistics, EWMA and window continue
+	void setWindow(uint16_t lp_blkLen);		/// samples of block of window (window is T_nBlk blocks), clear window
+	void reset(void) {		/// clear all: running, EWMA, window
+		clear();
+		clv_ewmaOn = false;
+		setWindow(clv_blkLen);
+	}
+	agg_stru<T_val> run(void) const;		/// running statistics since clear()
+	agg_stru<T_val> window(void) const;		/// statistics of window, O(T_nBlk)
+	float ewma(void) const { return clv_ewmaOn ? (float)clv_ewma / (float)(1UL << T_sh) : 0.0f; }	/// EWMA, 0 if no samples
+};
+
+typedef cl_AggChan<float, float>		cl_AggF;	///	compensated values (tp_stru, tph_stru, tphg_stru)
+typedef cl_AggChan<int32_t, int64_t>	cl_AggI;	///	raw adc_ or integer results of _fixed(), exact sums
+
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+void cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::clf_add(acc_t &lp_acc, T_val x) {
+	if (lp_acc.n == 0) {
+		lp_acc.min = x;
+		lp_acc.max = x;
+		lp_acc.k = x;
+		lp_acc.s = 0;
+		lp_acc.s2 = 0;
+	}
+	else {
+		if (x < lp_acc.min) lp_acc.min = x;
+		if (x > lp_acc.max) lp_acc.max = x;
+	}
+	T_sum lv_d = (T_sum)x - (T_sum)lp_acc.k;
+	lp_acc.s += lv_d;
+	lp_acc.s2 += lv_d * lv_d;
+	lp_acc.n++;
+}
+
+/*	merge accumulator to result (Chan's formula), lp_m2 = sum of squares of deviations of result,
+	mean of result is difference from lp_ref while merging (small numbers, float keeps fraction)	*/
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+void cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::clf_merge(agg_stru<T_val> &lp_res, float &lp_m2, const acc_t &lp_acc,
+		T_val lp_ref) {
+	if (lp_acc.n == 0) return;
+	float lv_s = (float)lp_acc.s;
+	float lv_mean = (float)((T_sum)lp_acc.k - (T_sum)lp_ref) + lv_s / (float)lp_acc.n;
+	float lv_m2 = (float)lp_acc.s2 - lv_s * lv_s / (float)lp_acc.n;
+	if (lv_m2 < 0.0f) lv_m2 = 0.0f;		// rounding of float
+	if (lp_res.n == 0) {
+		lp_res.min = lp_acc.min;
+		lp_res.max = lp_acc.max;
+		lp_res.mean = lv_mean;
+		lp_m2 = lv_m2;
+	}
+	else {
+		if (lp_acc.min < lp_res.min) lp_res.min = lp_acc.min;
+		if (lp_acc.max > lp_res.max) lp_res.max = lp_acc.max;
+		float lv_n = (float)(lp_res.n + lp_acc.n);
+		float lv_delta = lv_mean - lp_res.mean;
+		lp_m2 += lv_m2 + lv_delta * lv_delta * (float)lp_res.n * (float)lp_acc.n / lv_n;
+		lp_res.mean += lv_delta * (float)lp_acc.n / lv_n;
+	}
+	lp_res.n += lp_acc.n;
+}
+
+/*	@brief	Add sample to running statistics, EWMA and current block of window	*/
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+void cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::add(T_val x) {
+	clf_add(clv_run, x);
+	if (clv_ewmaOn) clv_ewma += (T_sum)x - clv_ewma / (T_sum)(1UL << T_sh);
+	else {
+		clv_ewma = (T_sum)x * (T_sum)(1UL << T_sh);
+		clv_ewmaOn = true;
+	}
+	if (clv_blk[clv_cur].n >= clv_blkLen) {		// block is full, next block replaces the oldest one
+		if (++clv_cur >= T_nBlk) clv_cur = 0;
+		clv_blk[clv_cur].n = 0;
+	}
+	clf_add(clv_blk[clv_cur], x);
+}
+
+/*	@brief	Set length of block of window and clear window
+	@param	lp_blkLen	samples of block, window is T_nBlk blocks	*/
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+void cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::setWindow(uint16_t lp_blkLen) {
+	clv_blkLen = lp_blkLen ? lp_blkLen : 1;
+	clv_cur = 0;
+	for (uint8_t i = 0; i < T_nBlk; i++) {
+		clv_blk[i].n = 0;
+		clv_blk[i].k = 0;
+	}
+}
+
+/*	@brief	Running statistics since clear() (report period)
+	@return	n, min, max, mean, variance, all 0 if there are no samples	*/
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+agg_stru<T_val> cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::run(void) const {
+	agg_stru<T_val> lv_res;
+	memset(&lv_res, 0, sizeof(lv_res));
+	float lv_m2 = 0.0f;
+	clf_merge(lv_res, lv_m2, clv_run, clv_run.k);
+	if (lv_res.n == 0) return lv_res;
+	lv_res.mean += (float)clv_run.k;
+	if (lv_res.n > 1) lv_res.var = lv_m2 / (float)(lv_res.n - 1);
+	return lv_res;
+}
+
+/*	@brief	Statistics of window: blocks are merged, O(T_nBlk)
+	@return	n, min, max, mean, variance, all 0 if there are no samples	*/
+template <class T_val, class T_sum, uint8_t T_sh, uint8_t T_nBlk>
+agg_stru<T_val> cl_AggChan<T_val, T_sum, T_sh, T_nBlk>::window(void) const {
+	agg_stru<T_val> lv_res;
+	memset(&lv_res, 0, sizeof(lv_res));
+	float lv_m2 = 0.0f;
+	T_val lv_ref = clv_blk[clv_cur].k;		// current block has a sample always after first add()
+	for (uint8_t i = 0; i < T_nBlk; i++) clf_merge(lv_res, lv_m2, clv_blk[i], lv_ref);
+	if (lv_res.n == 0) return lv_res;
+	lv_res.mean += (float)lv_ref;
+	if (lv_res.n > 1) lv_res.var = lv_m2 / (float)(lv_res.n - 1);
+	return lv_res;
+}
+
+//================================================
+//		class cl_SensAgg, channels T, P, H, G (0..3) of sensor, fed by results of read functions
+//================================================
+template <class T_chan, uint8_t T_nCh>
+class cl_SensAgg {
+private:
+	T_chan clv_ch[T_nCh];
+	typedef typename T_chan::val_t val_t;
+	void clf_add(const val_t *lp_vals, uint8_t lp_n) {
+		for (uint8_t i = 0; i < T_nCh && i < lp_n; i++) clv_ch[i].add(lp_vals[i]);
+	}
+	static_assert(T_nCh >= 1 && T_nCh <= 4, "channels T, P, H, G");
+
+public:
+	cl_SensAgg(uint16_t lp_blkLen = 60) { setWindow(lp_blkLen); }
+	void add(const val_t *lp_vals) { clf_add(lp_vals, T_nCh); }	/// T_nCh values, for ex. adc_T, adc_P, adc_H
+	void add(const tp_stru &lp_v) {
+		val_t lv_v[2] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1 };
+		clf_add(lv_v, 2);
+	}
+	void add(const tph_stru &lp_v) {
+		val_t lv_v[3] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1, (val_t)lp_v.humi1 };
+		clf_add(lv_v, 3);
+	}
+	void add(const tphg_stru &lp_v) {
+		val_t lv_v[4] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1, (val_t)lp_v.humi1, (val_t)lp_v.gasr1 };
+		clf_add(lv_v, 4);
+	}
+	void add(const tpFixed_stru &lp_v) {
+		val_t lv_v[2] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1 };
+		clf_add(lv_v, 2);
+	}
+	void add(const tphFixed_stru &lp_v) {
+		val_t lv_v[3] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1, (val_t)lp_v.humi1 };
+		clf_add(lv_v, 3);
+	}
+	void add(const tphgFixed_stru &lp_v) {
+		val_t lv_v[4] = { (val_t)lp_v.temp1, (val_t)lp_v.pres1, (val_t)lp_v.humi1, (val_t)lp_v.gasr1 };
+		clf_add(lv_v, 4);
+	}
+	T_chan &ch(uint8_t lp_i) { return clv_ch[lp_i]; }	/// channel 0 T, 1 P, 2 H, 3 G
+	void clear(void) { for (uint8_t i = 0; i < T_nCh; i++) clv_ch[i].clear(); }	/// new report period
+	void setWindow(uint16_t lp_blkLen) { for (uint8_t i = 0; i < T_nCh; i++) clv_ch[i].setWindow(lp_blkLen); }
+	void reset(void) { for (uint8_t i = 0; i < T_nCh; i++) clv_ch[i].reset(); }
+};
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,237 @@
+/**
+*	@brief		Bus transports for mkigor_BMxx80 library: Arduino TwoWire (i2c) and in-memory simulated registers.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*/
+
+#include <mkigor_BMxx80_bus.h>
+
+#ifdef ARDUINO
+//============================================
+//	cl_WireBus, public metods (funcs)
+//============================================
+cl_WireBus &cl_WireBus::dflt(void) {
+	static cl_WireBus lv_bus(Wire);
+	return lv_bus;
+}
+
+/*	@brief	Init TwoWire once: sensors of bus and scan call begin(), repeated Wire.begin() resets i2c hardware	*/
+void cl_WireBus::begin(void) {
+	if (clv_begun) return;
+	clv_wire->begin();
+	clv_begun = true;
+}
+
+void cl_WireBus::setClock(uint32_t lp_hz) {
+	clv_wire->setClock(lp_hz);
+}
+
+/*	@brief	Check that device answers ACK on its address
+	@return	TRUE if device is present	*/
+bool cl_WireBus::probe(uint8_t lp_dev) {
+	clv_wire->beginTransmission(lp_dev);
+	return clv_wire->endTransmission() == 0;
+}
+
+/*	@brief	Read lp_n registers from address lp_reg in one i2c request
+	@return	TRUE if all bytes are received	*/
+bool cl_WireBus::readRegs(uint8_t lp_dev, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n) {
+	clv_wire->beginTransmission(lp_dev);
+	clv_wire->write(lp_reg);
+	if (clv_wire->endTransmission() != 0) return false;
+	if (clv_wire->requestFrom(lp_dev, lp_n) != lp_n) return false;
+	for (uint8_t i = 0; i < lp_n; i++) lp_buf[i] = clv_wire->read();
+	return true;
+}
+
+/*	@brief	Write lp_npairs pairs {address, data} in one i2c transmission
+	@return	TRUE if operation is success	*/
+bool cl_WireBus::writeRegs(uint8_t lp_dev, const uint8_t *lp_pairs, uint8_t lp_npairs) {
+	clv_wire->beginTransmission(lp_dev);
+	clv_wire->write(lp_pairs, 2 * lp_npairs);
+	return clv_wire->endTransmission() == 0;
+}
+
+//============================================
+//	cl_ArduinoSpi, public metods (funcs)
+//============================================
+cl_ArduinoSpi &cl_ArduinoSpi::dflt(void) {
+	static cl_ArduinoSpi lv_spi(SPI);
+	return lv_spi;
+}
+
+/*	@brief	CS pin to output, high. BMx280 selects SPI interface by first low level of CS	*/
+void cl_ArduinoSpi::initCs(uint8_t lp_cs) {
+	pinMode(lp_cs, OUTPUT);
+	digitalWrite(lp_cs, HIGH);
+}
+
+void cl_ArduinoSpi::select(uint8_t lp_cs) {
+	clv_spi->beginTransaction(SPISettings(clv_clock, MSBFIRST, SPI_MODE0));
+	digitalWrite(lp_cs, LOW);
+}
+
+void cl_ArduinoSpi::deselect(uint8_t lp_cs) {
+	digitalWrite(lp_cs, HIGH);
+	clv_spi->endTransaction();
+}
+#endif
+
+//============================================
+//	cl_SimBus, public metods (funcs)
+//============================================
+cl_SimBus &cl_SimBus::dflt(void) {
+	static cl_SimBus lv_bus;
+	return lv_bus;
+}
+
+/*	@brief	Add simulated device with i2c address and chip code in register 0xD0
+	@return	pointer to register map of device or NULL if no free place	*/
+uint8_t *cl_SimBus::addDevice(uint8_t lp_dev, uint8_t lp_codeChip) {
+	uint8_t *lv_regs = regs(lp_dev);
+	if (lv_regs == NULL) {
+		if (clv_ndev >= cd_SIM_MAXDEV) return NULL;
+		clv_addr[clv_ndev] = lp_dev;
+		lv_regs = clv_regs[clv_ndev++];
+	}
+	memset(lv_regs, 0, 256);
+	lv_regs[0xD0] = lp_codeChip;
+	return lv_regs;
+}
+
+uint8_t *cl_SimBus::regs(uint8_t lp_dev) {
+	for (uint8_t i = 0; i < clv_ndev; i++)
+		if (clv_addr[i] == lp_dev) return clv_regs[i];
+	return NULL;
+}
+
+void cl_SimBus::setRegs(uint8_t lp_dev, uint8_t lp_reg, const uint8_t *lp_data, uint8_t lp_n) {
+	uint8_t *lv_regs = regs(lp_dev);
+	if (lv_regs == NULL) return;
+	for (uint8_t i = 0; i < lp_n; i++) lv_regs[(uint8_t)(lp_reg + i)] = lp_data[i];
+}
+
+/*	@brief	Fault injection: the first clv_failNext transactions fail, then random ones with probability clv_failRate
+	@return	TRUE if transaction fails	*/
+bool cl_SimBus::clf_fault(void) {
+	if (clv_failNext) clv_failNext--;
+	else {
+		if (clv_failRate == 0) return false;
+		clv_seed = clv_seed * 1103515245UL + 12345;
+		if ((uint16_t)(clv_seed >> 16) >= clv_failRate) return false;
+	}
+	clv_faults++;
+	return true;
+}
+
+/*	@brief	Read lp_n registers, failed read (fault injection) is short: half of bytes, rest of buffer is 0xFF
+	@return	TRUE if all bytes are read	*/
+bool cl_SimBus::readRegs(uint8_t lp_dev, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n) {
+	uint8_t *lv_regs = regs(lp_dev);
+	if (lv_regs == NULL) {
+		clv_bits += 11;			//	no device: start, address + nack, stop
+		return false;
+	}
+	clv_bits += 30 + 9 * lp_n;	//	start, address, reg, repeated start, address, data, stop (9 bits per byte with ack)
+	uint8_t lv_n = clf_fault() ? lp_n / 2 : lp_n;
+	for (uint8_t i = 0; i < lp_n; i++) lp_buf[i] = i < lv_n ? lv_regs[(uint8_t)(lp_reg + i)] : 0xFF;
+	return lv_n == lp_n;
+}
+
+/*	@brief	Write lp_npairs pairs {address, data}, failed write (fault injection) is NACK, registers are not changed
+	@return	TRUE if operation is success	*/
+bool cl_SimBus::writeRegs(uint8_t lp_dev, const uint8_t *lp_pairs, uint8_t lp_npairs) {
+	uint8_t *lv_regs = regs(lp_dev);
+	clv_bits += 11 + 18 * lp_npairs;	//	start, address, pairs {reg, data}, stop
+	if (lv_regs == NULL || clf_fault()) return false;
+	for (uint8_t i = 0; i < lp_npairs; i++) lv_regs[lp_pairs[2 * i]] = lp_pairs[2 * i + 1];
+	return true;
+}
+
+//============================================
+//	cl_SimSpi, public metods (funcs)
+//============================================
+cl_SimSpi &cl_SimSpi::dflt(void) {
+	static cl_SimSpi lv_spi;
+	return lv_spi;
+}
+
+/*	@brief	Add simulated SPI device with CS pin and chip code in register 0xD0, register map has i2c addresses
+	@return	pointer to register map of device or NULL if no free place	*/
+uint8_t *cl_SimSpi::addDevice(uint8_t lp_cs, uint8_t lp_codeChip) {
+	uint8_t *lv_regs = regs(lp_cs);
+	uint8_t i = 0;
+	while (i < clv_ndev && clv_cs[i] != lp_cs) i++;
+	if (lv_regs == NULL) {
+		if (clv_ndev >= cd_SIM_MAXDEV) return NULL;
+		clv_cs[clv_ndev] = lp_cs;
+		lv_regs = clv_regs[clv_ndev++];
+	}
+	clv_chip[i] = lp_codeChip;
+	clv_page[i] = 0;
+	memset(lv_regs, 0, 256);
+	lv_regs[0xD0] = lp_codeChip;
+	return lv_regs;
+}
+
+uint8_t *cl_SimSpi::regs(uint8_t lp_cs) {
+	for (uint8_t i = 0; i < clv_ndev; i++)
+		if (clv_cs[i] == lp_cs) return clv_regs[i];
+	return NULL;
+}
+
+uint8_t cl_SimSpi::page(uint8_t lp_cs) {
+	for (uint8_t i = 0; i < clv_ndev; i++)
+		if (clv_cs[i] == lp_cs) return clv_page[i];
+	return 0;
+}
+
+/*	@brief	Register of 7 bit address of selected device: BMx280 0x80 | address,
+	BME680 by page (page 0 = 0x80..0xFF, page 1 = 0x00..0x7F), address 0x73 is status reg in both pages	*/
+uint8_t cl_SimSpi::clf_reg(uint8_t lp_addr) {
+	if (clv_chip[clv_sel] != 0x61) return 0x80 | lp_addr;		// chip id 0x61 = BME680
+	if (lp_addr == 0x73) return 0x73;
+	return clv_page[clv_sel] ? lp_addr : (0x80 | lp_addr);
+}
+
+void cl_SimSpi::select(uint8_t lp_cs) {
+	clv_bits += 2;			//	CS setup and hold
+	clv_sel = 0;
+	while (clv_sel < clv_ndev && clv_cs[clv_sel] != lp_cs) clv_sel++;
+	if (clv_sel == clv_ndev) clv_sel = cd_SIM_MAXDEV;
+	clv_nbyte = 0;
+}
+
+void cl_SimSpi::deselect(uint8_t lp_cs) {
+	(void)lp_cs;
+	clv_sel = cd_SIM_MAXDEV;
+}
+
+/*	@brief	One byte of SPI session: control byte (RW bit, 7 bit address), then data of read (auto increment)
+	or data of write, in write session control byte and data alternate
+	@return	byte from device (MISO), 0xFF if no device is selected	*/
+uint8_t cl_SimSpi::transfer(uint8_t lp_byte) {
+	clv_bits += 8;
+	if (clv_sel >= cd_SIM_MAXDEV) return 0xFF;
+	if (clv_nbyte == 0 || (!clv_read && (clv_nbyte & 1) == 0)) {	// control byte
+		clv_read = lp_byte & 0x80;
+		clv_addr = lp_byte & 0x7F;
+		clv_nbyte++;
+		return 0xFF;
+	}
+	clv_nbyte++;
+	uint8_t lv_reg = clf_reg(clv_addr);
+	uint8_t *lv_regs = clv_regs[clv_sel];
+	if (clv_read) {
+		clv_addr = (clv_addr + 1) & 0x7F;
+		return lv_regs[lv_reg];
+	}
+	lv_regs[lv_reg] = lp_byte;
+	if (clv_chip[clv_sel] == 0x61) {
+		if (lv_reg == 0x73) clv_page[clv_sel] = (lp_byte >> 4) & 1;
+		if (lv_reg == 0xE0 && lp_byte == 0xB6) clv_page[clv_sel] = 0;	// soft reset
+	}
+	return 0xFF;
+}
+
+//=================================================================================
@@ -0,0 +1,280 @@
+/**
+*	@brief		Bus transports for mkigor_BMxx80 library: Arduino TwoWire (i2c), SPI and in-memory simulated registers.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Every transport is a plain class (no virtual methods) with the same set of methods,
+*	the sensor classes take it as template parameter, so calls are resolved at compile time:
+*		void begin(void);										- init bus hardware (check(), scan call it often);
+*		void setClock(uint32_t lp_hz);							- set bus clock, Hz;
+*		bool probe(uint8_t lp_dev);								- TRUE if device answers;
+*		bool readRegs(uint8_t lp_dev, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n);
+*																- burst read lp_n regs from lp_reg (auto increment);
+*		bool writeRegs(uint8_t lp_dev, const uint8_t *lp_pairs, uint8_t lp_npairs);
+*																- burst write lp_npairs of {reg address, data};
+*		static T_bus &dflt(void);								- default bus object for default constructors.
+*	Bosch sensors does not increment address on write, so burst write is sequence of pairs {address, data}.
+*	lp_dev is i2c address (0x76, 0x77) for i2c transports and CS pin for SPI transports.
+*	SPI (mode 0, up to 10 MHz): register address is 7 bit, bit <7> of control byte = 1 for read, 0 for write.
+*	BMP280, BME280 map regs 0x80..0xFF to SPI addresses 0x00..0x7F. BME680 has 2 pages: page 0 = regs 0x80..0xFF,
+*	page 1 = regs 0x00..0x7F, page is selected by spi_mem_page (bit <4> of reg 0x73, it is in both pages).
+*	cl_SpiBus_T does this mapping, so sensor classes use the same register addresses as by i2c.
+*/
+
+#ifndef mkigor_BMxx80_bus_h
+#define mkigor_BMxx80_bus_h
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+#else
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#define cd_SIM_MAXDEV	4		///	max number of simulated devices on one cl_SimBus, cl_SimSpi
+#define cd_SPI_MAXDEV	4		///	max number of devices (CS pins) of one SPI bus with tracking of BME680 page
+#define cd_SPI_NOPAGE	0xFF	///	page of BME680 is not known, it is written before next access
+
+#ifdef ARDUINO
+//================================================
+//		class cl_WireBus, i2c bus over Arduino TwoWire
+//================================================
+class cl_WireBus {
+private:
+	TwoWire *clv_wire;
+	bool clv_begun;			///	TwoWire is initialized by begin()
+
+public:
+	cl_WireBus(TwoWire &lp_wire = Wire) {	///	default bus is global Wire, or Wire1 etc.
+		clv_wire = &lp_wire;
+		clv_begun = false;
+	}
+	static cl_WireBus &dflt(void);		/// default bus object over global Wire
+	void begin(void);					/// TwoWire begin() once, next calls (check() of each sensor) do nothing
+	void setClock(uint32_t lp_hz);
+	bool probe(uint8_t lp_dev);
+	bool readRegs(uint8_t lp_dev, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n);
+	bool writeRegs(uint8_t lp_dev, const uint8_t *lp_pairs, uint8_t lp_npairs);
+};
+#endif
+
+//================================================
+//		class cl_SimBus, simulated registers in RAM, for Linux host or test without sensor
+//================================================
+class cl_SimBus {
+private:
+	uint8_t clv_ndev;
+	uint8_t clv_addr[cd_SIM_MAXDEV];			///	i2c address of each device
+	uint8_t clv_regs[cd_SIM_MAXDEV][256];		///	register map of each device
+	uint32_t clv_clock;
+	uint32_t clv_bits;		///	i2c bit times of transfers since clearBusTime()
+	uint16_t clv_failNext;	///	next transactions fail (fault injection)
+	uint16_t clv_failRate;	///	probability of fail of each transaction, 1/65536
+	uint32_t clv_seed;		///	random of clv_failRate
+	uint32_t clv_faults;	///	number of injected faults
+	bool clf_fault(void);	///	TRUE if this transaction fails
+
+public:
+	cl_SimBus() {
+		clv_ndev = 0;
+		clv_clock = 100000;
+		clv_bits = 0;
+		setFault(0, 0);
+	}
+	static cl_SimBus &dflt(void);		/// default simulated bus object
+	uint8_t *addDevice(uint8_t lp_dev, uint8_t lp_codeChip);	/// add device, return its register map or NULL
+	uint8_t *regs(uint8_t lp_dev);		/// register map of device, NULL if device is absent
+	void setRegs(uint8_t lp_dev, uint8_t lp_reg, const uint8_t *lp_data, uint8_t lp_n);	/// preload registers
+	uint32_t clock(void) { return clv_clock; }
+	uint32_t busTime(void) { return (uint32_t)((uint64_t)clv_bits * 1000000 / clv_clock); }	/// time of transfers on real i2c bus, us
+	void clearBusTime(void) { clv_bits = 0; }
+	void setFault(uint16_t lp_failNext, uint16_t lp_rate, uint32_t lp_seed = 1) {	/// fault injection: next lp_failNext
+		clv_failNext = lp_failNext;		///	transactions fail, then each one fails with probability lp_rate / 65536
+		clv_failRate = lp_rate;
+		clv_seed = lp_seed;
+		clv_faults = 0;
+	}
+	uint32_t faults(void) { return clv_faults; }	/// number of injected faults since setFault()
+
+	void begin(void) {}
+	void setClock(uint32_t lp_hz) { clv_clock = lp_hz; }
+	bool probe(uint8_t lp_dev) {
+		clv_bits += 11;			//	start, address + ack, stop
+		return regs(lp_dev) != NULL && !clf_fault();
+	}
+	bool readRegs(uint8_t lp_dev, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n);
+	bool writeRegs(uint8_t lp_dev, const uint8_t *lp_pairs, uint8_t lp_npairs);
+};
+
+//================================================
+//		SPI hardware for cl_SpiBus_T: begin(), setClock(), initCs(cs), select(cs), transfer(byte), deselect(cs)
+//================================================
+#ifdef ARDUINO
+class cl_ArduinoSpi {		///	Arduino SPIClass, CS is GPIO pin
+private:
+	SPIClass *clv_spi;
+	uint32_t clv_clock;
+
+public:
+	cl_ArduinoSpi(SPIClass &lp_spi = SPI) {
+		clv_spi = &lp_spi;
+		clv_clock = 10000000;
+	}
+	static cl_ArduinoSpi &dflt(void);		/// default object over global SPI
+	void begin(void) { clv_spi->begin(); }
+	void setClock(uint32_t lp_hz) { clv_clock = lp_hz; }
+	void initCs(uint8_t lp_cs);
+	void select(uint8_t lp_cs);
+	uint8_t transfer(uint8_t lp_byte) { return clv_spi->transfer(lp_byte); }
+	void deselect(uint8_t lp_cs);
+};
+#endif
+
+class cl_SimSpi {			///	simulated SPI devices, decodes control bytes and pages like sensor
+private:
+	uint8_t clv_ndev;
+	uint8_t clv_cs[cd_SIM_MAXDEV];			///	CS pin of each device
+	uint8_t clv_chip[cd_SIM_MAXDEV];		///	chip code, BME680 has pages
+	uint8_t clv_page[cd_SIM_MAXDEV];		///	spi_mem_page of BME680
+	uint8_t clv_regs[cd_SIM_MAXDEV][256];	///	register map of each device (i2c addresses)
+	uint8_t clv_sel;		///	index of selected device, cd_SIM_MAXDEV = none
+	uint8_t clv_nbyte;		///	bytes of current CS session
+	bool	clv_read;		///	session is read
+	uint8_t clv_addr;		///	current 7 bit address of session
+	uint32_t clv_clock;
+	uint32_t clv_bits;		///	SPI bit times since clearBusTime()
+	uint8_t clf_reg(uint8_t lp_addr);		///	7 bit SPI address to register of map
+
+public:
+	cl_SimSpi() {
+		clv_ndev = 0;
+		clv_sel = cd_SIM_MAXDEV;
+		clv_clock = 10000000;
+		clv_bits = 0;
+	}
+	static cl_SimSpi &dflt(void);		/// default simulated SPI object
+	uint8_t *addDevice(uint8_t lp_cs, uint8_t lp_codeChip);	/// add device, return its register map or NULL
+	uint8_t *regs(uint8_t lp_cs);		/// register map of device, NULL if device is absent
+	uint8_t page(uint8_t lp_cs);		/// spi_mem_page of device
+	uint32_t clock(void) { return clv_clock; }
+	uint32_t busTime(void) { return (uint32_t)((uint64_t)clv_bits * 1000000 / clv_clock); }	/// time of transfers on real SPI bus, us
+	void clearBusTime(void) { clv_bits = 0; }
+
+	void begin(void) {}
+	void setClock(uint32_t lp_hz) { clv_clock = lp_hz; }
+	void initCs(uint8_t lp_cs) { (void)lp_cs; }
+	void select(uint8_t lp_cs);
+	uint8_t transfer(uint8_t lp_byte);
+	void deselect(uint8_t lp_cs);
+};
+
+//================================================
+//		class cl_SpiBus_T, SPI transport over hardware T_hw (cl_ArduinoSpi or cl_SimSpi)
+//================================================
+template <class T_hw>
+class cl_SpiBus_T {
+private:
+	T_hw	*clv_hw;
+	uint8_t clv_ndev;
+	uint8_t clv_cs[cd_SPI_MAXDEV];		///	CS pins
+	uint8_t clv_page[cd_SPI_MAXDEV];	///	last written spi_mem_page of each CS or cd_SPI_NOPAGE
+	uint8_t *clf_page(uint8_t lp_cs);	///	page of CS, NULL if table is full (page is written each time)
+	void clf_setPage(uint8_t lp_cs, uint8_t lp_reg);	///	select page of register, if it is other
+
+public:
+	cl_SpiBus_T(T_hw &lp_hw = T_hw::dflt()) {
+		clv_hw = &lp_hw;
+		clv_ndev = 0;
+	}
+	static cl_SpiBus_T &dflt(void) {	/// default bus object over default hardware
+		static cl_SpiBus_T lv_bus;
+		return lv_bus;
+	}
+	T_hw &hw(void) { return *clv_hw; }
+	void begin(void) { clv_hw->begin(); }
+	void setClock(uint32_t lp_hz) { clv_hw->setClock(lp_hz); }
+	bool probe(uint8_t lp_cs);
+	bool readRegs(uint8_t lp_cs, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n);
+	bool writeRegs(uint8_t lp_cs, const uint8_t *lp_pairs, uint8_t lp_npairs);
+};
+
+template <class T_hw>
+uint8_t *cl_SpiBus_T<T_hw>::clf_page(uint8_t lp_cs) {
+	for (uint8_t i = 0; i < clv_ndev; i++)
+		if (clv_cs[i] == lp_cs) return &clv_page[i];
+	if (clv_ndev >= cd_SPI_MAXDEV) return NULL;
+	clv_cs[clv_ndev] = lp_cs;
+	clv_page[clv_ndev] = cd_SPI_NOPAGE;
+	return &clv_page[clv_ndev++];
+}
+
+/*	@brief	Write spi_mem_page (reg 0x73) if register is in other page: page 0 = regs 0x80..0xFF, page 1 = 0x00..0x7F.
+	BMP280, BME280 use only regs 0x80..0xFF, so page is written once (reg 0x73 of BMx280 = status, read only)	*/
+template <class T_hw>
+void cl_SpiBus_T<T_hw>::clf_setPage(uint8_t lp_cs, uint8_t lp_reg) {
+	uint8_t lv_page = (lp_reg & 0x80) ? 0 : 1;
+	uint8_t *lv_p = clf_page(lp_cs);
+	if (lv_p != NULL && *lv_p == lv_page) return;
+	clv_hw->select(lp_cs);
+	clv_hw->transfer(0x73);
+	clv_hw->transfer(lv_page << 4);
+	clv_hw->deselect(lp_cs);
+	if (lv_p != NULL) *lv_p = lv_page;
+}
+
+/*	@brief	SPI has no ACK, device is present if chip id (reg 0xD0) is not 0x00 or 0xFF
+	@return	TRUE if device answers	*/
+template <class T_hw>
+bool cl_SpiBus_T<T_hw>::probe(uint8_t lp_cs) {
+	uint8_t lv_id;
+	clv_hw->initCs(lp_cs);
+	uint8_t *lv_p = clf_page(lp_cs);
+	if (lv_p != NULL) *lv_p = cd_SPI_NOPAGE;	// sensor could be reset or page changed before
+	readRegs(lp_cs, 0xD0, &lv_id, 1);
+	return lv_id != 0x00 && lv_id != 0xFF;
+}
+
+/*	@brief	Read lp_n registers from address lp_reg in one CS session (auto increment), regs must be in one page
+	@return	TRUE (SPI has no ACK)	*/
+template <class T_hw>
+bool cl_SpiBus_T<T_hw>::readRegs(uint8_t lp_cs, uint8_t lp_reg, uint8_t *lp_buf, uint8_t lp_n) {
+	clf_setPage(lp_cs, lp_reg);
+	clv_hw->select(lp_cs);
+	clv_hw->transfer(lp_reg | 0x80);		// bit <7> = 1 read
+	for (uint8_t i = 0; i < lp_n; i++) lp_buf[i] = clv_hw->transfer(0);
+	clv_hw->deselect(lp_cs);
+	return true;
+}
+
+/*	@brief	Write lp_npairs pairs {address, data}, pairs of one page in one CS session
+	@return	TRUE (SPI has no ACK)	*/
+template <class T_hw>
+bool cl_SpiBus_T<T_hw>::writeRegs(uint8_t lp_cs, const uint8_t *lp_pairs, uint8_t lp_npairs) {
+	uint8_t i = 0;
+	while (i < lp_npairs) {
+		clf_setPage(lp_cs, lp_pairs[2 * i]);
+		uint8_t lv_page = lp_pairs[2 * i] & 0x80;
+		clv_hw->select(lp_cs);
+		for (; i < lp_npairs && (lp_pairs[2 * i] & 0x80) == lv_page; i++) {
+			clv_hw->transfer(lp_pairs[2 * i] & 0x7F);	// bit <7> = 0 write
+			clv_hw->transfer(lp_pairs[2 * i + 1]);
+			if (lp_pairs[2 * i] == 0xE0 && lp_pairs[2 * i + 1] == 0xB6) {	// soft reset, BME680 page = 0
+				uint8_t *lv_p = clf_page(lp_cs);
+				if (lv_p != NULL) *lv_p = 0;
+			}
+		}
+		clv_hw->deselect(lp_cs);
+	}
+	return true;
+}
+
+#ifdef ARDUINO
+typedef cl_SpiBus_T<cl_ArduinoSpi>	cl_SpiBus;	///	SPI transport, for ex. cl_SpiBus bus; cl_BME280_T<cl_SpiBus> bme(bus); bme.check(csPin);
+#endif
+typedef cl_SpiBus_T<cl_SimSpi>		cl_SimSpiBus;	///	SPI transport over simulated devices
+
+#endif
+
+//=================================================================================
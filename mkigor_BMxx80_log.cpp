@@ -0,0 +1,202 @@
+/**
+*	@brief		Compact binary log of raw data (adc_*) of BMP280, BME280, BME680 with calibration header.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*/
+
+#include <mkigor_BMxx80_log.h>
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define cd_LOG_MMAP		//	reader can memory-map file
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//============================================
+//	Pack / unpack of records
+//============================================
+/*	put lp_nbits of value to record from bit position lp_pos	*/
+static void gf_putBits(uint8_t *lp_rec, uint8_t &lp_pos, uint32_t lp_val, uint8_t lp_nbits) {
+	for (uint8_t i = 0; i < lp_nbits; i++, lp_pos++)
+		if ((lp_val >> i) & 1) lp_rec[lp_pos >> 3] |= (uint8_t)(1 << (lp_pos & 7));
+}
+
+/*	get lp_nbits of value from record from bit position lp_pos	*/
+static uint32_t gf_getBits(const uint8_t *lp_rec, uint8_t &lp_pos, uint8_t lp_nbits) {
+	uint32_t lv_val = 0;
+	for (uint8_t i = 0; i < lp_nbits; i++, lp_pos++)
+		lv_val |= (uint32_t)((lp_rec[lp_pos >> 3] >> (lp_pos & 7)) & 1) << i;
+	return lv_val;
+}
+
+/*	@brief	Size of record for chip
+	@return	5 for BMP280, 7 for BME280, 9 for BME680 or 0 if chip code is unknown	*/
+uint8_t gf_logRecLen(uint8_t lp_codeChip) {
+	if (lp_codeChip == cd_BMP280) return 5;
+	if (lp_codeChip == cd_BME280) return 7;
+	if (lp_codeChip == cd_BME680) return 9;
+	return 0;
+}
+
+/*	@brief	Pack raw registers to record
+	@param	lp_regs		raw regs read by readRaw(): 6 (BMP280), 8 (BME280) from 0xF7 or 13 (BME680) from 0x1F
+	@param	lp_rec		record, cd_LOG_MAXREC bytes
+	@return	size of record or 0 if chip code is unknown	*/
+uint8_t gf_logPack(uint8_t lp_codeChip, const uint8_t *lp_regs, uint8_t *lp_rec) {
+	uint8_t lv_len = gf_logRecLen(lp_codeChip);
+	uint8_t lv_pos = 0;
+	memset(lp_rec, 0, cd_LOG_MAXREC);
+	//	the same layout of P T H in 0xF7.. (BMx280) and in 0x1F.. (BME680)
+	uint32_t adc_P = ((uint32_t)lp_regs[0] << 12) | ((uint32_t)lp_regs[1] << 4) | (lp_regs[2] >> 4);
+	uint32_t adc_T = ((uint32_t)lp_regs[3] << 12) | ((uint32_t)lp_regs[4] << 4) | (lp_regs[5] >> 4);
+	gf_putBits(lp_rec, lv_pos, adc_T, 20);
+	gf_putBits(lp_rec, lv_pos, adc_P, 20);
+	if (lp_codeChip == cd_BME280 || lp_codeChip == cd_BME680)
+		gf_putBits(lp_rec, lv_pos, ((uint32_t)lp_regs[6] << 8) | lp_regs[7], 16);
+	if (lp_codeChip == cd_BME680) {
+		gf_putBits(lp_rec, lv_pos, ((uint32_t)lp_regs[11] << 2) | (lp_regs[12] >> 6), 10);
+		gf_putBits(lp_rec, lv_pos, lp_regs[12] & 0x0F, 4);			// gas_range
+		gf_putBits(lp_rec, lv_pos, (lp_regs[12] >> 4) & 0x03, 2);	// heat_stab, gas_valid
+	}
+	return lv_len;
+}
+
+/*	@brief	Unpack record to raw data, not used fields = 0	*/
+void gf_logUnpack(uint8_t lp_codeChip, const uint8_t *lp_rec, rawSample_stru &lp_raw) {
+	uint8_t lv_pos = 0;
+	lp_raw.adc_T = gf_getBits(lp_rec, lv_pos, 20);
+	lp_raw.adc_P = gf_getBits(lp_rec, lv_pos, 20);
+	lp_raw.adc_H = 0;
+	lp_raw.adc_G = 0;
+	lp_raw.gas_range = 0;
+	lp_raw.gas_flags = 0;
+	if (lp_codeChip == cd_BME280 || lp_codeChip == cd_BME680)
+		lp_raw.adc_H = gf_getBits(lp_rec, lv_pos, 16);
+	if (lp_codeChip == cd_BME680) {
+		lp_raw.adc_G = gf_getBits(lp_rec, lv_pos, 10);
+		lp_raw.gas_range = gf_getBits(lp_rec, lv_pos, 4);
+		lp_raw.gas_flags = gf_getBits(lp_rec, lv_pos, 2);
+	}
+}
+
+/*	@brief	Make header of log
+	@param	lp_calib	calibration image by gf_packCalib()
+	@param	lp_buf		header, cd_LOG_HDRLEN + lp_ncalib bytes
+	@return	size of header	*/
+uint8_t gf_logHeader(uint8_t lp_codeChip, const uint8_t *lp_calib, uint8_t lp_ncalib, uint8_t *lp_buf) {
+	lp_buf[0] = 'B';
+	lp_buf[1] = 'M';
+	lp_buf[2] = 'X';
+	lp_buf[3] = 'L';
+	lp_buf[4] = cd_LOG_VERSION;
+	lp_buf[5] = lp_codeChip;
+	lp_buf[6] = gf_logRecLen(lp_codeChip);
+	lp_buf[7] = lp_ncalib;
+	memcpy(lp_buf + cd_LOG_HDRLEN, lp_calib, lp_ncalib);
+	return cd_LOG_HDRLEN + lp_ncalib;
+}
+
+//============================================
+//	cl_RawLogReader, private metods (funcs)
+//============================================
+/*	@brief	Check header and read calibration data
+	@return	TRUE if header is correct	*/
+bool cl_RawLogReader::clf_parseHeader(void) {
+	if (clv_size < cd_LOG_HDRLEN || memcmp(clv_data, "BMXL", 4) != 0 || clv_data[4] != cd_LOG_VERSION) return false;
+	clv_codeChip = clv_data[5];
+	clv_recLen = clv_data[6];
+	clv_hdrLen = cd_LOG_HDRLEN + clv_data[7];
+	if (clv_recLen == 0 || clv_recLen != gf_logRecLen(clv_codeChip) || clv_size < clv_hdrLen) return false;
+	if (clv_data[7] != gf_calibLen(clv_codeChip)) return false;	// image is in log, before it is unpacked
+	const uint8_t *lv_calib = clv_data + cd_LOG_HDRLEN;
+	if (clv_codeChip == cd_BMP280) gf_unpackCalib(clv_cd.bmp280, lv_calib);
+	if (clv_codeChip == cd_BME280) gf_unpackCalib(clv_cd.bme280, lv_calib);
+	if (clv_codeChip == cd_BME680) gf_unpackCalib(clv_cd.bme680, lv_calib);
+	if (clv_codeChip == cd_BMP280) gf_precalc(clv_pc.bmp280, clv_cd.bmp280);
+	if (clv_codeChip == cd_BME280) gf_precalc(clv_pc.bme280, clv_cd.bme280);
+	if (clv_codeChip == cd_BME680) gf_precalc(clv_pc.bme680, clv_cd.bme680);
+	clv_count = (clv_size - clv_hdrLen) / clv_recLen;	// not full last record is ignored
+	return true;
+}
+
+//============================================
+//	cl_RawLogReader, public metods (funcs)
+//============================================
+/*	@brief	Open log in memory, data are not copied and must live while reader is used
+	@return	TRUE if header is correct	*/
+bool cl_RawLogReader::openMem(const uint8_t *lp_data, size_t lp_size) {
+	close();
+	clv_data = lp_data;
+	clv_size = lp_size;
+	if (clf_parseHeader()) return true;
+	close();
+	return false;
+}
+
+/*	@brief	Open log file, file is mapped to memory (read only)
+	@return	TRUE if file is opened and header is correct	*/
+bool cl_RawLogReader::open(const char *lp_path) {
+	close();
+#ifdef cd_LOG_MMAP
+	int lv_fd = ::open(lp_path, O_RDONLY);
+	if (lv_fd < 0) return false;
+	struct stat lv_st;
+	if (fstat(lv_fd, &lv_st) != 0 || lv_st.st_size == 0) {
+		::close(lv_fd);
+		return false;
+	}
+	void *lv_map = mmap(NULL, (size_t)lv_st.st_size, PROT_READ, MAP_PRIVATE, lv_fd, 0);
+	::close(lv_fd);		// mapping stays valid after close of file
+	if (lv_map == MAP_FAILED) return false;
+	madvise(lv_map, (size_t)lv_st.st_size, MADV_SEQUENTIAL);
+	clv_data = (const uint8_t *)lv_map;
+	clv_size = (size_t)lv_st.st_size;
+	clv_mapped = true;
+	if (clf_parseHeader()) return true;
+	close();
+#else
+	(void)lp_path;
+#endif
+	return false;
+}
+
+void cl_RawLogReader::close(void) {
+#ifdef cd_LOG_MMAP
+	if (clv_mapped) munmap((void *)clv_data, clv_size);
+#endif
+	clv_data = NULL;
+	clv_size = 0;
+	clv_mapped = false;
+	clv_codeChip = 0;
+	clv_count = 0;
+}
+
+/*	@brief	Compensate record by calibration data from header
+	@return	structure T P H G, not used fields = 0, valid = cd_VAL_* of record	*/
+tphg_stru cl_RawLogReader::comp(uint32_t i) {
+	tphg_stru lv_tphg = { 0, 0, 0, 0, 0 };
+	rawSample_stru lv_raw;
+	getRaw(i, lv_raw);
+	if (clv_codeChip == cd_BMP280) {
+		tp_stru lv_tp = gf_compTP(clv_pc.bmp280, lv_raw.adc_T, lv_raw.adc_P);
+		lv_tphg.temp1 = lv_tp.temp1;
+		lv_tphg.pres1 = lv_tp.pres1;
+		lv_tphg.valid = lv_tp.valid;
+	}
+	if (clv_codeChip == cd_BME280) {
+		tph_stru lv_tph = gf_compTPH(clv_pc.bme280, lv_raw.adc_T, lv_raw.adc_P, lv_raw.adc_H);
+		lv_tphg.temp1 = lv_tph.temp1;
+		lv_tphg.pres1 = lv_tph.pres1;
+		lv_tphg.humi1 = lv_tph.humi1;
+		lv_tphg.valid = lv_tph.valid;
+	}
+	if (clv_codeChip == cd_BME680) {
+		lv_tphg = gf_compTPHG(clv_pc.bme680, lv_raw.adc_T, lv_raw.adc_P, lv_raw.adc_H, lv_raw.adc_G, lv_raw.gas_range);
+		lv_tphg.valid |= ((lv_raw.gas_flags & 0x02) ? cd_VAL_G : 0) | ((lv_raw.gas_flags & 0x01) ? cd_VAL_HEAT : 0);
+	}
+	return lv_tphg;
+}
+
+//=================================================================================
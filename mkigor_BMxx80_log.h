@@ -0,0 +1,166 @@
+/**
+*	@brief		Compact binary log of raw data (adc_*) of BMP280, BME280, BME680 with calibration header.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Log keeps raw data, not floats, so it can be compensated again later by other formulas.
+*	File format, all fields little endian:
+*		header:	"BMXL" (4 bytes), version (1), chip code (1), record size (1), size of calibration image (1),
+*				calibration image (gf_packCalib(), 24 / 33 / 37 bytes);
+*		records of fixed size, fields packed by bits from bit 0 of first byte:
+*			BMP280 (5 bytes):	adc_T 20, adc_P 20;
+*			BME280 (7 bytes):	adc_T 20, adc_P 20, adc_H 16;
+*			BME680 (9 bytes):	adc_T 20, adc_P 20, adc_H 16, adc_G 10, gas_range 4, heat_stab 1, gas_valid 1.
+*	Writer sends bytes to any output with method write(const uint8_t *, size_t) (Arduino Print: File, Serial),
+*	reader works with log in memory or memory-mapped file (Linux), without allocation per record.
+*/
+
+#ifndef mkigor_BMxx80_log_h
+#define mkigor_BMxx80_log_h
+
+#include <mkigor_BMxx80.h>
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+#define cd_LOG_VERSION		1
+#define cd_LOG_HDRLEN		8		///	size of header without calibration image
+#define cd_LOG_MAXREC		9		///	max size of record
+
+struct rawSample_stru {		///	raw data of one record
+	uint32_t	adc_T;
+	uint32_t	adc_P;
+	uint32_t	adc_H;
+	uint32_t	adc_G;
+	uint8_t		gas_range;
+	uint8_t		gas_flags;	///	bit <1> gas_valid, bit <0> heat_stab
+};
+
+uint8_t gf_logRecLen(uint8_t lp_codeChip);	/// size of record for chip, 0 if chip is unknown
+uint8_t gf_logPack(uint8_t lp_codeChip, const uint8_t *lp_regs, uint8_t *lp_rec);	/// raw regs (readRaw()) to record
+void gf_logUnpack(uint8_t lp_codeChip, const uint8_t *lp_rec, rawSample_stru &lp_raw);	/// record to raw data
+uint8_t gf_logHeader(uint8_t lp_codeChip, const uint8_t *lp_calib, uint8_t lp_ncalib, uint8_t *lp_buf);
+
+//================================================
+//		class cl_RawLogWriter, streaming writer of log
+//================================================
+template <class T_out>
+class cl_RawLogWriter {
+private:
+	T_out	*clv_out;
+	uint8_t clv_codeChip;
+	uint32_t clv_count;
+	bool clf_header(const uint8_t *lp_calib, uint8_t lp_ncalib) {
+		uint8_t lv_buf[cd_LOG_HDRLEN + cd_CALIB_MAXLEN];
+		uint8_t lv_n = gf_logHeader(clv_codeChip, lp_calib, lp_ncalib, lv_buf);
+		return clv_out->write(lv_buf, lv_n) == lv_n;
+	}
+
+public:
+	cl_RawLogWriter(T_out &lp_out) {
+		clv_out = &lp_out;
+		clv_codeChip = 0;
+		clv_count = 0;
+	}
+	bool begin(const calibBMP280_stru &lp_cd);	/// write header with calibration data
+	bool begin(const calibBME280_stru &lp_cd);
+	bool begin(const calibBME680_stru &lp_cd);
+	bool add(const uint8_t *lp_regs);			/// write record of raw regs, read by readRaw()
+	uint32_t count(void) { return clv_count; }	/// number of written records
+};
+
+template <class T_out>
+bool cl_RawLogWriter<T_out>::begin(const calibBMP280_stru &lp_cd) {
+	uint8_t lv_calib[cd_CALIB_MAXLEN];
+	clv_codeChip = cd_BMP280;
+	return clf_header(lv_calib, gf_packCalib(lp_cd, lv_calib));
+}
+
+template <class T_out>
+bool cl_RawLogWriter<T_out>::begin(const calibBME280_stru &lp_cd) {
+	uint8_t lv_calib[cd_CALIB_MAXLEN];
+	clv_codeChip = cd_BME280;
+	return clf_header(lv_calib, gf_packCalib(lp_cd, lv_calib));
+}
+
+template <class T_out>
+bool cl_RawLogWriter<T_out>::begin(const calibBME680_stru &lp_cd) {
+	uint8_t lv_calib[cd_CALIB_MAXLEN];
+	clv_codeChip = cd_BME680;
+	return clf_header(lv_calib, gf_packCalib(lp_cd, lv_calib));
+}
+
+template <class T_out>
+bool cl_RawLogWriter<T_out>::add(const uint8_t *lp_regs) {
+	uint8_t lv_rec[cd_LOG_MAXREC];
+	uint8_t lv_n = gf_logPack(clv_codeChip, lp_regs, lv_rec);
+	if (lv_n == 0 || clv_out->write(lv_rec, lv_n) != lv_n) return false;
+	clv_count++;
+	return true;
+}
+
+#ifndef ARDUINO
+//================================================
+//		class cl_FileOut, output to FILE for cl_RawLogWriter on Linux host
+//================================================
+class cl_FileOut {
+private:
+	FILE *clv_file;
+
+public:
+	cl_FileOut(FILE *lp_file) {
+		clv_file = lp_file;
+	}
+	size_t write(const uint8_t *lp_buf, size_t lp_n) { return fwrite(lp_buf, 1, lp_n, clv_file); }
+};
+#endif
+
+//================================================
+//		class cl_RawLogReader, zero-copy reader of log in memory or memory-mapped file
+//================================================
+class cl_RawLogReader {
+private:
+	const uint8_t *clv_data;
+	size_t	clv_size;
+	bool	clv_mapped;		///	TRUE if clv_data is mapped by open()
+	uint8_t clv_codeChip;
+	uint8_t clv_recLen;
+	uint8_t clv_hdrLen;
+	uint32_t clv_count;
+	union {					///	calibration data from header, by chip code
+		calibBMP280_stru	bmp280;
+		calibBME280_stru	bme280;
+		calibBME680_stru	bme680;
+	} clv_cd;
+	union {					///	precompiled calibration data, for comp()
+		preBMP280_stru	bmp280;
+		preBME280_stru	bme280;
+		preBME680_stru	bme680;
+	} clv_pc;
+	bool clf_parseHeader(void);
+
+public:
+	cl_RawLogReader() {
+		clv_data = NULL;
+		clv_size = 0;
+		clv_mapped = false;
+		clv_codeChip = 0;
+		clv_count = 0;
+	}
+	~cl_RawLogReader() { close(); }
+	bool openMem(const uint8_t *lp_data, size_t lp_size);	/// log in memory, data are not copied
+	bool open(const char *lp_path);		/// memory-map file (only Linux / POSIX)
+	void close(void);
+	uint8_t codeChip(void) { return clv_codeChip; }
+	uint32_t count(void) { return clv_count; }		/// number of records
+	const uint8_t *record(uint32_t i) { return clv_data + clv_hdrLen + (size_t)i * clv_recLen; }
+	const calibBMP280_stru &calibBMP280(void) { return clv_cd.bmp280; }
+	const calibBME280_stru &calibBME280(void) { return clv_cd.bme280; }
+	const calibBME680_stru &calibBME680(void) { return clv_cd.bme680; }
+	void getRaw(uint32_t i, rawSample_stru &lp_raw) { gf_logUnpack(clv_codeChip, record(i), lp_raw); }
+	tphg_stru comp(uint32_t i);		/// compensate record i, not used fields of structure = 0
+};
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,203 @@
+/**
+*	@brief		Derived meteorological quantities of BMP280, BME280, BME680 results: altitude, pressure at sea level,
+*				dew point, absolute humidity, by fast approximations of log2 / exp2 and with caching.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*/
+
+#include <mkigor_BMxx80_meteo.h>
+#include <math.h>
+
+#define cd_SEA_EXP		5.255f		///	exponent of pressure at sea level, 1 / cd_ALT_EXP
+#define cd_ABS_K		(216.7f * 6.112f / 100.0f)	///	absolute humidity: AH = cd_ABS_K * H * exp(magT) / (273.15 + T)
+#define cd_HUMI_MIN		0.1f		///	min humidity of dew point, %RH (ln(0) = -inf)
+
+//============================================
+//	Fast approximations
+//============================================
+/*	@brief	log2(x) without libm: exponent of float + ln of mantissa m in [0.707, 1.414] by series of atanh,
+	ln(m) = 2 * (s + s^3/3 + s^5/5 + s^7/7), s = (m - 1) / (m + 1), |s| < 0.172, error of series < 3e-8
+	@param	x	> 0, normal float
+	@return	log2(x), abs error < 3e-7	*/
+float gf_fastLog2(float x) {
+	uint32_t lv_u;
+	memcpy(&lv_u, &x, 4);
+	int32_t lv_e = (int32_t)((lv_u >> 23) & 0xFF) - 127;
+	lv_u = (lv_u & 0x007FFFFF) | 0x3F800000;	// mantissa 1..2
+	float lv_m;
+	memcpy(&lv_m, &lv_u, 4);
+	if (lv_m > 1.41421356f) {
+		lv_m *= 0.5f;
+		lv_e++;
+	}
+	float lv_s = (lv_m - 1.0f) / (lv_m + 1.0f);
+	float lv_s2 = lv_s * lv_s;
+	float lv_ln = 2.0f * lv_s * (1.0f + lv_s2 * (1.0f / 3.0f + lv_s2 * (1.0f / 5.0f + lv_s2 * (1.0f / 7.0f))));
+	return (float)lv_e + lv_ln * 1.44269504f;
+}
+
+/*	@brief	2^x without libm: 2^n by exponent of float, 2^f = e^(f * ln2), f in [-0.5, 0.5], by Taylor series
+	of 6 terms, error < 1.3e-7. n is max 127 (exponent field 254, 255 is +Inf), so f is up to 0.99 above 127.5
+	@return	2^x, relative error < 3e-7 (< 2e-5 for x 127.5..128), 2^127.99 = 3.38e38 above 127.99	*/
+float gf_fastExp2(float x) {
+	if (x < -126.0f) return 0.0f;
+	if (x > 127.99f) x = 127.99f;
+	int32_t lv_n = (int32_t)(x + (x >= 0.0f ? 0.5f : -0.5f));
+	if (lv_n > 127) lv_n = 127;
+	float lv_t = (x - (float)lv_n) * 0.69314718f;
+	float lv_r = 1.0f + lv_t * (1.0f + lv_t * (1.0f / 2.0f + lv_t * (1.0f / 6.0f + lv_t * (1.0f / 24.0f
+		+ lv_t * (1.0f / 120.0f + lv_t * (1.0f / 720.0f))))));
+	uint32_t lv_u = (uint32_t)(lv_n + 127) << 23;
+	float lv_k;
+	memcpy(&lv_k, &lv_u, 4);
+	return lv_r * lv_k;
+}
+
+float gf_fastLn(float x) {
+	return gf_fastLog2(x) * 0.69314718f;
+}
+
+float gf_fastExp(float x) {
+	return gf_fastExp2(x * 1.44269504f);
+}
+
+float gf_fastPow(float x, float y) {
+	return gf_fastExp2(y * gf_fastLog2(x));
+}
+
+//============================================
+//	Single calculations, without cache
+//============================================
+/*	@brief	Altitude by pressure, log2 of ratio p / p0 (near 1) is more exact than difference of log2
+	@param	lp_pres		pressure, Pa
+	@param	lp_seaPres	reference pressure at sea level, Pa
+	@return	altitude, m	*/
+float gf_altitude(float lp_pres, float lp_seaPres) {
+	return cd_ALT_K * (1.0f - gf_fastExp2(cd_ALT_EXP * gf_fastLog2(lp_pres / lp_seaPres)));
+}
+
+/*	@brief	Pressure at sea level by pressure and altitude of station
+	@param	lp_pres		pressure, Pa
+	@param	lp_alt		altitude, m
+	@return	pressure at sea level, Pa	*/
+float gf_seaLevel(float lp_pres, float lp_alt) {
+	return lp_pres * gf_fastExp2(-cd_SEA_EXP * gf_fastLog2(1.0f - lp_alt / cd_ALT_K));
+}
+
+/*	@brief	Dew point by Magnus formula
+	@param	lp_temp		temperature, C
+	@param	lp_humi		relative humidity, %RH
+	@return	dew point, C	*/
+float gf_dewPoint(float lp_temp, float lp_humi) {
+	if (lp_humi < cd_HUMI_MIN) lp_humi = cd_HUMI_MIN;
+	float lv_g = gf_fastLn(lp_humi * 0.01f) + cd_MAGNUS_B * lp_temp / (cd_MAGNUS_C + lp_temp);
+	return cd_MAGNUS_C * lv_g / (cd_MAGNUS_B - lv_g);
+}
+
+/*	@brief	Absolute humidity by saturation vapour pressure of Magnus formula
+	@param	lp_temp		temperature, C
+	@param	lp_humi		relative humidity, %RH
+	@return	absolute humidity, g/m3	*/
+float gf_absHumi(float lp_temp, float lp_humi) {
+	return cd_ABS_K * lp_humi * gf_fastExp(cd_MAGNUS_B * lp_temp / (cd_MAGNUS_C + lp_temp)) / (273.15f + lp_temp);
+}
+
+//============================================
+//	class cl_Meteo
+//============================================
+cl_Meteo::cl_Meteo(float lp_seaPres, float lp_alt) {
+	clv_tolT = 0.005f;
+	clv_tolP = 0.5f;
+	clv_tolH = 0.005f;
+	memset(&clv_res, 0, sizeof(clv_res));
+	clearStat();
+	setSeaPres(lp_seaPres);
+	setAltitude(lp_alt);
+}
+
+/*	@brief	Reference pressure at sea level (QNH of weather service) for altitude, 1 / p0 is cached	*/
+void cl_Meteo::setSeaPres(float lp_seaPres) {
+	clv_invRef = 1.0f / lp_seaPres;
+	invalidate();
+}
+
+/*	@brief	Altitude of station for pressure at sea level, factor (1 - h / 44330)^-5.255 is cached,
+	so per sample pressure at sea level is one multiplication	*/
+void cl_Meteo::setAltitude(float lp_alt) {
+	clv_seaK = gf_fastExp2(-cd_SEA_EXP * gf_fastLog2(1.0f - lp_alt / cd_ALT_K));
+	invalidate();
+}
+
+/*	@brief	Inputs changed less than tolerance do not recalculate quantities, 0 = recalculate always
+	@param	lp_tolT	temperature, C
+	@param	lp_tolP	pressure, Pa
+	@param	lp_tolH	humidity, %RH	*/
+void cl_Meteo::setTolerance(float lp_tolT, float lp_tolP, float lp_tolH) {
+	clv_tolT = lp_tolT;
+	clv_tolP = lp_tolP;
+	clv_tolH = lp_tolH;
+}
+
+void cl_Meteo::invalidate(void) {
+	clv_lastT = NAN;		// comparison with NAN is false, so next input is new
+	clv_lastP = NAN;
+	clv_lastH = NAN;
+}
+
+/*	altitude and pressure at sea level, if pressure is changed	*/
+void cl_Meteo::clf_calcP(float lp_pres) {
+	if (fabsf(lp_pres - clv_lastP) < clv_tolP) return;
+	clv_lastP = lp_pres;
+	clv_stat.recalcP++;
+	clv_res.alt = cd_ALT_K * (1.0f - gf_fastExp2(cd_ALT_EXP * gf_fastLog2(lp_pres * clv_invRef)));
+	clv_res.seaP = lp_pres * clv_seaK;
+}
+
+/*	terms of temperature of dew point and absolute humidity, if temperature is changed
+	@return	TRUE if terms are recalculated	*/
+bool cl_Meteo::clf_calcT(float lp_temp) {
+	if (fabsf(lp_temp - clv_lastT) < clv_tolT) return false;
+	clv_lastT = lp_temp;
+	clv_stat.recalcT++;
+	clv_magT = cd_MAGNUS_B * lp_temp / (cd_MAGNUS_C + lp_temp);
+	clv_absK = cd_ABS_K * gf_fastExp(clv_magT) / (273.15f + lp_temp);
+	return true;
+}
+
+/*	dew point and absolute humidity by cached terms of temperature	*/
+void cl_Meteo::clf_calcH(float lp_humi) {
+	clv_lastH = lp_humi;
+	clv_stat.recalcH++;
+	float lv_g = gf_fastLn((lp_humi < cd_HUMI_MIN ? cd_HUMI_MIN : lp_humi) * 0.01f) + clv_magT;
+	clv_res.dew = cd_MAGNUS_C * lv_g / (cd_MAGNUS_B - lv_g);
+	clv_res.absH = clv_absK * lp_humi;
+}
+
+/*	@brief	Altitude and pressure at sea level of BMP280 result, dew point and absolute humidity are 0
+	@return	quantities (reference to internal structure)	*/
+const meteo_stru &cl_Meteo::calc(const tp_stru &lp_tp) {
+	clv_stat.calls++;
+	clf_calcP(lp_tp.pres1);
+	clv_res.dew = 0.0f;
+	clv_res.absH = 0.0f;
+	clv_lastH = NAN;		// next calc() with humidity sets them again
+	return clv_res;
+}
+
+/*	@brief	All quantities of BME280 result, only changed groups are recalculated
+	@return	quantities (reference to internal structure)	*/
+const meteo_stru &cl_Meteo::calc(const tph_stru &lp_tph) {
+	clv_stat.calls++;
+	clf_calcP(lp_tph.pres1);
+	if (clf_calcT(lp_tph.temp1) || !(fabsf(lp_tph.humi1 - clv_lastH) < clv_tolH)) clf_calcH(lp_tph.humi1);
+	return clv_res;
+}
+
+/*	@brief	All quantities of BME680 result (gas resistance is not used)
+	@return	quantities (reference to internal structure)	*/
+const meteo_stru &cl_Meteo::calc(const tphg_stru &lp_tphg) {
+	tph_stru lv_tph = { lp_tphg.temp1, lp_tphg.pres1, lp_tphg.humi1, lp_tphg.valid };
+	return calc(lv_tph);
+}
+
+//=================================================================================
@@ -0,0 +1,93 @@
+/**
+*	@brief		Derived meteorological quantities of BMP280, BME280, BME680 results: altitude, pressure at sea level,
+*				dew point, absolute humidity, by fast approximations of log2 / exp2 and with caching.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Formulas (as Bosch and Sensirion application notes):
+*		altitude, m:				h = 44330 * (1 - (p / p0)^0.190295), p0 = reference pressure at sea level;
+*		pressure at sea level, Pa:	p0 = p / (1 - h / 44330)^5.255, h = altitude of station;
+*		dew point (Magnus), C:		g = ln(H / 100) + 17.62 * T / (243.12 + T), Td = 243.12 * g / (17.62 - g);
+*		absolute humidity, g/m3:	AH = 216.7 * H / 100 * 6.112 * exp(17.62 * T / (243.12 + T)) / (273.15 + T).
+*	gf_fastLog2() has abs error < 3e-7 (+ rounding of float result), gf_fastExp2() relative error < 3e-7 (float has 6e-8),
+*	without libm calls, one division in log2. Altitude error < 0.02 m, dew point < 0.001 C (extras/bench_meteo.cpp).
+*	cl_Meteo keeps terms of reference pressure, altitude of station and temperature, and recalculates
+*	quantities only when input is changed more than tolerance (pressure, temperature, humidity separately).
+*/
+
+#ifndef mkigor_BMxx80_meteo_h
+#define mkigor_BMxx80_meteo_h
+
+#include <mkigor_BMxx80.h>
+
+#define cd_SEA_PRES		101325.0f	///	standard pressure at sea level, Pa
+#define cd_ALT_K		44330.0f	///	altitude formula: h = cd_ALT_K * (1 - (p / p0)^cd_ALT_EXP)
+#define cd_ALT_EXP		0.190295f
+#define cd_MAGNUS_B		17.62f		///	Magnus formula over water, -45..60 C
+#define cd_MAGNUS_C		243.12f
+
+struct meteo_stru {		///	derived quantities of cl_Meteo
+	float	alt;		///	altitude by reference pressure at sea level, m
+	float	seaP;		///	pressure at sea level by altitude of station, Pa
+	float	dew;		///	dew point, C (0 for BMP280)
+	float	absH;		///	absolute humidity, g/m3 (0 for BMP280)
+};
+
+struct meteoStat_stru {	///	calls of cl_Meteo::calc() and recalculations of each group of quantities
+	uint32_t	calls;
+	uint32_t	recalcP;	///	altitude, pressure at sea level
+	uint32_t	recalcT;	///	terms of temperature of dew point and absolute humidity
+	uint32_t	recalcH;	///	dew point, absolute humidity
+};
+
+//================================================
+//		Fast approximations, float x > 0 (normal numbers)
+//================================================
+float gf_fastLog2(float x);		/// log2(x), abs error < 3e-7 + rounding of result
+float gf_fastExp2(float x);		/// 2^x, relative error < 3e-7, 0 below -126, 2^127.99 (finite) above 127.99
+float gf_fastLn(float x);		/// ln(x) by gf_fastLog2()
+float gf_fastExp(float x);		/// e^x by gf_fastExp2()
+float gf_fastPow(float x, float y);	/// x^y = 2^(y * log2(x))
+
+//================================================
+//		Single calculations, without cache
+//================================================
+float gf_altitude(float lp_pres, float lp_seaPres = cd_SEA_PRES);	/// altitude, m, by pressure Pa
+float gf_seaLevel(float lp_pres, float lp_alt);		/// pressure at sea level, Pa, by pressure Pa and altitude m
+float gf_dewPoint(float lp_temp, float lp_humi);	/// dew point, C, by T C, H %RH
+float gf_absHumi(float lp_temp, float lp_humi);		/// absolute humidity, g/m3, by T C, H %RH
+
+//================================================
+//		class cl_Meteo, derived quantities with cache
+//================================================
+class cl_Meteo {
+private:
+	float clv_invRef;		///	1 / reference pressure at sea level
+	float clv_seaK;			///	(1 - h / 44330)^-5.255 of altitude of station
+	float clv_tolT, clv_tolP, clv_tolH;	///	tolerance of inputs, C, Pa, %RH
+	float clv_lastT, clv_lastP, clv_lastH;	///	inputs of cached quantities
+	float clv_magT;			///	17.62 * T / (243.12 + T) of clv_lastT
+	float clv_absK;			///	216.7 / 100 * 6.112 * exp(clv_magT) / (273.15 + T) of clv_lastT
+	meteo_stru clv_res;
+	meteoStat_stru clv_stat;
+	void clf_calcP(float lp_pres);
+	bool clf_calcT(float lp_temp);
+	void clf_calcH(float lp_humi);
+
+public:
+	cl_Meteo(float lp_seaPres = cd_SEA_PRES, float lp_alt = 0.0f);
+	void setSeaPres(float lp_seaPres);	/// reference pressure at sea level for altitude, Pa (QNH)
+	void setAltitude(float lp_alt);		/// altitude of station for pressure at sea level, m
+	void setTolerance(float lp_tolT, float lp_tolP, float lp_tolH);	/// default 0.005 C, 0.5 Pa, 0.005 %RH, 0 = always
+	void invalidate(void);				/// next calc() recalculates all quantities
+	const meteo_stru &calc(const tp_stru &lp_tp);		/// BMP280: altitude, pressure at sea level
+	const meteo_stru &calc(const tph_stru &lp_tph);		/// BME280: all quantities
+	const meteo_stru &calc(const tphg_stru &lp_tphg);	/// BME680: all quantities
+	const meteo_stru &result(void) { return clv_res; }	/// last quantities of calc()
+	meteoStat_stru stat(void) { return clv_stat; }		/// calls and recalculations since clearStat()
+	void clearStat(void) { memset(&clv_stat, 0, sizeof(clv_stat)); }
+};
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,159 @@
+/**
+*	@brief		Planner of measuring time, output data rate and settings of BMP280, BME280, BME680.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	All functions are constexpr (C++11), they work at compile time (static_assert, constants)
+*	and at runtime, without float operations. Times are us.
+*	Datasheet formulas:
+*		BMx280 forced measuring, typ: 1 + 2*T + (2*P + 0.5) + (2*H + 0.5) ms, max: 1.25 + 2.3*T + (2.3*P + 0.575) + (2.3*H + 0.575) ms,
+*			where T, P, H = number of samples of oversampling (0 if cd_OS_OFF);
+*		BMx280 normal mode, period = typ measuring + standby time t_sb, output data rate = 1 / period;
+*		BME680 (Bosch BME68x API, datasheet has no typ / max): 1.963 ms per sample + 9 * 0.477 ms + 1 ms + heating time;
+*		IIR filter with coefficient c: samples to reach 75 % of step = ceil(ln(0.25) / ln(1 - 1/c)),
+*			RMS noise is reduced by 1 / sqrt(2c - 1);
+*		RMS noise of pressure by oversampling P x1..x16 (BME280 datasheet, table 3): 3.3, 2.6, 2.1, 1.6, 1.3 Pa.
+*	Planner gf_plan() chooses the cheapest (shortest max measuring = lowest energy) combination of oversampling and filter,
+*	that fits period of samples and latency budget (filter step response) and gives pressure noise not above target,
+*	from equal cost it takes the shortest filter. Result can be used with begin() and start() / poll():
+*		constexpr plan_stru gv_plan = gf_plan(cd_BME280, 1000000, 30000000, 50);	// 1 sample/s, 30 s, 0.5 Pa
+*		bme.begin(cd_FOR_MODE, gv_plan.t_sb, gv_plan.filter, gv_plan.osrs_t, gv_plan.osrs_p, gv_plan.osrs_h);
+*/
+
+#ifndef mkigor_BMxx80_plan_h
+#define mkigor_BMxx80_plan_h
+
+#include <mkigor_BMxx80.h>
+
+struct plan_stru {			///	settings of begin() suggested by gf_plan()
+	uint8_t		osrs_t;
+	uint8_t		osrs_p;		///	cd_OS_OFF if no combination fits period of samples
+	uint8_t		osrs_h;		///	cd_OS_x1 for BME280, BME680, cd_OS_OFF for BMP280
+	uint8_t		filter;
+	uint8_t		t_sb;		///	standby time for cd_NOR_MODE (BMx280), period of normal mode is not longer than target
+	uint32_t	measTime;	///	max measuring time, us (BME680 with heating)
+	uint16_t	noiseP;		///	RMS noise of pressure, 0.01 Pa
+};
+
+//================================================
+//		Measuring time and output data rate
+//================================================
+///	BMP280, BME280 typical time of forced measuring, us (max time is gf_measTime280())
+constexpr uint32_t gf_measTimeTyp280(uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH) {
+	return 1000 + 2000UL * gf_osCount(lp_osT) + (lp_osP ? 2000UL * gf_osCount(lp_osP) + 500 : 0)
+		+ (lp_osH ? 2000UL * gf_osCount(lp_osH) + 500 : 0);
+}
+///	max time of forced measuring of chip (cd_BMP280, cd_BME280, cd_BME680), heating time of BME680, ms
+constexpr uint32_t gf_measTimeMax(uint8_t lp_codeChip, uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH,
+		uint16_t lp_heatMs = 0) {
+	return lp_codeChip == cd_BME680 ? gf_measTime680(lp_osT, lp_osP, lp_osH) + 1000UL * lp_heatMs
+		: gf_measTime280(lp_osT, lp_osP, lp_codeChip == cd_BMP280 ? cd_OS_OFF : lp_osH);
+}
+///	typical time of forced measuring of chip, BME680 has only one formula (typ = max)
+constexpr uint32_t gf_measTimeTyp(uint8_t lp_codeChip, uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH,
+		uint16_t lp_heatMs = 0) {
+	return lp_codeChip == cd_BME680 ? gf_measTime680(lp_osT, lp_osP, lp_osH) + 1000UL * lp_heatMs
+		: gf_measTimeTyp280(lp_osT, lp_osP, lp_codeChip == cd_BMP280 ? cd_OS_OFF : lp_osH);
+}
+///	standby time of normal mode for code cd_SB_*, us, codes 0x06, 0x07 are 2 s, 4 s for BMP280, 10 ms, 20 ms for BME280
+constexpr uint32_t gf_standbyTime(uint8_t lp_codeChip, uint8_t lp_sb) {
+	return lp_sb == cd_SB_500US ? 500 : (lp_sb <= cd_SB_1000MS ? 62500UL << (lp_sb - 1)
+		: (lp_codeChip == cd_BMP280 ? 2000000UL : 10000UL) << (lp_sb - cd_SB_10MS));
+}
+///	period of samples in cd_NOR_MODE (BMx280), typical, us
+constexpr uint32_t gf_normPeriod(uint8_t lp_codeChip, uint8_t lp_sb, uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH) {
+	return gf_measTimeTyp(lp_codeChip, lp_osT, lp_osP, lp_osH) + gf_standbyTime(lp_codeChip, lp_sb);
+}
+///	output data rate in cd_NOR_MODE (BMx280), 0.001 Hz
+constexpr uint32_t gf_normOdr(uint8_t lp_codeChip, uint8_t lp_sb, uint8_t lp_osT, uint8_t lp_osP, uint8_t lp_osH) {
+	return (uint32_t)(1000000000ULL / gf_normPeriod(lp_codeChip, lp_sb, lp_osT, lp_osP, lp_osH));
+}
+
+//================================================
+//		Filter and noise
+//================================================
+///	samples of IIR filter cd_FIL_OFF..cd_FIL_x128 to reach 75 % of step, ceil(ln(0.25) / ln(1 - 1/c))
+///	(BMx280 codes above cd_FIL_x16 work as x16)
+constexpr uint16_t gf_filterSteps(uint8_t lp_filter) {
+	return lp_filter == cd_FIL_OFF ? 1 : (lp_filter == cd_FIL_x2 ? 2 : (lp_filter == cd_FIL_x4 ? 5
+		: (lp_filter == cd_FIL_x8 ? 11 : (lp_filter == cd_FIL_x16 ? 22 : (lp_filter == cd_FIL_x32 ? 44
+		: (lp_filter == cd_FIL_x64 ? 89 : 177))))));
+}
+///	reduction of RMS noise by IIR filter, 1 / sqrt(2c - 1), 0.001
+constexpr uint16_t gf_filterGain(uint8_t lp_filter) {
+	return lp_filter == cd_FIL_OFF ? 1000 : (lp_filter == cd_FIL_x2 ? 577 : (lp_filter == cd_FIL_x4 ? 378
+		: (lp_filter == cd_FIL_x8 ? 258 : (lp_filter == cd_FIL_x16 ? 180 : (lp_filter == cd_FIL_x32 ? 126
+		: (lp_filter == cd_FIL_x64 ? 89 : 63))))));
+}
+///	RMS noise of pressure for oversampling of P and filter, 0.01 Pa
+constexpr uint16_t gf_noiseP(uint8_t lp_osP, uint8_t lp_filter) {
+	return (uint16_t)((lp_osP <= cd_OS_x1 ? 330UL : (lp_osP == cd_OS_x2 ? 260UL : (lp_osP == cd_OS_x4 ? 210UL
+		: (lp_osP == cd_OS_x8 ? 160UL : 130UL)))) * gf_filterGain(lp_filter) / 1000);
+}
+
+//================================================
+//		Planner, index of combination 0..39: osrs_p = cd_OS_x1 + index / 8, filter = index % 8,
+//		osrs_t = cd_OS_x1 (cd_OS_x2 for osrs_p = cd_OS_x16, as datasheet recommends), osrs_h = cd_OS_x1
+//================================================
+#define cd_PLAN_NCOMB	40
+#define cd_PLAN_NONE	0xFFFFFFFFUL	///	key of combination, that does not fit period or latency
+
+constexpr uint8_t gf_planOsP(uint8_t lp_i) { return (uint8_t)(cd_OS_x1 + lp_i / 8); }
+constexpr uint8_t gf_planOsT(uint8_t lp_i) { return gf_planOsP(lp_i) == cd_OS_x16 ? cd_OS_x2 : cd_OS_x1; }
+constexpr uint8_t gf_planOsH(uint8_t lp_codeChip) { return lp_codeChip == cd_BMP280 ? cd_OS_OFF : cd_OS_x1; }
+constexpr uint8_t gf_planFilter(uint8_t lp_i) { return (uint8_t)(lp_i % 8); }
+constexpr uint32_t gf_planTime(uint8_t lp_codeChip, uint8_t lp_i, uint16_t lp_heatMs) {
+	return gf_measTimeMax(lp_codeChip, gf_planOsT(lp_i), gf_planOsP(lp_i), gf_planOsH(lp_codeChip), lp_heatMs);
+}
+///	key of combination: less is better, cost (max time, then filter latency) if noise fits target, else after all them by noise
+constexpr uint32_t gf_planKey(uint8_t lp_codeChip, uint8_t lp_i, uint32_t lp_period, uint32_t lp_latency,
+		uint16_t lp_noiseP, uint16_t lp_heatMs) {
+	return (lp_codeChip != cd_BME680 && gf_planFilter(lp_i) > cd_FIL_x16)
+		|| gf_planTime(lp_codeChip, lp_i, lp_heatMs) > lp_period
+		|| (uint64_t)gf_filterSteps(gf_planFilter(lp_i)) * lp_period > lp_latency ? cd_PLAN_NONE
+		: (gf_noiseP(gf_planOsP(lp_i), gf_planFilter(lp_i)) <= lp_noiseP
+			? gf_planTime(lp_codeChip, lp_i, 0) * 4096UL + gf_filterSteps(gf_planFilter(lp_i))
+			: 0x80000000UL + gf_noiseP(gf_planOsP(lp_i), gf_planFilter(lp_i)));
+}
+///	index of best combination from lp_i to end
+constexpr uint8_t gf_planBest(uint8_t lp_codeChip, uint8_t lp_i, uint8_t lp_best, uint32_t lp_period, uint32_t lp_latency,
+		uint16_t lp_noiseP, uint16_t lp_heatMs) {
+	return lp_i >= cd_PLAN_NCOMB ? lp_best
+		: gf_planBest(lp_codeChip, lp_i + 1,
+			gf_planKey(lp_codeChip, lp_i, lp_period, lp_latency, lp_noiseP, lp_heatMs)
+				< gf_planKey(lp_codeChip, lp_best, lp_period, lp_latency, lp_noiseP, lp_heatMs) ? lp_i : lp_best,
+			lp_period, lp_latency, lp_noiseP, lp_heatMs);
+}
+///	the longest standby code (from lp_sb to 7) with period of normal mode not above lp_period, lp_best = start value
+constexpr uint8_t gf_planSb(uint8_t lp_codeChip, uint32_t lp_measTyp, uint32_t lp_period, uint8_t lp_sb, uint8_t lp_best) {
+	return lp_sb > cd_SB_20MS ? lp_best
+		: gf_planSb(lp_codeChip, lp_measTyp, lp_period, lp_sb + 1,
+			lp_measTyp + gf_standbyTime(lp_codeChip, lp_sb) <= lp_period
+			&& gf_standbyTime(lp_codeChip, lp_sb) > gf_standbyTime(lp_codeChip, lp_best) ? lp_sb : lp_best);
+}
+constexpr plan_stru gf_planMake(uint8_t lp_codeChip, uint8_t lp_i, bool lp_fit, uint32_t lp_period, uint16_t lp_heatMs) {
+	return plan_stru{ gf_planOsT(lp_i), lp_fit ? gf_planOsP(lp_i) : (uint8_t)cd_OS_OFF, gf_planOsH(lp_codeChip),
+		gf_planFilter(lp_i),
+		lp_codeChip == cd_BME680 ? (uint8_t)cd_SB_500US : gf_planSb(lp_codeChip,
+			gf_measTimeTyp(lp_codeChip, gf_planOsT(lp_i), gf_planOsP(lp_i), gf_planOsH(lp_codeChip)), lp_period,
+			cd_SB_500US, cd_SB_500US),
+		gf_planTime(lp_codeChip, lp_i, lp_heatMs), gf_noiseP(gf_planOsP(lp_i), gf_planFilter(lp_i)) };
+}
+
+/*	@brief	Suggest the cheapest settings of oversampling and filter
+	@param	lp_codeChip	cd_BMP280, cd_BME280, cd_BME680
+	@param	lp_period	period of samples (1 / sample rate), us, max measuring time must fit it
+	@param	lp_latency	latency budget, us: filter reaches 75 % of step in gf_filterSteps() * lp_period
+	@param	lp_noiseP	target RMS noise of pressure, 0.01 Pa, if it is not possible, plan has the least noise
+	@param	lp_heatMs	heating time of BME680 (initGasPointX() duration), ms
+	@return	plan, osrs_p = cd_OS_OFF if even x1 without filter does not fit period or latency	*/
+constexpr plan_stru gf_plan(uint8_t lp_codeChip, uint32_t lp_period, uint32_t lp_latency, uint16_t lp_noiseP,
+		uint16_t lp_heatMs = 0) {
+	return gf_planMake(lp_codeChip, gf_planBest(lp_codeChip, 0, 0, lp_period, lp_latency, lp_noiseP, lp_heatMs),
+		gf_planKey(lp_codeChip, gf_planBest(lp_codeChip, 0, 0, lp_period, lp_latency, lp_noiseP, lp_heatMs),
+			lp_period, lp_latency, lp_noiseP, lp_heatMs) != cd_PLAN_NONE, lp_period, lp_heatMs);
+}
+
+#endif
+
+//=================================================================================
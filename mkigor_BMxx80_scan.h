@@ -0,0 +1,184 @@
+/**
+*	@brief		Discovery of sensors BMP280, BME280, BME680 on several buses and typed sensor objects of found chips.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	scan() inits each bus once, then in one pass over addresses (0x76, 0x77 or list of user, for ex. CS pins
+*	of SPI) and buses reads chip id (reg 0xD0) by one request of 1 byte: absent device does not answer (NACK),
+*	known chip id creates object of its class in free slot of the set, bound to bus and address without reset
+*	(check() makes probe, chip id, soft reset and waits start up 2 ms for each sensor).
+*	Slot has place for the biggest class (union), so the set does not allocate memory. Objects are got
+*	by type: bme280(i) returns pointer or NULL if sensor i is other chip, or by apply(i, f), that calls f(sensor)
+*	with object of its own class (functor with template operator(), for ex. begin() or cl_MeasSched::add()).
+*	scanTime() is time of the last scan(), us (micros()).
+*		cl_WireBus gv_bus1(Wire1);
+*		cl_WireBus *gv_buses[2] = { &cl_WireBus::dflt(), &gv_bus1 };
+*		cl_SensorSet_T<cl_WireBus> gv_set;
+*		gv_set.scan(gv_buses, 2);	gv_set.beginAll();
+*		cl_BME280_T<cl_WireBus> *lv_bme = gv_set.bme280(gv_set.find(cd_BME280));	// NULL if there is no BME280
+*		if (lv_bme) lv_tph = lv_bme->readTPH();
+*/
+
+#ifndef mkigor_BMxx80_scan_h
+#define mkigor_BMxx80_scan_h
+
+#include <mkigor_BMxx80.h>
+#ifdef __AVR__
+#include <new.h>			///	placement new of Arduino AVR core
+#else
+#include <new>
+#endif
+
+#define cd_SCAN_MAX		4		///	default number of slots of cl_SensorSet_T
+#define cd_SCAN_NONE	0xFF	///	no sensor
+
+//================================================
+//		class cl_SensorSet_T, sensors found by scan() in fixed slots
+//================================================
+template <class T_bus = cd_DEF_BUS, uint8_t T_max = cd_SCAN_MAX>
+class cl_SensorSet_T {
+public:
+	typedef cl_BMP280_T<T_bus>	bmp280_t;	///	classes of found chips, default backends and instrumentation
+	typedef cl_BME280_T<T_bus>	bme280_t;
+	typedef cl_BME680_T<T_bus>	bme680_t;
+
+private:
+	struct slot_stru {
+		uint8_t		codeChip;
+		uint8_t		bus;		///	index of bus in array of scan()
+		uint8_t		addr;		///	i2c address or CS pin
+		union {					///	object of class of codeChip, created by scan()
+			bmp280_t	bmp280;
+			bme280_t	bme280;
+			bme680_t	bme680;
+		};
+		slot_stru() {}
+	};
+	slot_stru clv_slot[T_max];
+	uint8_t clv_n;
+	uint32_t clv_scanTime;	///	time of last scan(), us
+
+	struct begin_f {		///	begin() of sensor with default settings
+		uint8_t ok;
+		template <class T_sens> void operator()(T_sens &lp_sens) { ok += lp_sens.begin(); }
+	};
+	template <class T_sens>
+	static bool clf_create(T_sens *lp_obj, T_bus &lp_bus, uint8_t lp_addr, uint8_t lp_codeChip, bool lp_reset) {
+		new (lp_obj) T_sens(lp_bus);
+		if (lp_reset) return lp_obj->check(lp_addr) == lp_codeChip;
+		return lp_obj->attach(lp_addr, lp_codeChip);
+	}
+	bool clf_add(T_bus &lp_bus, uint8_t lp_ibus, uint8_t lp_addr, uint8_t lp_codeChip, bool lp_reset);
+
+public:
+	cl_SensorSet_T() {
+		clv_n = 0;
+		clv_scanTime = 0;
+	}
+	uint8_t scan(T_bus *const *lp_bus, uint8_t lp_nbus, bool lp_reset = false);	/// addresses 0x76, 0x77, return number of sensors
+	uint8_t scan(T_bus *const *lp_bus, uint8_t lp_nbus, const uint8_t *lp_addr, uint8_t lp_naddr, bool lp_reset = false);
+	uint32_t scanTime(void) { return clv_scanTime; }	/// time of last scan(), us
+	uint8_t size(void) { return clv_n; }				/// number of found sensors
+	uint8_t codeChip(uint8_t i) { return i < clv_n ? clv_slot[i].codeChip : 0; }
+	uint8_t busIndex(uint8_t i) { return i < clv_n ? clv_slot[i].bus : cd_SCAN_NONE; }	/// index of bus of scan()
+	uint8_t addr(uint8_t i) { return i < clv_n ? clv_slot[i].addr : cd_SCAN_NONE; }
+	uint8_t find(uint8_t lp_codeChip, uint8_t lp_from = 0);	/// index of next sensor of chip, cd_SCAN_NONE if none
+	bmp280_t *bmp280(uint8_t i) { return codeChip(i) == cd_BMP280 ? &clv_slot[i].bmp280 : NULL; }	/// NULL if other chip
+	bme280_t *bme280(uint8_t i) { return codeChip(i) == cd_BME280 ? &clv_slot[i].bme280 : NULL; }
+	bme680_t *bme680(uint8_t i) { return codeChip(i) == cd_BME680 ? &clv_slot[i].bme680 : NULL; }
+	template <class T_f>
+	bool apply(uint8_t i, T_f &lp_f);	/// lp_f(sensor) with object of its class, FALSE if no sensor i
+	template <class T_f>
+	void applyAll(T_f &lp_f) { for (uint8_t i = 0; i < clv_n; i++) apply(i, lp_f); }	/// lp_f(sensor) of all sensors
+	uint8_t beginAll(void) {			/// begin() of all sensors, return number of success
+		begin_f lv_f = { 0 };
+		applyAll(lv_f);
+		return lv_f.ok;
+	}
+};
+
+/*	@brief	Create object of class of chip in next slot, bound to bus and address
+	@param	lp_reset	check() with soft reset, else attach() without bus transactions
+	@return	TRUE if chip is known and slot is filled	*/
+template <class T_bus, uint8_t T_max>
+bool cl_SensorSet_T<T_bus, T_max>::clf_add(T_bus &lp_bus, uint8_t lp_ibus, uint8_t lp_addr, uint8_t lp_codeChip,
+		bool lp_reset) {
+	slot_stru &lv_s = clv_slot[clv_n];
+	bool lv_ok;
+	switch (lp_codeChip) {
+	case cd_BMP280:	lv_ok = clf_create(&lv_s.bmp280, lp_bus, lp_addr, lp_codeChip, lp_reset);	break;
+	case cd_BME280:	lv_ok = clf_create(&lv_s.bme280, lp_bus, lp_addr, lp_codeChip, lp_reset);	break;
+	case cd_BME680:	lv_ok = clf_create(&lv_s.bme680, lp_bus, lp_addr, lp_codeChip, lp_reset);	break;
+	default:		return false;		// other device on address or no SPI device (0x00, 0xFF)
+	}
+	if (!lv_ok) return false;
+	lv_s.codeChip = lp_codeChip;
+	lv_s.bus = lp_ibus;
+	lv_s.addr = lp_addr;
+	clv_n++;
+	return true;
+}
+
+/*	@brief	Scan i2c addresses 0x76, 0x77 of buses
+	@param	lp_bus		array of pointers to buses
+	@param	lp_nbus		number of buses
+	@param	lp_reset	soft reset of found sensors (check()), default FALSE
+	@return	number of found sensors (not more than T_max)	*/
+template <class T_bus, uint8_t T_max>
+uint8_t cl_SensorSet_T<T_bus, T_max>::scan(T_bus *const *lp_bus, uint8_t lp_nbus, bool lp_reset) {
+	const uint8_t lv_addr[2] = { 0x76, 0x77 };
+	return scan(lp_bus, lp_nbus, lv_addr, 2, lp_reset);
+}
+
+/*	@brief	Scan addresses of buses in one pass: each bus is inited once, one read of chip id per address,
+	address by address on all buses
+	@param	lp_bus		array of pointers to buses
+	@param	lp_nbus		number of buses
+	@param	lp_addr		i2c addresses (or CS pins of SPI buses)
+	@param	lp_naddr	number of addresses
+	@param	lp_reset	soft reset of found sensors (check()), default FALSE
+	@return	number of found sensors (not more than T_max)	*/
+template <class T_bus, uint8_t T_max>
+uint8_t cl_SensorSet_T<T_bus, T_max>::scan(T_bus *const *lp_bus, uint8_t lp_nbus, const uint8_t *lp_addr, uint8_t lp_naddr,
+		bool lp_reset) {
+	uint32_t lv_t0 = cd_RETRY_CLOCK();
+	clv_n = 0;
+	for (uint8_t b = 0; b < lp_nbus; b++) lp_bus[b]->begin();
+	for (uint8_t a = 0; a < lp_naddr; a++)
+		for (uint8_t b = 0; b < lp_nbus && clv_n < T_max; b++) {
+			uint8_t lv_id;
+			if (!lp_bus[b]->readRegs(lp_addr[a], 0xD0, &lv_id, 1)) continue;	// no device
+			clf_add(*lp_bus[b], b, lp_addr[a], lv_id, lp_reset);
+		}
+	clv_scanTime = cd_RETRY_CLOCK() - lv_t0;
+	return clv_n;
+}
+
+/*	@brief	Index of next sensor of chip
+	@param	lp_codeChip	cd_BMP280, cd_BME280, cd_BME680
+	@param	lp_from		first index to check
+	@return	index or cd_SCAN_NONE	*/
+template <class T_bus, uint8_t T_max>
+uint8_t cl_SensorSet_T<T_bus, T_max>::find(uint8_t lp_codeChip, uint8_t lp_from) {
+	for (uint8_t i = lp_from; i < clv_n; i++)
+		if (clv_slot[i].codeChip == lp_codeChip) return i;
+	return cd_SCAN_NONE;
+}
+
+/*	@brief	Call functor with sensor object of its own class
+	@param	lp_f	functor with template <class T_sens> void operator()(T_sens &lp_sens)
+	@return	FALSE if no sensor i	*/
+template <class T_bus, uint8_t T_max>
+template <class T_f>
+bool cl_SensorSet_T<T_bus, T_max>::apply(uint8_t i, T_f &lp_f) {
+	switch (codeChip(i)) {
+	case cd_BMP280:	lp_f(clv_slot[i].bmp280);	return true;
+	case cd_BME280:	lp_f(clv_slot[i].bme280);	return true;
+	case cd_BME680:	lp_f(clv_slot[i].bme680);	return true;
+	}
+	return false;
+}
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,100 @@
+/**
+*	@brief		Scheduler of measuring of many sensors BMP280, BME280, BME680 on one or several buses.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*/
+
+#include <mkigor_BMxx80_sched.h>
+
+//============================================
+//	cl_MeasSched, public metods (funcs)
+//============================================
+/*	@brief	Start conversion of all sensors back to back, without waiting
+	@param	lp_now	current time, us (micros())
+	@return	ready time of the slowest sensor, us	*/
+uint32_t cl_MeasSched::startAll(uint32_t lp_now) {
+	uint32_t lv_last = lp_now;
+	for (uint8_t i = 0; i < clv_n; i++) {
+		uint32_t lv_deadline = clv_sens[i].start(clv_sens[i].obj, lp_now);
+		if ((int32_t)(lv_deadline - lv_last) > 0) lv_last = lv_deadline;
+	}
+	return lv_last;
+}
+
+/*	@brief	Read sensor, that has the earliest passed ready time. Sensors before ready time are not polled (bus is free).
+	Call it while it returns index, then next time at nextDeadline().
+	@param	lp_now	current time, us (micros())
+	@return	index of sensor with new data (see result(i)) or cd_SCHED_NONE	*/
+uint8_t cl_MeasSched::poll(uint32_t lp_now) {
+	clv_tLast = lp_now;
+	while (true) {
+		uint8_t lv_next = cd_SCHED_NONE;
+		uint32_t lv_first = 0;
+		for (uint8_t i = 0; i < clv_n; i++) {
+			sensor_stru &lv_s = clv_sens[i];
+			if (lv_s.state(lv_s.obj) != cd_ST_WAIT) continue;
+			uint32_t lv_deadline = lv_s.deadline(lv_s.obj);
+			if ((int32_t)(lp_now - lv_deadline) < 0) continue;
+			if (lv_next == cd_SCHED_NONE || (int32_t)(lv_deadline - lv_first) < 0) {
+				lv_next = i;
+				lv_first = lv_deadline;
+			}
+		}
+		if (lv_next == cd_SCHED_NONE) return cd_SCHED_NONE;
+		sensor_stru &lv_s = clv_sens[lv_next];
+		if (lv_s.poll(lv_s.obj, lp_now)) {
+			lv_s.count++;
+			return lv_next;
+		}
+		if (lv_s.state(lv_s.obj) == cd_ST_IDLE) lv_s.errors++;	// bus error, else sensor is busy and has new deadline
+	}
+}
+
+/*	@return	TRUE while any sensor is measuring	*/
+bool cl_MeasSched::busy(void) {
+	for (uint8_t i = 0; i < clv_n; i++)
+		if (clv_sens[i].state(clv_sens[i].obj) == cd_ST_WAIT) return true;
+	return false;
+}
+
+/*	@brief	The earliest ready time of measuring sensors, time to call poll() (or to sleep until)
+	@return	time, us, or time of last poll() if no sensor is measuring	*/
+uint32_t cl_MeasSched::nextDeadline(void) {
+	bool lv_found = false;
+	uint32_t lv_first = clv_tLast;
+	for (uint8_t i = 0; i < clv_n; i++) {
+		sensor_stru &lv_s = clv_sens[i];
+		if (lv_s.state(lv_s.obj) != cd_ST_WAIT) continue;
+		uint32_t lv_deadline = lv_s.deadline(lv_s.obj);
+		if (!lv_found || (int32_t)(lv_deadline - lv_first) < 0) lv_first = lv_deadline;
+		lv_found = true;
+	}
+	return lv_first;
+}
+
+void cl_MeasSched::clearStat(uint32_t lp_now) {
+	for (uint8_t i = 0; i < clv_n; i++) {
+		clv_sens[i].count = 0;
+		clv_sens[i].errors = 0;
+	}
+	clv_t0 = lp_now;
+	clv_tLast = lp_now;
+}
+
+/*	@return	samples/sec of sensor i from clearStat() to last poll(), 0.001 Hz	*/
+uint32_t cl_MeasSched::rate(uint8_t i) {
+	uint32_t lv_time = clv_tLast - clv_t0;
+	if (lv_time == 0) return 0;
+	return (uint32_t)((uint64_t)clv_sens[i].count * 1000000000ULL / lv_time);
+}
+
+/*	@return	samples/sec of all sensors from clearStat() to last poll(), 0.001 Hz	*/
+uint32_t cl_MeasSched::rateAll(void) {
+	uint32_t lv_time = clv_tLast - clv_t0;
+	uint64_t lv_count = 0;
+	if (lv_time == 0) return 0;
+	for (uint8_t i = 0; i < clv_n; i++) lv_count += clv_sens[i].count;
+	return (uint32_t)(lv_count * 1000000000ULL / lv_time);
+}
+
+//=================================================================================
@@ -0,0 +1,90 @@
+/**
+*	@brief		Scheduler of measuring of many sensors BMP280, BME280, BME680 on one or several buses.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Scheduler starts conversions of all sensors back to back (start()), then reads each sensor
+*	once at its own ready time (poll()) in order of completion, so time of cycle is about time of the slowest sensor,
+*	not sum of all. Sensor objects of different types and buses are added by add(), their methods are bound
+*	at compile time to small static functions (no virtual methods in sensor classes).
+*	Time is us (micros()), scheduler does not wait: loop() calls poll(now) or sleeps until nextDeadline().
+*/
+
+#ifndef mkigor_BMxx80_sched_h
+#define mkigor_BMxx80_sched_h
+
+#include <mkigor_BMxx80.h>
+
+#define cd_SCHED_MAX	8		///	max number of sensors
+#define cd_SCHED_NONE	0xFF	///	no sensor (add() failed, poll() has no new data)
+
+//================================================
+//		class cl_MeasSched
+//================================================
+class cl_MeasSched {
+private:
+	struct sensor_stru {	///	sensor object and its methods
+		void		*obj;
+		uint32_t	(*start)(void *lp_obj, uint32_t lp_now);
+		bool		(*poll)(void *lp_obj, uint32_t lp_now);
+		uint8_t		(*state)(void *lp_obj);
+		uint32_t	(*deadline)(void *lp_obj);
+		tphg_stru	(*result)(void *lp_obj);
+		uint32_t	count;		///	number of samples since clearStat()
+		uint32_t	errors;		///	number of bus errors
+	};
+	sensor_stru clv_sens[cd_SCHED_MAX];
+	uint8_t clv_n;
+	uint32_t clv_t0;		///	time of clearStat(), us
+	uint32_t clv_tLast;		///	time of last poll(), us
+
+	template <class T_sens> static uint32_t clf_start(void *lp_obj, uint32_t lp_now) { return ((T_sens *)lp_obj)->start(lp_now); }
+	template <class T_sens> static bool clf_poll(void *lp_obj, uint32_t lp_now) { return ((T_sens *)lp_obj)->poll(lp_now); }
+	template <class T_sens> static uint8_t clf_state(void *lp_obj) { return ((T_sens *)lp_obj)->state(); }
+	template <class T_sens> static uint32_t clf_deadline(void *lp_obj) { return ((T_sens *)lp_obj)->deadline(); }
+	template <class T_sens> static tphg_stru clf_result(void *lp_obj) { return clf_tphg(((T_sens *)lp_obj)->result()); }
+	static tphg_stru clf_tphg(tp_stru lp_tp) { tphg_stru lv_r = { lp_tp.temp1, lp_tp.pres1, 0, 0, lp_tp.valid }; return lv_r; }
+	static tphg_stru clf_tphg(tph_stru lp_tph) {
+		tphg_stru lv_r = { lp_tph.temp1, lp_tph.pres1, lp_tph.humi1, 0, lp_tph.valid };
+		return lv_r;
+	}
+	static tphg_stru clf_tphg(tphg_stru lp_tphg) { return lp_tphg; }
+
+public:
+	cl_MeasSched() {
+		clv_n = 0;
+		clearStat(0);
+	}
+	template <class T_sens>
+	uint8_t add(T_sens &lp_sens);		/// add sensor after its begin(), return index or cd_SCHED_NONE
+	uint8_t size(void) { return clv_n; }
+	uint32_t startAll(uint32_t lp_now);	/// start all sensors, return ready time of the slowest
+	uint8_t poll(uint32_t lp_now);		/// read next sensor in order of completion, return its index or cd_SCHED_NONE
+	bool busy(void);					/// TRUE while any sensor is measuring
+	uint32_t nextDeadline(void);		/// the earliest ready time of measuring sensors, us
+	tphg_stru result(uint8_t i) { return clv_sens[i].result(clv_sens[i].obj); }	/// data of sensor, not used fields = 0
+	void clearStat(uint32_t lp_now);	/// clear counters, start time of rate()
+	uint32_t samples(uint8_t i) { return clv_sens[i].count; }
+	uint32_t errors(uint8_t i) { return clv_sens[i].errors; }
+	uint32_t rate(uint8_t i);			/// samples/sec of sensor since clearStat(), 0.001 Hz
+	uint32_t rateAll(void);				/// samples/sec of all sensors, 0.001 Hz
+};
+
+template <class T_sens>
+uint8_t cl_MeasSched::add(T_sens &lp_sens) {
+	if (clv_n >= cd_SCHED_MAX) return cd_SCHED_NONE;
+	sensor_stru &lv_s = clv_sens[clv_n];
+	lv_s.obj = &lp_sens;
+	lv_s.start = clf_start<T_sens>;
+	lv_s.poll = clf_poll<T_sens>;
+	lv_s.state = clf_state<T_sens>;
+	lv_s.deadline = clf_deadline<T_sens>;
+	lv_s.result = clf_result<T_sens>;
+	lv_s.count = 0;
+	lv_s.errors = 0;
+	return clv_n++;
+}
+
+#endif
+
+//=================================================================================
@@ -0,0 +1,199 @@
+/**
+*	@brief		Continuous measuring (normal mode) of BMP280, BME280 to lock-free ring buffer.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	In cd_NOR_MODE sensor measures itself every period = measuring time + standby time t_sb.
+*	cl_SensStream reads data once per period at the moment of end of conversion: first read is a little before
+*	the expected time, if sensor is still measuring (status bit <3>) or data are the same as last sample,
+*	it reads again after short step, so reading follows the sensor's own clock (no duplicate samples).
+*	Samples with time stamp (raw regs or compensated values) are pushed to cl_SpscRing:
+*	single producer (high priority task or interrupt, if bus transport can work there) and single consumer
+*	(low priority task, it takes samples in batches), without locks and without disable of interrupts.
+*	BME680 has no normal mode, it is not supported.
+*/
+
+#ifndef mkigor_BMxx80_stream_h
+#define mkigor_BMxx80_stream_h
+
+#include <mkigor_BMxx80.h>
+
+#ifdef __AVR__
+typedef uint8_t		ringIdx_t;		///	index of ring is read / written by one instruction (AVR 8 bit), size <= 128
+#else
+typedef uint32_t	ringIdx_t;
+#endif
+
+struct streamRaw_stru {		///	sample of stream: time and raw regs 0xF7..0xFE (6 regs for BMP280)
+	uint32_t	time;		///	time of read, us
+	uint8_t		regs[8];
+};
+struct streamTPH_stru {		///	sample of stream: time and compensated values (H = 0 for BMP280)
+	uint32_t	time;		///	time of read, us
+	tph_stru	tph;
+};
+
+//================================================
+//		class cl_SpscRing, lock-free ring buffer, single producer / single consumer
+//================================================
+template <class T_item, ringIdx_t T_size>
+class cl_SpscRing {
+private:
+	T_item clv_buf[T_size];
+	ringIdx_t clv_head;		///	written only by producer, number of pushed items (free running)
+	ringIdx_t clv_tail;		///	written only by consumer, number of popped items (free running)
+	volatile uint32_t clv_overrun;	///	items lost because ring is full, written only by producer (statistics)
+	static_assert(T_size > 1 && (T_size & (T_size - 1)) == 0 && T_size <= (ringIdx_t)(~(ringIdx_t)0) / 2 + 1,
+		"size of ring must be power of 2 and not above half of range of ringIdx_t");
+
+public:
+	typedef T_item item_t;
+	cl_SpscRing() {
+		clv_head = 0;
+		clv_tail = 0;
+		clv_overrun = 0;
+	}
+	bool push(const T_item &lp_item);	/// producer: add item, FALSE and overrun++ if ring is full
+	bool pop(T_item &lp_item);			/// consumer: take oldest item, FALSE if ring is empty
+	ringIdx_t popBatch(T_item *lp_items, ringIdx_t lp_max);	/// consumer: take up to lp_max items, return number
+	ringIdx_t count(void) {				/// number of items in ring
+		return (ringIdx_t)(__atomic_load_n(&clv_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&clv_tail, __ATOMIC_ACQUIRE));
+	}
+	ringIdx_t size(void) { return T_size; }
+	uint32_t overrun(void) { return clv_overrun; }
+};
+
+template <class T_item, ringIdx_t T_size>
+bool cl_SpscRing<T_item, T_size>::push(const T_item &lp_item) {
+	ringIdx_t lv_head = clv_head;
+	if ((ringIdx_t)(lv_head - __atomic_load_n(&clv_tail, __ATOMIC_ACQUIRE)) >= T_size) {
+		clv_overrun = clv_overrun + 1;
+		return false;
+	}
+	clv_buf[lv_head & (T_size - 1)] = lp_item;
+	__atomic_store_n(&clv_head, (ringIdx_t)(lv_head + 1), __ATOMIC_RELEASE);	// item is written before index
+	return true;
+}
+
+template <class T_item, ringIdx_t T_size>
+bool cl_SpscRing<T_item, T_size>::pop(T_item &lp_item) {
+	ringIdx_t lv_tail = clv_tail;
+	if (lv_tail == __atomic_load_n(&clv_head, __ATOMIC_ACQUIRE)) return false;
+	lp_item = clv_buf[lv_tail & (T_size - 1)];
+	__atomic_store_n(&clv_tail, (ringIdx_t)(lv_tail + 1), __ATOMIC_RELEASE);	// item is read before place is free
+	return true;
+}
+
+template <class T_item, ringIdx_t T_size>
+ringIdx_t cl_SpscRing<T_item, T_size>::popBatch(T_item *lp_items, ringIdx_t lp_max) {
+	ringIdx_t lv_tail = clv_tail;
+	ringIdx_t lv_n = (ringIdx_t)(__atomic_load_n(&clv_head, __ATOMIC_ACQUIRE) - lv_tail);
+	if (lv_n > lp_max) lv_n = lp_max;
+	for (ringIdx_t i = 0; i < lv_n; i++) lp_items[i] = clv_buf[(ringIdx_t)(lv_tail + i) & (T_size - 1)];
+	__atomic_store_n(&clv_tail, (ringIdx_t)(lv_tail + lv_n), __ATOMIC_RELEASE);
+	return lv_n;
+}
+
+//================================================
+//		class cl_SensStream, producer of samples of sensor in normal mode
+//================================================
+template <class T_sens>
+class cl_SensStream {
+private:
+	T_sens	*clv_sens;
+	uint32_t clv_period;	///	period of samples of sensor, us, it is corrected by time between samples
+	uint32_t clv_next;		///	time of next read, us
+	uint32_t clv_last;		///	time of last sample, us
+	uint8_t clv_nregs;		///	6 (BMP280) or 8 (BME280) regs from 0xF7
+	uint8_t clv_prev[8];	///	regs of last sample, to find duplicate
+	uint32_t clv_samples;	///	number of new samples
+	uint32_t clv_missed;	///	samples of sensor between reads, that were not read
+	uint32_t clv_reads;		///	number of reads (i2c requests)
+	uint32_t clv_errors;	///	bus errors
+	void clf_item(streamRaw_stru &lp_item, const uint8_t *lp_regs) {
+		memcpy(lp_item.regs, lp_regs, clv_nregs);
+	}
+	void clf_item(streamTPH_stru &lp_item, const uint8_t *lp_regs) {
+		clf_tph(lp_item.tph, clv_sens->compRaw(lp_regs));
+	}
+	static void clf_tph(tph_stru &lp_tph, tp_stru lp_tp) {
+		lp_tph.temp1 = lp_tp.temp1;
+		lp_tph.pres1 = lp_tp.pres1;
+		lp_tph.humi1 = 0;
+		lp_tph.valid = lp_tp.valid;
+	}
+	static void clf_tph(tph_stru &lp_tph, tph_stru lp_src) { lp_tph = lp_src; }
+
+public:
+	cl_SensStream(T_sens &lp_sens) {
+		clv_sens = &lp_sens;
+		begin(1000000, 0);
+	}
+	void begin(uint32_t lp_period, uint32_t lp_now);	/// start of stream, sensor is in cd_NOR_MODE, period us (gf_normPeriod())
+	template <class T_ring>
+	bool poll(uint32_t lp_now, T_ring &lp_ring);	/// producer: read sensor if it is time, push sample, TRUE if pushed
+	uint32_t next(void) { return clv_next; }		/// time of next read, us
+	uint32_t period(void) { return clv_period; }	/// measured period of sensor, us
+	uint32_t samples(void) { return clv_samples; }
+	uint32_t missed(void) { return clv_missed; }
+	uint32_t reads(void) { return clv_reads; }
+	uint32_t errors(void) { return clv_errors; }
+};
+
+/*	@brief	Start of stream, sensor must be started by begin(cd_NOR_MODE, t_sb, ...)
+	@param	lp_period	period of samples, us, for ex. gf_normPeriod(chip, t_sb, osrs_t, osrs_p, osrs_h)
+	@param	lp_now		current time, us (micros())	*/
+template <class T_sens>
+void cl_SensStream<T_sens>::begin(uint32_t lp_period, uint32_t lp_now) {
+	clv_period = lp_period;
+	clv_next = lp_now;
+	clv_last = lp_now;
+	clv_nregs = clv_sens->codeChip() == cd_BMP280 ? 6 : 8;
+	memset(clv_prev, 0, sizeof(clv_prev));
+	clv_samples = 0;
+	clv_missed = 0;
+	clv_reads = 0;
+	clv_errors = 0;
+}
+
+/*	@brief	Producer: before time of next read it does nothing, else reads status and data in one i2c request.
+	New sample is pushed to ring, next read is a little before end of next conversion (period - period/64),
+	if there is no new sample, next read is after period/32. Period follows clock of sensor.
+	@param	lp_now	current time, us (micros())
+	@param	lp_ring	cl_SpscRing of streamRaw_stru or streamTPH_stru
+	@return	TRUE if new sample is pushed (FALSE also if ring is full, see overrun() of ring)	*/
+template <class T_sens>
+template <class T_ring>
+bool cl_SensStream<T_sens>::poll(uint32_t lp_now, T_ring &lp_ring) {
+	if ((int32_t)(lp_now - clv_next) < 0) return false;
+	uint8_t lv_regs[12];	// 0xF3 status, 0xF4, 0xF5, 0xF6, data from 0xF7
+	clv_reads++;
+	if (!clv_sens->readRegs(0xF3, lv_regs, 4 + clv_nregs)) {
+		clv_errors++;
+		clv_next = lp_now + clv_period;
+		return false;
+	}
+	uint32_t lv_time = lp_now - clv_last;
+	bool lv_same = clv_samples > 0 && memcmp(lv_regs + 4, clv_prev, clv_nregs) == 0;
+	//	the same data can be new sample only if more than period is gone (stable signal)
+	if ((lv_regs[0] & 0x08) || (lv_same && lv_time < clv_period + clv_period / 8)) {
+		clv_next = lp_now + clv_period / 32;
+		return false;
+	}
+	if (clv_samples > 0 && lv_time > clv_period + clv_period / 2)
+		clv_missed += (lv_time + clv_period / 2) / clv_period - 1;
+	else if (clv_samples > 0)		// period follows clock of sensor (average of 8 samples)
+		clv_period += ((int32_t)(lv_time - clv_period)) / 8;
+	memcpy(clv_prev, lv_regs + 4, clv_nregs);
+	clv_samples++;
+	clv_last = lp_now;
+	clv_next = lp_now + clv_period - clv_period / 64;
+	typename T_ring::item_t lv_item;
+	lv_item.time = lp_now;
+	clf_item(lv_item, lv_regs + 4);
+	return lp_ring.push(lv_item);
+}
+
+#endif
+
+//=================================================================================
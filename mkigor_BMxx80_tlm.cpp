@@ -0,0 +1,305 @@
+/**
+*	@brief		Compact telemetry packets of T, P, H, G samples (LoRa, NB-IoT): quantization, delta to previous sample,
+*				zigzag varint or bit-packing, to buffer of caller without allocation, and decoder.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*/
+
+#include <mkigor_BMxx80_tlm.h>
+
+#define cd_TLM_MAXEXP	9		///	|exp| of quantization step
+#define cd_TLM_QMAX		16777216.0f		///	2^24, |q| must be less (exact in float, no overflow of int32_t)
+
+//============================================
+//	Quantization, zigzag, varint
+//============================================
+/*	10^lp_exp, lp_exp = 0..cd_TLM_MAXEXP	*/
+static float gf_pow10(uint8_t lp_exp) {
+	float lv_p = 1.0f;
+	while (lp_exp--) lv_p *= 10.0f;
+	return lv_p;
+}
+
+/*	round to nearest, without libm, |x| < cd_TLM_QMAX	*/
+static int32_t gf_tlmRound(float x) {
+	return x >= 0.0f ? (int32_t)(x + 0.5f) : -(int32_t)(0.5f - x);
+}
+
+/*	quantize value, return FALSE if |v * scale| >= 2^24 or v is NaN (cast to int32_t would be undefined)	*/
+static bool gf_tlmQuant(float lp_v, float lp_scale, int32_t &lp_q) {
+	float x = lp_v * lp_scale;
+	if (!(x > -cd_TLM_QMAX && x < cd_TLM_QMAX)) return false;
+	lp_q = gf_tlmRound(x);
+	return true;
+}
+
+/*	delta of signed values to zigzag code (wrap of uint32_t, so any delta is reversible)	*/
+static uint32_t gf_zigzag(int32_t lp_q, int32_t lp_prev) {
+	uint32_t lv_d = (uint32_t)lp_q - (uint32_t)lp_prev;
+	return (lv_d << 1) ^ (uint32_t)(-(int32_t)(lv_d >> 31));
+}
+
+static int32_t gf_unzigzag(uint32_t lp_z, int32_t lp_prev) {
+	uint32_t lv_d = (lp_z >> 1) ^ (uint32_t)(-(int32_t)(lp_z & 1));
+	return (int32_t)((uint32_t)lp_prev + lv_d);
+}
+
+/*	varint to lp_buf, return number of bytes (1..5)	*/
+static uint8_t gf_putVarint(uint8_t *lp_buf, uint32_t lp_val) {
+	uint8_t lv_n = 0;
+	while (lp_val >= 0x80) {
+		lp_buf[lv_n++] = (uint8_t)(lp_val | 0x80);
+		lp_val >>= 7;
+	}
+	lp_buf[lv_n++] = (uint8_t)lp_val;
+	return lv_n;
+}
+
+/*	number of bits of value, 0 for 0	*/
+static uint8_t gf_bitWidth(uint32_t lp_val) {
+	uint8_t lv_w = 0;
+	while (lp_val) {
+		lv_w++;
+		lp_val >>= 1;
+	}
+	return lv_w;
+}
+
+/*	check config and quantization scales (1 / step), return FALSE if config is wrong	*/
+static bool gf_tlmScale(const tlmCfg_stru &lp_cfg, float *lp_scale) {
+	if (lp_cfg.nCh < 1 || lp_cfg.nCh > cd_TLM_MAXCH) return false;
+	for (uint8_t c = 0; c < lp_cfg.nCh; c++) {
+		int8_t lv_e = lp_cfg.exp[c];
+		if (lv_e > cd_TLM_MAXEXP || lv_e < -cd_TLM_MAXEXP) return false;
+		lp_scale[c] = lv_e < 0 ? gf_pow10((uint8_t)-lv_e) : 1.0f / gf_pow10((uint8_t)lv_e);
+	}
+	return true;
+}
+
+/*	header: version, mode, nCh, number of samples, exp of channels, return size	*/
+static uint8_t gf_tlmHeader(const tlmCfg_stru &lp_cfg, uint8_t lp_mode, uint8_t lp_n, uint8_t *lp_buf) {
+	lp_buf[0] = (uint8_t)((cd_TLM_VERSION << 4) | (lp_mode << 3) | lp_cfg.nCh);
+	lp_buf[1] = lp_n;
+	for (uint8_t c = 0; c < lp_cfg.nCh; c++) lp_buf[2 + c] = (uint8_t)lp_cfg.exp[c];
+	return 2 + lp_cfg.nCh;
+}
+
+//============================================
+//	Bit-packing
+//============================================
+/*	@brief	Bit-packed packet of samples: first sample is key (varints), widths of channels are max widths of
+	zigzag deltas of samples in packet. It takes the first samples that fit to buffer (size grows with samples).
+	@param	lp_cfg		channels and quantization
+	@param	lp_samp		samples (channels T P H G of tphg_stru, the first nCh are used)
+	@param	lp_n		number of samples, max cd_TLM_MAXSAMP
+	@param	lp_buf		buffer of packet
+	@param	lp_len		size of buffer
+	@param	lp_size		bytes of packet
+	@return	number of packed samples, 0 if key sample does not fit or config is wrong,
+	packet ends before the first sample with value out of range (|v / step| >= 2^24, NaN), 0 if it is the key	*/
+uint8_t gf_tlmPackBits(const tlmCfg_stru &lp_cfg, const tphg_stru *lp_samp, uint8_t lp_n, uint8_t *lp_buf,
+		uint16_t lp_len, uint16_t &lp_size) {
+	float lv_scale[cd_TLM_MAXCH];
+	int32_t lv_q[cd_TLM_MAXCH], lv_prev[cd_TLM_MAXCH];
+	uint8_t lv_key[cd_TLM_MAXCH * 5];
+	lp_size = 0;
+	if (lp_n == 0 || !gf_tlmScale(lp_cfg, lv_scale)) return 0;
+	const uint8_t lv_nCh = lp_cfg.nCh;
+	#define cd_TLM_Q(i, c, q)	gf_tlmQuant((&lp_samp[i].temp1)[c], lv_scale[c], q)	//	channels of tphg_stru are in order
+
+	//	size of header and key sample
+	uint16_t lv_hdr = 2 + lv_nCh, lv_keyLen = 0;
+	for (uint8_t c = 0; c < lv_nCh; c++) {
+		if (!cd_TLM_Q(0, c, lv_prev[c])) return 0;
+		lv_keyLen += gf_putVarint(lv_key + lv_keyLen, gf_zigzag(lv_prev[c], 0));
+	}
+	if (lv_hdr + lv_keyLen + lv_nCh > lp_len) return 0;
+
+	//	pass 1: max widths while packet fits
+	uint8_t lv_width[cd_TLM_MAXCH] = { 0, 0, 0, 0 };
+	uint8_t lv_n = 1;
+	for (; lv_n < lp_n; lv_n++) {
+		uint8_t lv_w[cd_TLM_MAXCH];
+		uint16_t lv_bits = 0;
+		bool lv_ok = true;
+		for (uint8_t c = 0; c < lv_nCh && lv_ok; c++) lv_ok = cd_TLM_Q(lv_n, c, lv_q[c]);
+		if (!lv_ok) break;
+		for (uint8_t c = 0; c < lv_nCh; c++) {
+			uint8_t lv_wd = gf_bitWidth(gf_zigzag(lv_q[c], lv_prev[c]));
+			lv_w[c] = lv_wd > lv_width[c] ? lv_wd : lv_width[c];
+			lv_bits += lv_w[c];
+			lv_prev[c] = lv_q[c];
+		}
+		uint32_t lv_size = lv_hdr + lv_keyLen + lv_nCh + ((uint32_t)lv_bits * lv_n + 7) / 8;
+		if (lv_size > lp_len) break;
+		memcpy(lv_width, lv_w, lv_nCh);
+	}
+
+	//	pass 2: write packet
+	uint16_t lv_pos = gf_tlmHeader(lp_cfg, cd_TLM_BITPACK, lv_n, lp_buf);
+	memcpy(lp_buf + lv_pos, lv_key, lv_keyLen);
+	lv_pos += lv_keyLen;
+	memcpy(lp_buf + lv_pos, lv_width, lv_nCh);
+	lv_pos += lv_nCh;
+	uint8_t *lv_bits = lp_buf + lv_pos;
+	uint32_t lv_bit = 0;
+	for (uint8_t c = 0; c < lv_nCh; c++) cd_TLM_Q(0, c, lv_prev[c]);
+	for (uint8_t i = 1; i < lv_n; i++) {		// values are checked by pass 1
+		for (uint8_t c = 0; c < lv_nCh; c++) {
+			cd_TLM_Q(i, c, lv_q[c]);
+			uint32_t lv_z = gf_zigzag(lv_q[c], lv_prev[c]);
+			lv_prev[c] = lv_q[c];
+			for (uint8_t b = 0; b < lv_width[c]; b++, lv_bit++) {
+				if ((lv_bit & 7) == 0) lv_bits[lv_bit >> 3] = 0;
+				if ((lv_z >> b) & 1) lv_bits[lv_bit >> 3] |= (uint8_t)(1 << (lv_bit & 7));
+			}
+		}
+	}
+	#undef cd_TLM_Q
+	lp_size = lv_pos + (uint16_t)((lv_bit + 7) >> 3);
+	return lv_n;
+}
+
+//============================================
+//	class cl_TlmEncoder
+//============================================
+cl_TlmEncoder::cl_TlmEncoder(const tlmCfg_stru &lp_cfg) {
+	clv_cfg = lp_cfg;
+	if (!gf_tlmScale(clv_cfg, clv_scale)) clv_cfg.nCh = 0;	// begin() returns FALSE
+	clv_buf = NULL;
+	clv_len = 0;
+	clv_pos = 0;
+	clv_n = 0;
+}
+
+/*	@brief	Start new packet in buffer of caller, header is written at once
+	@param	lp_buf	buffer of packet, for ex. payload of radio
+	@param	lp_len	size of buffer
+	@return	FALSE if config is wrong or buffer is too small	*/
+bool cl_TlmEncoder::begin(uint8_t *lp_buf, uint16_t lp_len) {
+	clv_buf = lp_buf;
+	clv_len = lp_len;
+	clv_n = 0;
+	clv_pos = 0;
+	if (clv_cfg.nCh == 0 || lp_len < 2 + clv_cfg.nCh) return false;
+	clv_pos = gf_tlmHeader(clv_cfg, cd_TLM_VARINT, 0, lp_buf);
+	return true;
+}
+
+/*	@brief	Quantize sample and add it to packet: first sample as key, next ones as deltas
+	@param	lp_vals	values of nCh channels (T C, P Pa, H %RH, G kOhm)
+	@return	FALSE if sample does not fit to buffer or packet has cd_TLM_MAXSAMP samples (then send, begin()),
+	or value is out of range |v / step| >= 2^24 or NaN (sample is not added, packet is not changed)	*/
+bool cl_TlmEncoder::add(const float *lp_vals) {
+	if (clv_pos == 0 || clv_n >= cd_TLM_MAXSAMP) return false;
+	uint8_t lv_tmp[cd_TLM_MAXCH * 5];
+	int32_t lv_q[cd_TLM_MAXCH];
+	uint8_t lv_len = 0;
+	for (uint8_t c = 0; c < clv_cfg.nCh; c++) {
+		if (!gf_tlmQuant(lp_vals[c], clv_scale[c], lv_q[c])) return false;
+		lv_len += gf_putVarint(lv_tmp + lv_len, gf_zigzag(lv_q[c], clv_n ? clv_prev[c] : 0));
+	}
+	if (clv_pos + lv_len > clv_len) return false;
+	memcpy(clv_buf + clv_pos, lv_tmp, lv_len);
+	clv_pos += lv_len;
+	memcpy(clv_prev, lv_q, sizeof(int32_t) * clv_cfg.nCh);
+	clv_buf[1] = ++clv_n;
+	return true;
+}
+
+//============================================
+//	class cl_TlmDecoder
+//============================================
+bool cl_TlmDecoder::clf_readVarint(uint32_t &lp_val) {
+	lp_val = 0;
+	for (uint8_t lv_sh = 0; lv_sh < 35; lv_sh += 7) {
+		if (clv_pos >= clv_len) return false;
+		uint8_t lv_b = clv_buf[clv_pos++];
+		lp_val |= (uint32_t)(lv_b & 0x7F) << lv_sh;
+		if (!(lv_b & 0x80)) return true;
+	}
+	return false;		// more than 5 bytes
+}
+
+bool cl_TlmDecoder::clf_readBits(uint8_t lp_width, uint32_t &lp_val) {
+	if (clv_pos + ((clv_bit + lp_width + 7) >> 3) > clv_len) return false;
+	lp_val = 0;
+	const uint8_t *lv_bits = clv_buf + clv_pos;
+	for (uint8_t b = 0; b < lp_width; b++, clv_bit++)
+		lp_val |= (uint32_t)((lv_bits[clv_bit >> 3] >> (clv_bit & 7)) & 1) << b;
+	return true;
+}
+
+/*	@brief	Check header of packet and prepare reading of samples by next()
+	@param	lp_buf	packet
+	@param	lp_len	size of packet
+	@return	FALSE if version, number of channels or size are wrong	*/
+bool cl_TlmDecoder::begin(const uint8_t *lp_buf, uint16_t lp_len) {
+	clv_buf = lp_buf;
+	clv_len = lp_len;
+	clv_n = 0;
+	clv_i = 0;
+	clv_bit = 0;
+	if (lp_len < 3 || (lp_buf[0] >> 4) != cd_TLM_VERSION) return false;
+	clv_mode = (lp_buf[0] >> 3) & 1;
+	clv_nCh = lp_buf[0] & 0x07;
+	if (clv_nCh < 1 || clv_nCh > cd_TLM_MAXCH || lp_len < 2 + clv_nCh) return false;
+	for (uint8_t c = 0; c < clv_nCh; c++) {
+		clv_exp[c] = (int8_t)lp_buf[2 + c];
+		if (clv_exp[c] > cd_TLM_MAXEXP || clv_exp[c] < -cd_TLM_MAXEXP) return false;
+	}
+	clv_pos = 2 + clv_nCh;
+	clv_n = lp_buf[1];
+	return true;
+}
+
+/*	@brief	Next sample of packet as quantized values (lossless)
+	@param	lp_q	nCh values
+	@return	FALSE at end of packet or if packet is broken	*/
+bool cl_TlmDecoder::next(int32_t *lp_q) {
+	if (clv_i >= clv_n) return false;
+	if (clv_i == 0 || clv_mode == cd_TLM_VARINT) {
+		for (uint8_t c = 0; c < clv_nCh; c++) {
+			uint32_t lv_z;
+			if (!clf_readVarint(lv_z)) return false;
+			clv_q[c] = gf_unzigzag(lv_z, clv_i ? clv_q[c] : 0);
+		}
+		if (clv_i == 0 && clv_mode == cd_TLM_BITPACK) {		// widths after key sample
+			if (clv_pos + clv_nCh > clv_len) return false;
+			for (uint8_t c = 0; c < clv_nCh; c++) {
+				clv_width[c] = clv_buf[clv_pos++];
+				if (clv_width[c] > 32) return false;
+			}
+		}
+	}
+	else {
+		for (uint8_t c = 0; c < clv_nCh; c++) {
+			uint32_t lv_z;
+			if (!clf_readBits(clv_width[c], lv_z)) return false;
+			clv_q[c] = gf_unzigzag(lv_z, clv_q[c]);
+		}
+	}
+	memcpy(lp_q, clv_q, sizeof(int32_t) * clv_nCh);
+	clv_i++;
+	return true;
+}
+
+/*	@brief	Next sample of packet, values q * 10^exp
+	@param	lp_v	T C, P Pa, H %RH, G kOhm, not used channels are 0, valid = cd_VAL_T.. of channels of packet
+	@return	FALSE at end of packet or if packet is broken	*/
+bool cl_TlmDecoder::next(tphg_stru &lp_v) {
+	int32_t lv_q[cd_TLM_MAXCH] = { 0, 0, 0, 0 };
+	if (!next(lv_q)) return false;
+	float lv_v[cd_TLM_MAXCH] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (uint8_t c = 0; c < clv_nCh; c++)
+		lv_v[c] = clv_exp[c] < 0 ? (float)lv_q[c] / gf_pow10((uint8_t)-clv_exp[c])
+			: (float)lv_q[c] * gf_pow10((uint8_t)clv_exp[c]);
+	lp_v.temp1 = lv_v[0];
+	lp_v.pres1 = lv_v[1];
+	lp_v.humi1 = lv_v[2];
+	lp_v.gasr1 = lv_v[3];
+	lp_v.valid = (uint8_t)((1 << clv_nCh) - 1);	// cd_VAL_T, cd_VAL_P, cd_VAL_H, cd_VAL_G are bits 0..3
+	return true;
+}
+
+//=================================================================================
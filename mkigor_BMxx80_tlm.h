@@ -0,0 +1,109 @@
+/**
+*	@brief		Compact telemetry packets of T, P, H, G samples (LoRa, NB-IoT): quantization, delta to previous sample,
+*				zigzag varint or bit-packing, to buffer of caller without allocation, and decoder.
+*	@author		Igor Mkprog, mkprogigor@gmail.com
+*	@version	V1.1	@date	10.10.2025
+*
+*	@remarks	Value of channel is quantized to step 10^exp (exp of tlmCfg_stru, for ex. -2 = 0.01 C):
+*	q = round(v / step), |q| < 2^24 is exact in float, decoded value is q * step, error <= step / 2.
+*	Value with |q| >= 2^24 (or NaN) is not encoded: add() returns FALSE, gf_tlmPackBits() ends packet before it.
+*	Usable exp of channel: |v| max / 10^exp < 2^24, for ex. T C >= -5, P Pa >= -2, H %RH >= -5,
+*	G kOhm >= -1 (up to 1.6 GOhm, exp -3 up to 16 MOhm).
+*	Packet is independent of other packets (lost packet does not break next ones), all fields little endian:
+*		byte 0:		version <7:4>, mode <3> (0 = varint, 1 = bit-packing), number of channels <2:0> (1..4);
+*		byte 1:		number of samples (1..255);
+*		nCh bytes:	exp of channels (int8_t);
+*		key sample:	nCh zigzag varints of q;
+*		varint mode:	for each next sample nCh zigzag varints of delta q - q of previous sample;
+*		bit mode:		nCh bytes of bit width of channel (0..32), then for each next sample nCh zigzag deltas
+*						of these widths, bits from bit 0 of byte, the last byte is padded by 0.
+*	zigzag(d) = (d << 1) ^ (d >> 31), varint (LEB128) = 7 bits per byte from low bits, bit <7> = next byte.
+*	Varint mode adds samples one by one (cl_TlmEncoder), bit-packing needs all samples of packet (gf_tlmPackBits()),
+*	it is smaller when deltas of a channel have similar size.
+*/
+
+#ifndef mkigor_BMxx80_tlm_h
+#define mkigor_BMxx80_tlm_h
+
+#include <mkigor_BMxx80.h>
+
+#define cd_TLM_VERSION	1
+#define cd_TLM_VARINT	0		///	mode of packet: zigzag varint deltas
+#define cd_TLM_BITPACK	1		///	mode of packet: bit-packed zigzag deltas
+#define cd_TLM_MAXCH	4		///	channels T, P, H, G
+#define cd_TLM_MAXSAMP	255		///	max samples of packet
+
+struct tlmCfg_stru {		///	channels of packet and quantization step 10^exp of each one
+	uint8_t	nCh;				///	2 (T P), 3 (T P H), 4 (T P H G)
+	int8_t	exp[cd_TLM_MAXCH];	///	for ex. { -2, 0, -2, -1 }: T 0.01 C, P 1 Pa, H 0.01 %RH, G 0.1 kOhm
+};
+
+uint8_t gf_tlmPackBits(const tlmCfg_stru &lp_cfg, const tphg_stru *lp_samp, uint8_t lp_n, uint8_t *lp_buf,
+	uint16_t lp_len, uint16_t &lp_size);	/// bit-packed packet of the first samples that fit, return number of them
+
+//================================================
+//		class cl_TlmEncoder, packet of varint deltas, samples are added one by one
+//================================================
+class cl_TlmEncoder {
+private:
+	uint8_t *clv_buf;
+	uint16_t clv_len;
+	uint16_t clv_pos;			///	size of packet
+	tlmCfg_stru clv_cfg;
+	float clv_scale[cd_TLM_MAXCH];	///	1 / step
+	int32_t clv_prev[cd_TLM_MAXCH];	///	q of previous sample
+	uint8_t clv_n;				///	samples in packet
+
+public:
+	cl_TlmEncoder(const tlmCfg_stru &lp_cfg);
+	bool begin(uint8_t *lp_buf, uint16_t lp_len);	/// new packet in buffer of caller, FALSE if header does not fit
+	bool add(const float *lp_vals);		/// add sample of nCh values, FALSE if packet is full (then send, begin())
+										/// or value is out of range (|v / step| >= 2^24)
+	bool add(const tp_stru &lp_v) { float lv_v[4] = { lp_v.temp1, lp_v.pres1, 0.0f, 0.0f }; return add(lv_v); }
+	bool add(const tph_stru &lp_v) { float lv_v[4] = { lp_v.temp1, lp_v.pres1, lp_v.humi1, 0.0f }; return add(lv_v); }
+	bool add(const tphg_stru &lp_v) {
+		float lv_v[4] = { lp_v.temp1, lp_v.pres1, lp_v.humi1, lp_v.gasr1 };
+		return add(lv_v);
+	}
+	uint16_t size(void) { return clv_pos; }		/// bytes of packet
+	uint8_t count(void) { return clv_n; }		/// samples of packet
+};
+
+//================================================
+//		class cl_TlmDecoder, samples of packet of both modes
+//================================================
+class cl_TlmDecoder {
+private:
+	const uint8_t *clv_buf;
+	uint16_t clv_len;
+	uint16_t clv_pos;			///	next byte (varint) or first byte of bit stream
+	uint32_t clv_bit;			///	next bit of bit stream
+	uint8_t clv_mode;
+	uint8_t clv_nCh;
+	uint8_t clv_n;				///	samples of packet
+	uint8_t clv_i;				///	next sample
+	int8_t clv_exp[cd_TLM_MAXCH];
+	uint8_t clv_width[cd_TLM_MAXCH];	///	bit widths of bit mode
+	int32_t clv_q[cd_TLM_MAXCH];	///	q of last sample
+	bool clf_readVarint(uint32_t &lp_val);
+	bool clf_readBits(uint8_t lp_width, uint32_t &lp_val);
+
+public:
+	cl_TlmDecoder() {
+		clv_buf = NULL;
+		clv_len = 0;
+		clv_n = 0;
+		clv_i = 0;
+		clv_nCh = 0;
+	}
+	bool begin(const uint8_t *lp_buf, uint16_t lp_len);	/// check header of packet, FALSE if it is wrong
+	uint8_t count(void) { return clv_n; }		/// samples of packet
+	uint8_t nCh(void) { return clv_nCh; }
+	uint8_t mode(void) { return clv_mode; }
+	bool next(int32_t *lp_q);		/// next sample as quantized values q of nCh channels, FALSE at end or error
+	bool next(tphg_stru &lp_v);		/// next sample, values q * 10^exp, not used channels are 0
+};
+
+#endif
+
+//=================================================================================